@@ -0,0 +1,77 @@
+#pragma once
+// BlockParams -- Per-block snapshot of every plugin parameter.
+// Parameters are resolved once (by ID) into std::atomic<float> handles when
+// the processor is constructed; processBlock() then copies them into one
+// plain BlockParams struct, so trigger logic, voice setup and effect
+// configuration read ordinary floats instead of doing string-keyed
+// lookups on the audio thread.
+
+#include <atomic>
+
+/// Every parameter, in createParameterLayout() order. The field name is the
+/// parameter ID.
+#define ALGO_NEBULA_PARAMETERS(X)                                              \
+  /* Master, algorithm, clock, scale */                                        \
+  X(masterVolume) X(algorithm) X(bpm) X(clockDiv) X(simSpeed) X(scale) X(key)  \
+  /* Voices, waveshape, ambient, humanization */                               \
+  X(voiceCount) X(waveshape) X(waveshapeSpread) X(droneSustain)                \
+  X(noteProbability) X(gateTime) X(swing) X(strumSpread) X(melodicInertia)     \
+  X(roundRobin) X(velocityHumanize)                                            \
+  /* Envelope, filter, noise + sub, tuning */                                  \
+  X(attack) X(hold) X(decay) X(sustain) X(release) X(filterCutoff)             \
+  X(filterRes) X(filterMode) X(noiseLevel) X(subLevel) X(subOctave) X(tuning)  \
+  X(refPitch)                                                                  \
+  /* Grid, anti-cacophony, stereo */                                           \
+  X(symmetry) X(gridSize) X(freeze) X(consonance) X(maxTriggersPerStep)        \
+  X(restProbability) X(pitchGravity) X(stereoWidth)                            \
+  /* Effects */                                                                \
+  X(chorusRate) X(chorusDepth) X(chorusMix) X(delayTime) X(delayFeedback)      \
+  X(delayMix) X(reverbDecay) X(reverbDamping) X(reverbMix) X(phaserRate)       \
+  X(phaserDepth) X(phaserMix) X(flangerRate) X(flangerDepth) X(flangerMix)     \
+  X(bitcrushBits) X(bitcrushRate) X(bitcrushMix) X(tapeDrive) X(tapeTone)      \
+  X(tapeMix) X(shimmerDecay) X(shimmerAmount) X(shimmerMix) X(pingPongTime)    \
+  X(pingPongFeedback) X(pingPongMix)                                           \
+  /* Effect toggles */                                                         \
+  X(chorusOn) X(delayOn) X(reverbOn) X(phaserOn) X(flangerOn) X(bitcrushOn)    \
+  X(tapeOn) X(shimmerOn) X(pingPongOn)                                         \
+  /* Trigger budget, modulation LFOs, musicality, GPU */                       \
+  X(triggerBudget) X(lfo1Shape) X(lfo1Rate) X(lfo1Amount) X(lfo1Dest)          \
+  X(lfo2Shape) X(lfo2Rate) X(lfo2Amount) X(lfo2Dest) X(maxLeap)                \
+  X(baseOctave) X(octaveRange) X(musicalityBypass) X(gpuAccel)
+
+/// Raw parameter values for one processBlock() call (choice and bool
+/// parameters hold their index / 0-1 as float, like getRawParameterValue).
+struct BlockParams {
+#define ALGO_NEBULA_DECLARE_VALUE(id) float id = 0.0f;
+  ALGO_NEBULA_PARAMETERS(ALGO_NEBULA_DECLARE_VALUE)
+#undef ALGO_NEBULA_DECLARE_VALUE
+};
+
+/// The parameters' value atomics, resolved once by ID.
+struct BlockParamHandles {
+#define ALGO_NEBULA_DECLARE_HANDLE(id) std::atomic<float> *id = nullptr;
+  ALGO_NEBULA_PARAMETERS(ALGO_NEBULA_DECLARE_HANDLE)
+#undef ALGO_NEBULA_DECLARE_HANDLE
+
+  /// Look up every handle: lookup(const char *id) -> std::atomic<float> *
+  /// (e.g. AudioProcessorValueTreeState::getRawParameterValue). Returns
+  /// false if any ID was not found. Call outside the audio thread.
+  template <typename Lookup> bool resolve(Lookup &&lookup) {
+    bool all = true;
+#define ALGO_NEBULA_RESOLVE_HANDLE(id)                                         \
+  id = lookup(#id);                                                            \
+  all = all && id != nullptr;
+    ALGO_NEBULA_PARAMETERS(ALGO_NEBULA_RESOLVE_HANDLE)
+#undef ALGO_NEBULA_RESOLVE_HANDLE
+    return all;
+  }
+
+  /// Snapshot every value (relaxed loads; no lookups, no locks).
+  BlockParams load() const {
+    BlockParams p;
+#define ALGO_NEBULA_LOAD_VALUE(id) p.id = id->load(std::memory_order_relaxed);
+    ALGO_NEBULA_PARAMETERS(ALGO_NEBULA_LOAD_VALUE)
+#undef ALGO_NEBULA_LOAD_VALUE
+    return p;
+  }
+};
@@ -0,0 +1,85 @@
+#include "OfflineRenderer.h"
+#include "PluginProcessor.h"
+#include "engine/FactoryPresets.h"
+#include <algorithm>
+#include <cmath>
+
+juce::Result OfflineRenderer::render(const Settings &settings,
+                                     const juce::File &output,
+                                     std::function<bool(double)> progress) {
+  if (settings.seconds <= 0.0 || settings.sampleRate <= 0.0 ||
+      settings.blockSize < 1 || settings.hostBlockSize < 1)
+    return juce::Result::fail("Invalid duration, sample rate or block size");
+  const int hostBlock = std::min(settings.hostBlockSize, settings.blockSize);
+
+  // Non-realtime before prepareToPlay: no simulation thread, synchronous
+  // stepping, no GPU
+  AlgoNebulaProcessor processor;
+  processor.setNonRealtime(true);
+  processor.setPlayConfigDetails(0, 2, settings.sampleRate, hostBlock);
+  processor.prepareToPlay(settings.sampleRate, hostBlock);
+
+  if (settings.stateFile != juce::File()) {
+    juce::MemoryBlock state;
+    if (!settings.stateFile.loadFileAsData(state))
+      return juce::Result::fail("Cannot read state file " +
+                                settings.stateFile.getFullPathName());
+    processor.setStateInformation(state.getData(),
+                                  static_cast<int>(state.getSize()));
+  }
+
+  if (settings.factoryPreset >= 0) {
+    const auto presets = getFactoryPresets();
+    if (settings.factoryPreset >= static_cast<int>(presets.size()))
+      return juce::Result::fail("No factory preset " +
+                                juce::String(settings.factoryPreset));
+    presets[static_cast<size_t>(settings.factoryPreset)].apply(
+        processor.getAPVTS());
+  }
+
+  // Applied by the first processBlock()
+  if (settings.seed)
+    processor.setSeed(*settings.seed);
+
+  output.deleteFile();
+  std::unique_ptr<juce::FileOutputStream> stream(output.createOutputStream());
+  if (stream == nullptr)
+    return juce::Result::fail("Cannot write " + output.getFullPathName());
+
+  juce::WavAudioFormat wav;
+  std::unique_ptr<juce::AudioFormatWriter> writer(
+      wav.createWriterFor(stream.get(), settings.sampleRate, 2,
+                          settings.bitsPerSample, {}, 0));
+  if (writer == nullptr)
+    return juce::Result::fail("Unsupported WAV format (" +
+                              juce::String(settings.bitsPerSample) + " bit)");
+  stream.release(); // owned by the writer now
+
+  juce::AudioBuffer<float> buffer(2, settings.blockSize);
+  juce::MidiBuffer midi;
+  const auto total = static_cast<juce::int64>(
+      std::llround(settings.seconds * settings.sampleRate));
+  for (juce::int64 done = 0; done < total;) {
+    // Host-sized calls: a block that spans several clock ticks would merge
+    // their steps into one grid scan
+    for (int offset = 0; offset < settings.blockSize; offset += hostBlock) {
+      juce::AudioBuffer<float> hostBuffer(
+          buffer.getArrayOfWritePointers(), 2, offset,
+          std::min(hostBlock, settings.blockSize - offset));
+      processor.processBlock(hostBuffer, midi);
+      midi.clear();
+    }
+
+    const int n = static_cast<int>(
+        std::min<juce::int64>(settings.blockSize, total - done));
+    if (!writer->writeFromAudioSampleBuffer(buffer, 0, n))
+      return juce::Result::fail("Write failed: " + output.getFullPathName());
+    done += n;
+
+    if (progress && !progress(static_cast<double>(done) / total))
+      return juce::Result::fail("Cancelled");
+  }
+
+  processor.releaseResources();
+  return juce::Result::ok();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <optional>
+
+//==============================================================================
+/// Faster-than-real-time bounce of a generative session to a WAV file.
+///
+/// Runs an AlgoNebulaProcessor in non-realtime mode: there is no simulation
+/// thread and no message-thread work, engine steps run synchronously inside
+/// processBlock(), so the output depends only on the settings below and two
+/// renders with the same settings are sample-identical. The processor is
+/// called in host-sized blocks (hostBlockSize) so clock ticks are stepped
+/// and scanned one at a time as in a live session; speed comes from the
+/// processor's worker pools: engine row bands and (for host blocks of
+/// 1024+ samples) the effect sends run across cores.
+///
+/// Safe to run several renders concurrently, one per thread.
+class OfflineRenderer {
+public:
+  struct Settings {
+    /// Grid seed (reseeds at the start). Unset: keep the preset's grid.
+    std::optional<uint64_t> seed = 12345;
+    /// Factory preset index (getFactoryPresets()), -1 for none.
+    int factoryPreset = -1;
+    /// Saved plugin state (getStateInformation() bytes) applied first.
+    juce::File stateFile;
+    double seconds = 60.0;
+    double sampleRate = 48000.0;
+    int blockSize = 4096;     ///< samples per write / progress callback
+    int hostBlockSize = 512;  ///< samples per processBlock() call
+    int bitsPerSample = 24;
+  };
+
+  /// Render to `output` (overwritten). `progress` is called after each block
+  /// with the fraction done; return false to cancel.
+  static juce::Result render(const Settings &settings, const juce::File &output,
+                             std::function<bool(double)> progress = {});
+};
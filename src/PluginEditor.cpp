@@ -891,6 +891,24 @@ void AlgoNebulaEditor::timerCallback() {
   else
     cpuMeterLabel.setColour(juce::Label::textColourId, NebulaColours::text_dim);
 
+#if ALGO_PROFILING
+  // Per-stage breakdown (p50 / p99 / max µs over the last ~1000 samples)
+  {
+    const StageStatistics &stages = processor.collectStageTimings();
+    juce::String tip("Stage: p50 / p99 / max (us)");
+    for (int i = 0; i < kNumProfileStages; ++i) {
+      const auto stage = static_cast<ProfileStage>(i);
+      const auto s = stages.get(stage);
+      if (s.count == 0)
+        continue;
+      tip << "\n" << getProfileStageName(stage) << ": "
+          << juce::String(s.p50Us, 1) << " / " << juce::String(s.p99Us, 1)
+          << " / " << juce::String(s.maxUs, 1);
+    }
+    cpuMeterLabel.setTooltip(tip);
+  }
+#endif
+
   // Update seed display (only when user is not typing)
   if (!seedInput.hasKeyboardFocus(false)) {
     auto seedHex = juce::String::toHexString(
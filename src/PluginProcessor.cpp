@@ -7,7 +7,22 @@ AlgoNebulaProcessor::AlgoNebulaProcessor()
     : AudioProcessor(BusesProperties().withOutput(
           "Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "AlgoNebulaState", createParameterLayout()),
-      engine(createEngine(0)) {}
+      engine(createEngine(0)) {
+  const bool resolved = paramHandles_.resolve(
+      [this](const char *id) { return apvts.getRawParameterValue(id); });
+  jassert(resolved); // every BlockParams field must name a parameter
+  juce::ignoreUnused(resolved);
+  keyParam_ = apvts.getParameter("key");
+  jassert(keyParam_ != nullptr);
+  engine->setWorkerPool(&workerPool_);
+  simThread_.setStateSnapshotter(&stateSnapshotter_);
+  // Saves before prepareToPlay() get the initial state from this capture
+  stateSnapshotter_.reset(*engine);
+  // Snapshots are resized by convertToGrid() on the audio thread; reserve
+  // the largest size up front so that never allocates.
+  for (auto &snapshot : gridSnapshots_)
+    snapshot.reserve(Grid::kMaxRows, Grid::kMaxCols);
+}
 
 std::unique_ptr<CellularEngine>
 AlgoNebulaProcessor::createEngine(int algoIdx, int rows, int cols) {
@@ -32,13 +47,19 @@ AlgoNebulaProcessor::createEngine(int algoIdx, int rows, int cols) {
     return std::make_unique<BrownianField>(rows, cols);
   case 8:
     return std::make_unique<Lenia3DStub>(rows, cols);
+  case 9:
+    return std::make_unique<HashLife>(rows, cols,
+                                      GameOfLife::RulePreset::Classic);
   default:
     return std::make_unique<GameOfLife>(rows, cols,
                                         GameOfLife::RulePreset::Classic);
   }
 }
 
-AlgoNebulaProcessor::~AlgoNebulaProcessor() = default;
+AlgoNebulaProcessor::~AlgoNebulaProcessor() {
+  // Join before the bridge (gpuCompute) and engine are destroyed
+  simThread_.stop();
+}
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -55,7 +76,8 @@ AlgoNebulaProcessor::createParameterLayout() {
       juce::ParameterID("algorithm", 1), "Algorithm",
       juce::StringArray{"Game of Life", "HighLife", "Brian's Brain",
                         "Cyclic CA", "Reaction-Diffusion", "Particle Swarm",
-                        "Lenia", "Brownian Field", "Lenia 3D"},
+                        "Lenia", "Brownian Field", "Lenia 3D",
+                        "HashLife"},
       0));
 
   // --- Clock ---
@@ -412,22 +434,20 @@ void AlgoNebulaProcessor::prepareToPlay(double sampleRate,
 
   // Initialize smoothed parameters (20ms ramp time prevents zipper noise)
   masterVolume.reset(sampleRate, 0.02);
-  masterVolume.setCurrentAndTargetValue(
-      apvts.getRawParameterValue("masterVolume")->load());
+  masterVolume.setCurrentAndTargetValue(paramHandles_.masterVolume->load());
   smoothFilterCutoff.reset(sampleRate, 0.02);
   smoothFilterCutoff.setCurrentAndTargetValue(
-      apvts.getRawParameterValue("filterCutoff")->load());
+      paramHandles_.filterCutoff->load());
   smoothFilterRes.reset(sampleRate, 0.02);
-  smoothFilterRes.setCurrentAndTargetValue(
-      apvts.getRawParameterValue("filterRes")->load());
+  smoothFilterRes.setCurrentAndTargetValue(paramHandles_.filterRes->load());
   smoothNoiseLevel.reset(sampleRate, 0.02);
-  smoothNoiseLevel.setCurrentAndTargetValue(
-      apvts.getRawParameterValue("noiseLevel")->load());
+  smoothNoiseLevel.setCurrentAndTargetValue(paramHandles_.noiseLevel->load());
   smoothSubLevel.reset(sampleRate, 0.02);
-  smoothSubLevel.setCurrentAndTargetValue(
-      apvts.getRawParameterValue("subLevel")->load());
+  smoothSubLevel.setCurrentAndTargetValue(paramHandles_.subLevel->load());
   smoothDensityGain.reset(sampleRate, 0.05); // slower ramp for density
   smoothDensityGain.setCurrentAndTargetValue(1.0f);
+  smoothVoiceNorm.reset(sampleRate, 0.02);
+  smoothVoiceNorm.setCurrentAndTargetValue(1.0f);
 
   // Initialize DSP effects
   float sr = static_cast<float>(sampleRate);
@@ -456,6 +476,11 @@ void AlgoNebulaProcessor::prepareToPlay(double sampleRate,
   effectChain.setSlot(7, &bitcrush);
   effectChain.setSlot(8, &tapeSat);
   effectChain.init(sr);
+  // Sends of large blocks (offline renders, big host buffers) run on the
+  // effect workers; smaller blocks stay on the audio thread
+  effectChain.prepare(samplesPerBlock);
+  effectChain.setWorkerPool(&effectWorkers_);
+  effectChain.setParallelThreshold(EffectChain::kDefaultParallelThreshold);
 
   // Initialize safety limiter (brick-wall, before SafetyProcessor)
   {
@@ -468,7 +493,8 @@ void AlgoNebulaProcessor::prepareToPlay(double sampleRate,
     safetyLimiter.setRelease(5.0f);    // 5ms release
   }
 
-  // Initialize engine with default seed
+  // Initialize engine with default seed (simulation thread must be idle)
+  simThread_.stop();
   engine->randomize(42, 0.3f);
   gpuCompute.getBridge().updateFromCpu(engine->getGrid());
   {
@@ -478,10 +504,12 @@ void AlgoNebulaProcessor::prepareToPlay(double sampleRate,
   }
   engineGeneration.store(0, std::memory_order_relaxed);
 
-  // Initialize CPU step timer (runs engine->step() on message thread)
-  cpuStepTimer_.setTargets(engine.get(), &gpuCompute.getBridge(), &cellEditQueue);
-  // Timer must be started from message thread (prepareToPlay is audio thread)
-  juce::MessageManager::callAsync([this]() { cpuStepTimer_.start(); });
+  // Start the CPU simulation thread (runs engine->step() off the audio and
+  // message threads). Offline renders step synchronously in processBlock()
+  // instead, so a bounce only depends on its seed and parameters.
+  syncStepping_ = isNonRealtime();
+  simThread_.setTargets(engine.get(), &gpuCompute.getBridge(), &cellEditQueue);
+  startSimulation();
 
   // Initialize clock
   clock.reset(sampleRate);
@@ -494,6 +522,21 @@ void AlgoNebulaProcessor::prepareToPlay(double sampleRate,
   // Initialize voices
   for (int i = 0; i < kMaxVoices; ++i)
     voices[i].reset();
+  activeVoices_.clear();
+}
+
+void AlgoNebulaProcessor::setNonRealtime(bool isNonRealtime) noexcept {
+  AudioProcessor::setNonRealtime(isNonRealtime);
+  // Hosts may flip this between blocks. The callback lock keeps
+  // processBlock() out while the simulation thread is joined or started;
+  // requests it had not run yet are picked up by runPending().
+  const juce::ScopedLock lock(getCallbackLock());
+  if (isNonRealtime == syncStepping_.load())
+    return;
+  simThread_.stop();
+  syncStepping_ = isNonRealtime;
+  if (!isNonRealtime)
+    simThread_.start(); // no-op before prepareToPlay() sets the targets
 }
 
 void AlgoNebulaProcessor::releaseResources() {
@@ -503,10 +546,11 @@ void AlgoNebulaProcessor::releaseResources() {
 void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                        juce::MidiBuffer &midiMessages) {
   auto startTime = juce::Time::getHighResolutionTicks();
+  ALGO_PROFILE_START(stageWatch_);
 
   juce::ScopedNoDenormals noDenormals;
 
-  // Cell edits drained by CpuStepTimer on message thread
+  // Cell edits drained by SimulationThread before each step batch
 
   // Process virtual MIDI keyboard input
   keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(),
@@ -519,9 +563,9 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     if (msg.isNoteOn()) {
       // Key tracking: set root key from MIDI note
       int noteKey = msg.getNoteNumber() % 12;
-      if (auto *keyParam = apvts.getParameter("key")) {
-        keyParam->setValueNotifyingHost(
-            keyParam->convertTo0to1(static_cast<float>(noteKey)));
+      if (keyParam_ != nullptr) {
+        keyParam_->setValueNotifyingHost(
+            keyParam_->convertTo0to1(static_cast<float>(noteKey)));
       }
 
       // Store velocity for voice triggering
@@ -529,47 +573,42 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     }
   }
 
+  // One snapshot of every parameter for this block (after the key
+  // tracking above, which may change "key")
+  const BlockParams params = paramHandles_.load();
+
   // Read smoothed parameters
-  masterVolume.setTargetValue(
-      apvts.getRawParameterValue("masterVolume")->load());
-  smoothFilterCutoff.setTargetValue(
-      apvts.getRawParameterValue("filterCutoff")->load());
-  smoothFilterRes.setTargetValue(
-      apvts.getRawParameterValue("filterRes")->load());
-  smoothNoiseLevel.setTargetValue(
-      apvts.getRawParameterValue("noiseLevel")->load());
-  smoothSubLevel.setTargetValue(apvts.getRawParameterValue("subLevel")->load());
+  masterVolume.setTargetValue(params.masterVolume);
+  smoothFilterCutoff.setTargetValue(params.filterCutoff);
+  smoothFilterRes.setTargetValue(params.filterRes);
+  smoothNoiseLevel.setTargetValue(params.noiseLevel);
+  smoothSubLevel.setTargetValue(params.subLevel);
 
   const int numSamples = buffer.getNumSamples();
 
   // --- Read clock params and update clock ---
-  float bpm = apvts.getRawParameterValue("bpm")->load();
-  int clockDivIdx =
-      static_cast<int>(apvts.getRawParameterValue("clockDiv")->load());
-  float swing = apvts.getRawParameterValue("swing")->load();
+  float bpm = params.bpm;
+  int clockDivIdx = static_cast<int>(params.clockDiv);
+  float swing = params.swing;
   clock.setBPM(static_cast<double>(bpm));
   clock.setDivision(static_cast<ClockDivider::Division>(clockDivIdx));
   clock.setSwing(static_cast<double>(swing));
 
   // --- Read algorithm and grid size params, switch engine type ---
-  int algoIdx =
-      static_cast<int>(apvts.getRawParameterValue("algorithm")->load());
-  int gridSizeIdx =
-      static_cast<int>(apvts.getRawParameterValue("gridSize")->load());
-
-  // Grid size lookup: rows, cols
-  static constexpr int kGridSizes[][2] = {
-      {8, 12},  {12, 16},   {16, 24},   {24, 32},   {32, 48},     {48, 64},
-      {64, 96}, {128, 128}, {256, 256}, {512, 512}, {1024, 1024}, {1280, 1280}};
+  int algoIdx = static_cast<int>(params.algorithm);
+  int gridSizeIdx = static_cast<int>(params.gridSize);
+
+  // Grid size lookup: rows, cols (see engine/GridSizes.h)
   int gridRows = kGridSizes[gridSizeIdx][0];
   int gridCols = kGridSizes[gridSizeIdx][1];
 
-  // --- Read GPU acceleration toggle ---
-  bool wantGpu = apvts.getRawParameterValue("gpuAccel")->load() > 0.5f;
+  // --- Read GPU acceleration toggle (GPU steps on a timer: never offline) ---
+  bool wantGpu = params.gpuAccel > 0.5f && !syncStepping_;
 
   if (algoIdx != lastAlgorithmIdx || gridSizeIdx != lastGridSizeIdx) {
     lastAlgorithmIdx = algoIdx;
     lastGridSizeIdx = gridSizeIdx;
+    gpuUnavailable.store(false, std::memory_order_relaxed); // retry once
     // Release all voices when switching engine
     for (int v = 0; v < kMaxVoices; ++v)
       voices[v].reset();
@@ -584,35 +623,43 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       juce::MessageManager::callAsync([mgr]() { mgr->stop(); });
     }
 
-    // Defer engine recreation to message thread (timer uses engine pointer)
-    // NOTE: stop() must also be on message thread -- Timer is not thread-safe
+    // Defer engine recreation to message thread: stop() joins the simulation
+    // thread, which must never happen on the audio thread. Offline (no
+    // simulation thread, no real-time constraint) it happens right here.
     int capturedAlgo = algoIdx;
     int capturedRows = gridRows;
     int capturedCols = gridCols;
     uint64_t capturedSeed = reseedRng;
-    juce::MessageManager::callAsync([this, capturedAlgo, capturedRows, capturedCols, capturedSeed, wasGpu]() {
-      cpuStepTimer_.stop();
-      engine = createEngine(capturedAlgo, capturedRows, capturedCols);
-      engine->randomize(capturedSeed, 0.3f);
-      gpuCompute.getBridge().updateFromCpu(engine->getGrid());
-      cpuStepTimer_.setTargets(engine.get(), &gpuCompute.getBridge(), &cellEditQueue);
-      cpuStepTimer_.start();
-
-      // If GPU was active before algo change, restart it with the NEW engine
-      if (wasGpu) {
-        auto eType = engine->getType();
-        if (gpuCompute.setEngine(eType, engine->getGrid().getRows(),
-                                 engine->getGrid().getCols())) {
-          gpuCompute.seed(capturedSeed, 0.3f);
-          if (gpuCompute.start()) {
-            gpuActive.store(true, std::memory_order_relaxed);
+    if (syncStepping_) {
+      rebuildEngine(capturedAlgo, capturedRows, capturedCols, capturedSeed);
+    } else {
+      juce::MessageManager::callAsync([this, capturedAlgo, capturedRows,
+                                       capturedCols, capturedSeed, wasGpu]() {
+        rebuildEngine(capturedAlgo, capturedRows, capturedCols, capturedSeed);
+
+        // If GPU was active before algo change, restart it with the NEW
+        // engine
+        if (wasGpu) {
+          auto eType = engine->getType();
+          if (gpuCompute.setEngine(eType, engine->getGrid().getRows(),
+                                   engine->getGrid().getCols())) {
+            gpuCompute.seed(capturedSeed, 0.3f);
+            if (gpuCompute.start()) {
+              gpuActive.store(true, std::memory_order_relaxed);
+            }
           }
+          if (!gpuActive.load(std::memory_order_relaxed))
+            gpuUnavailable.store(true, std::memory_order_relaxed);
+          gpuPending.store(false, std::memory_order_relaxed);
         }
-        gpuPending.store(false, std::memory_order_relaxed);
-      }
-    });
+      });
+    }
   }
   // Toggle GPU on/off ÃƒÆ’Ã‚Â¢ÃƒÂ¢Ã¢â‚¬Å¡Ã‚Â¬ÃƒÂ¢Ã¢â€šÂ¬Ã‚Â defer to message thread for timer/device safety
+  // Engines without a GPU adapter (HashLife), or a failed setup, stay on
+  // the CPU instead of posting a new attempt every block
+  wantGpu = wantGpu && GpuComputeManager::hasAdapter(engine->getType()) &&
+            !gpuUnavailable.load(std::memory_order_relaxed);
   if (wantGpu && !gpuActive.load(std::memory_order_relaxed) && !gpuPending.load(std::memory_order_relaxed)) {
     auto eType = engine->getType();
     int gRows = gridRows;
@@ -621,14 +668,17 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     auto *flag = &gpuActive;
     gpuPending.store(true, std::memory_order_relaxed);
     auto *pending = &gpuPending;
+    auto *failed = &gpuUnavailable;
     uint64_t seedVal = reseedRng;
-    juce::MessageManager::callAsync([mgr, flag, pending, eType, gRows, gCols, seedVal]() {
+    juce::MessageManager::callAsync([mgr, flag, pending, failed, eType, gRows, gCols, seedVal]() {
       if (mgr->setEngine(eType, gRows, gCols)) {
         mgr->seed(seedVal, 0.3f);
         if (mgr->start()) {
           flag->store(true, std::memory_order_relaxed);
         }
       }
+      if (!flag->load(std::memory_order_relaxed))
+        failed->store(true, std::memory_order_relaxed);
       pending->store(false, std::memory_order_relaxed);
     });
     reseedCooldown = 120; // let GPU warm up before checking stagnation
@@ -656,7 +706,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         mgr->seed(reseedRng, 0.3f);
       });
     } else {
-      cpuStepTimer_.requestReseed(reseedRng, 0.3f, false);
+      simThread_.requestReseed(reseedRng, 0.3f, false);
     }
     stagnationCounter = 0;
     lastAliveCount = 0;
@@ -671,7 +721,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       auto *mgr = &gpuCompute;
       juce::MessageManager::callAsync([mgr]() { mgr->clearState(); });
     } else {
-      cpuStepTimer_.requestClear();
+      simThread_.requestClear();
     }
     // Kill all voices immediately on clear
     for (int i = 0; i < kMaxVoices; ++i)
@@ -692,7 +742,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         mgr->seed(reseedRng, 0.3f);
       });
     } else {
-      cpuStepTimer_.requestReseed(reseedRng, 0.3f, true);
+      simThread_.requestReseed(reseedRng, 0.3f, true);
     }
     stagnationCounter = 0;
     lastAliveCount = 0;
@@ -702,24 +752,28 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
   }
 
   // --- Read symmetry mode ---
-  int symmetryIdx =
-      static_cast<int>(apvts.getRawParameterValue("symmetry")->load());
+  int symmetryIdx = static_cast<int>(params.symmetry);
   bool useSymmetry = (symmetryIdx == 1);
 
   // Load factory pattern request
   int patternIdx = loadPatternRequested.exchange(-1, std::memory_order_relaxed);
   if (patternIdx >= 0) {
-    // Defer pattern load to message thread (engine safety)
-    juce::MessageManager::callAsync([this, patternIdx]() {
+    // Defer pattern load to message thread (engine safety); offline the
+    // engine is only touched from here
+    if (syncStepping_) {
       FactoryPatternLibrary::applyPattern(engine->getGridMutable(), patternIdx);
-    });
+    } else {
+      juce::MessageManager::callAsync([this, patternIdx]() {
+        FactoryPatternLibrary::applyPattern(engine->getGridMutable(),
+                                            patternIdx);
+      });
+    }
     stagnationCounter = 0;
     lastAliveCount = 0;
   }
 
   // --- Read freeze mode ---
-  bool isFrozen =
-      static_cast<int>(apvts.getRawParameterValue("freeze")->load()) == 1;
+  bool isFrozen = static_cast<int>(params.freeze) == 1;
 
   // Clock-driven engine stepping (only when running and not frozen)
   stepTriggeredThisBlock = false;
@@ -732,8 +786,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
   // Read sim speed multiplier
   static constexpr int kSimSpeeds[] = {1, 2, 4, 8, 16};
-  int simSpeedIdx =
-      static_cast<int>(apvts.getRawParameterValue("simSpeed")->load());
+  int simSpeedIdx = static_cast<int>(params.simSpeed);
   int simSpeed = kSimSpeeds[std::clamp(simSpeedIdx, 0, 4)];
 
   // GPU path: simulation runs on GPU timer thread; CPU path: step on clock tick
@@ -747,11 +800,14 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
         stepTriggeredThisBlock = true;
     }
   } else {
-    // CPU path: request N steps per clock tick via message-thread timer
+    // CPU path: request N steps per clock tick on the simulation thread.
+    // Engines that jump ahead themselves take N generations in one step.
+    const int stepsPerTick =
+        engine->setGenerationsPerStep(simSpeed) ? 1 : simSpeed;
     for (int i = 0; i < numSamples; ++i) {
       if (clock.tick() && isRunning && !isFrozen) {
-        for (int s = 0; s < simSpeed; ++s)
-          cpuStepTimer_.requestStep();
+        for (int s = 0; s < stepsPerTick; ++s)
+          simThread_.requestStep();
         stepTriggeredThisBlock = true;
       }
     }
@@ -779,7 +835,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
           mgr->seed(reseedRng, 0.3f);
         });
       } else {
-        cpuStepTimer_.requestReseed(reseedRng, 0.3f, useSymmetry);
+        simThread_.requestReseed(reseedRng, 0.3f, useSymmetry);
       }
       reseedCooldown = isGpu ? 120 : 0; // GPU needs time for readback
       stagnationCounter = 0;
@@ -798,7 +854,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
           mgr->seed(reseedRng, 0.15f);
         });
       } else {
-        cpuStepTimer_.requestOverpopReseed(reseedRng, 0.15f, useSymmetry);
+        simThread_.requestOverpopReseed(reseedRng, 0.15f, useSymmetry);
       }
       overpopCounter = 0;
       stagnationCounter = 0;
@@ -807,30 +863,34 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     }
   }
 
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::ParamRead);
+
+  // Offline: run this block's steps and reseeds now, before the grid scan
+  // (timed as EngineStep, not as an audio stage)
+  if (syncStepping_) {
+    simThread_.runPending();
+    ALGO_PROFILE_START(stageWatch_);
+  }
+
   // On step: scan grid for active cells, map to notes, trigger voices
   if (stepTriggeredThisBlock) {
     // Read params
-    auto waveshapeIdx =
-        static_cast<int>(apvts.getRawParameterValue("waveshape")->load());
-    auto scaleIdx =
-        static_cast<int>(apvts.getRawParameterValue("scale")->load());
-    auto keyIdx = static_cast<int>(apvts.getRawParameterValue("key")->load());
-    float attack = apvts.getRawParameterValue("attack")->load();
-    float hold = apvts.getRawParameterValue("hold")->load();
-    float decay = apvts.getRawParameterValue("decay")->load();
-    float sustain = apvts.getRawParameterValue("sustain")->load();
-    float release = apvts.getRawParameterValue("release")->load();
+    auto waveshapeIdx = static_cast<int>(params.waveshape);
+    auto scaleIdx = static_cast<int>(params.scale);
+    auto keyIdx = static_cast<int>(params.key);
+    float attack = params.attack;
+    float hold = params.hold;
+    float decay = params.decay;
+    float sustain = params.sustain;
+    float release = params.release;
     float filterCutoff = smoothFilterCutoff.getCurrentValue();
     float filterRes = smoothFilterRes.getCurrentValue();
-    int filterModeIdx =
-        static_cast<int>(apvts.getRawParameterValue("filterMode")->load());
+    int filterModeIdx = static_cast<int>(params.filterMode);
     float noiseLevel = smoothNoiseLevel.getCurrentValue();
     float subLevel = smoothSubLevel.getCurrentValue();
-    int subOctIdx =
-        static_cast<int>(apvts.getRawParameterValue("subOctave")->load());
-    int maxVoices =
-        static_cast<int>(apvts.getRawParameterValue("voiceCount")->load());
-    float waveSpread = apvts.getRawParameterValue("waveshapeSpread")->load();
+    int subOctIdx = static_cast<int>(params.subOctave);
+    int maxVoices = static_cast<int>(params.voiceCount);
+    float waveSpread = params.waveshapeSpread;
     // Shapes available for cycling (exclude Bell FM = index 7)
     constexpr int kCycleShapeCount = 7;
 
@@ -839,31 +899,26 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     // --- Fetch locked grid buffers for this step ---
     const float *curData = nullptr;
     const float *prevData = nullptr;
-    bool bridgeHasData = bridge.readLock(curData, prevData);
+    const CellEvent *events = nullptr; // changes since prevData (or null)
+    int numEvents = 0;
+    bool bridgeHasData = bridge.readLock(curData, prevData, events, numEvents);
     if (!bridgeHasData)
-      bridge.readUnlock();
+      bridge.readUnlock(curData);
     
     if (bridgeHasData) {
     int bRows = bridge.getRows();
     int bCols = bridge.getCols();
     uint64_t bGen = bridge.getGeneration();
     
-    // Subsample large grids for performance
-    // Max cells scanned = 128 * 128 = 16,384. Wait, max grid dimension is rows or cols.
-    // If we have 1280x1280, skip = 10, scanning every 10th row/col -> 128x128.
-    int skip = std::max(1, std::max(bRows, bCols) / 128);
+    // Subsample large grids: only every skip-th row/col can trigger, so
+    // 1280x1280 (skip = 10) maps onto a 128x128 lattice.
+    int skip = GpuGridBridge::latticeSkip(bRows, bCols);
 
     // --- Density-driven dynamics ---
-    // Recalculate density manually using the locked subsampled grid
-    int countAliveBlocked = 0;
-    int cellsChecked = 0;
-    for (int r = 0; r < bRows; r += skip) {
-      for (int c = 0; c < bCols; c += skip) {
-        if (GpuGridBridge::isAliveLocked(curData, bRows, bCols, r, c))
-          ++countAliveBlocked;
-        ++cellsChecked;
-      }
-    }
+    // Density and stagnation are measured on the trigger lattice, as the
+    // sampled scan did; the bridge counts it at publish time (O(1) here)
+    int countAliveBlocked = bridge.countAliveSampled();
+    int cellsChecked = bridge.getLatticeCells();
     
     // Auto-reseed check logic — only track stagnation when there are alive cells.
     // At GPU warmup or when simulation is truly dead, alive=0 triggers a reseed
@@ -898,57 +953,48 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     float modFilterCutoff = filterCutoff * densityCutoffMod;
     
     // Release voices for cells that just died (no longer retrigger everything)
-    for (int v = 0; v < kMaxVoices; ++v) {
-      if (voices[v].isActive()) {
-        int vRow = voices[v].getGridRow();
-        int vCol = voices[v].getGridCol();
-        if (vRow >= 0 && vCol >= 0) {
-          // Cell died or out of grid bounds: release
-          if (!GpuGridBridge::isAliveLocked(curData, bRows, bCols, vRow, vCol)) {
-            voices[v].noteOff();
-          }
+    activeVoices_.retire();
+    for (int i = 0; i < activeVoices_.size(); ++i) {
+      SynthVoice &voice = *activeVoices_[i];
+      int vRow = voice.getGridRow();
+      int vCol = voice.getGridCol();
+      if (vRow >= 0 && vCol >= 0) {
+        // Cell died or out of grid bounds: release
+        if (!GpuGridBridge::isAliveLocked(curData, bRows, bCols, vRow, vCol)) {
+          voice.noteOff();
         }
       }
     }
 
     // Trigger new voices only for newly born cells
-    int voicesUsed = 0;
-    for (int v = 0; v < kMaxVoices; ++v) {
-      if (voices[v].isActive())
-        ++voicesUsed;
-    }
+    int voicesUsed = activeVoices_.size();
 
     // Read musicality params
-    float noteProb = apvts.getRawParameterValue("noteProbability")->load();
-    float velHumanize = apvts.getRawParameterValue("velocityHumanize")->load();
-    float melInertia = apvts.getRawParameterValue("melodicInertia")->load();
-    float gateTimeFrac = apvts.getRawParameterValue("gateTime")->load();
-    float strumSpread = apvts.getRawParameterValue("strumSpread")->load();
-    float roundRobin = apvts.getRawParameterValue("roundRobin")->load();
+    float noteProb = params.noteProbability;
+    float velHumanize = params.velocityHumanize;
+    float melInertia = params.melodicInertia;
+    float gateTimeFrac = params.gateTime;
+    float strumSpread = params.strumSpread;
+    float roundRobin = params.roundRobin;
 
     // Anti-cacophony params
-    float consonance = apvts.getRawParameterValue("consonance")->load();
-    int maxTrigsParam = static_cast<int>(
-        apvts.getRawParameterValue("maxTriggersPerStep")->load());
-    int triggerBudgetKnob =
-        static_cast<int>(apvts.getRawParameterValue("triggerBudget")->load());
+    float consonance = params.consonance;
+    int maxTrigsParam = static_cast<int>(params.maxTriggersPerStep);
+    int triggerBudgetKnob = static_cast<int>(params.triggerBudget);
     // Trigger budget: knob override > 0 takes precedence, else engine default
     int maxTrigsPerStep =
         (triggerBudgetKnob > 0)
             ? triggerBudgetKnob
             : std::min(maxTrigsParam, engine->getDefaultTriggerBudget());
-    float restProb = apvts.getRawParameterValue("restProbability")->load();
+    float restProb = params.restProbability;
     float engineGainScale = engine->getGainScale();
-    float pitchGravity = apvts.getRawParameterValue("pitchGravity")->load();
+    float pitchGravity = params.pitchGravity;
 
     // Musicality hard rules params
-    int maxLeap = static_cast<int>(
-        apvts.getRawParameterValue("maxLeap")->load());
-    int baseOctave = static_cast<int>(
-        apvts.getRawParameterValue("baseOctave")->load());
-    int octaveRange = static_cast<int>(
-        apvts.getRawParameterValue("octaveRange")->load());
-    bool musicalityBypassed = apvts.getRawParameterValue("musicalityBypass")->load() > 0.5f;
+    int maxLeap = static_cast<int>(params.maxLeap);
+    int baseOctave = static_cast<int>(params.baseOctave);
+    int octaveRange = static_cast<int>(params.octaveRange);
+    bool musicalityBypassed = params.musicalityBypass > 0.5f;
 
     // Calculate step interval in samples for gate time
     double stepIntervalSec = clock.getStepIntervalSeconds();
@@ -961,8 +1007,10 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       musicRng ^= musicRng >> 7;
       musicRng ^= musicRng << 17;
       float restRoll = static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-      if (restRoll < restProb)
-        goto skipTriggers; // Full rest for this step
+      if (restRoll < restProb) {
+        bridge.readUnlock(curData); // the writer waits on held frames
+        goto skipTriggers;          // Full rest for this step
+      }
     }
 
     // --- Density-adaptive voice count ---
@@ -979,311 +1027,315 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       // Collect currently-active MIDI notes for consonance checking
       int activeNotes[kMaxVoices];
       int activeNoteCount = 0;
-      for (int v = 0; v < kMaxVoices; ++v) {
-        if (voices[v].isActive() && voices[v].getCurrentNote() > 0) {
-          activeNotes[activeNoteCount++] = voices[v].getCurrentNote();
-        }
+      for (int i = 0; i < activeVoices_.size(); ++i) {
+        const SynthVoice &voice = *activeVoices_[i];
+        if (voice.isActive() && voice.getCurrentNote() > 0)
+          activeNotes[activeNoteCount++] = voice.getCurrentNote();
       }
 
       int triggersThisStep = 0;
 
-      for (int col = 0;
-           col < bCols && voicesUsed < effectiveMaxVoices &&
+      // Newly born cells (first per subsampled column, in column order),
+      // found from the frame's events: work scales with activity
+      const int numBorn = GpuGridBridge::collectFirstBirths(
+          curData, prevData, events, numEvents, bRows, bCols, skip, bGen,
+          bornCells_);
+
+      for (int born = 0;
+           born < numBorn && voicesUsed < effectiveMaxVoices &&
            triggersThisStep < maxTrigsPerStep;
-           col += skip) {
-        for (int row = 0; row < bRows; row += skip) {
-          if (GpuGridBridge::wasBornLocked(curData, prevData, bRows, bCols, row, col, bGen)) {
-            // --- Note probability: skip trigger randomly ---
+           ++born) {
+        const int row = bornCells_[born].row;
+        const int col = bornCells_[born].col;
+        // --- Note probability: skip trigger randomly ---
+        musicRng ^= musicRng << 13;
+        musicRng ^= musicRng >> 7;
+        musicRng ^= musicRng << 17;
+        float roll = static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
+        if (roll > noteProb)
+          continue; // Skip this column entirely
+
+        // --- Pitch generation (scale quantization always active) ---
+        int midiNote;
+
+        if (!musicalityBypassed) {
+          // --- Melodic inertia: repeat or stepwise motion ---
+          musicRng ^= musicRng << 13;
+          musicRng ^= musicRng >> 7;
+          musicRng ^= musicRng << 17;
+          float inertiaRoll =
+              static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
+          if (inertiaRoll < melInertia && lastTriggeredMidiNote > 0) {
+            // 50% exact repeat, 50% stepwise motion
             musicRng ^= musicRng << 13;
             musicRng ^= musicRng >> 7;
             musicRng ^= musicRng << 17;
-            float roll = static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-            if (roll > noteProb)
-              break; // Skip this column entirely
-
-            // --- Pitch generation (scale quantization always active) ---
-            int midiNote;
-
-            if (!musicalityBypassed) {
-              // --- Melodic inertia: repeat or stepwise motion ---
+            float stepRoll =
+                static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
+            if (stepRoll < 0.5f) {
+              midiNote = lastTriggeredMidiNote; // Exact repeat
+            } else {
+              // Stepwise: walk +-1 or +-2 scale degrees
               musicRng ^= musicRng << 13;
               musicRng ^= musicRng >> 7;
               musicRng ^= musicRng << 17;
-              float inertiaRoll =
+              float stepsRoll =
                   static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-              if (inertiaRoll < melInertia && lastTriggeredMidiNote > 0) {
-                // 50% exact repeat, 50% stepwise motion
-                musicRng ^= musicRng << 13;
-                musicRng ^= musicRng >> 7;
-                musicRng ^= musicRng << 17;
-                float stepRoll =
-                    static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-                if (stepRoll < 0.5f) {
-                  midiNote = lastTriggeredMidiNote; // Exact repeat
-                } else {
-                  // Stepwise: walk +-1 or +-2 scale degrees
-                  musicRng ^= musicRng << 13;
-                  musicRng ^= musicRng >> 7;
-                  musicRng ^= musicRng << 17;
-                  float stepsRoll =
-                      static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-                  int steps = (stepsRoll < 0.7f) ? 1 : 2;
-                  int stepped = lastTriggeredMidiNote;
-                  for (int s = 0; s < steps; ++s) {
-                    int next = quantizer.quantizeToNearest(
-                        stepped + lastMelodicDirection_);
-                    if (next == stepped)
-                      next = quantizer.quantizeToNearest(
-                          stepped + lastMelodicDirection_ * 2);
-                    stepped = next;
-                  }
-                  midiNote = stepped;
-                  // 15% chance of direction flip
-                  musicRng ^= musicRng << 13;
-                  musicRng ^= musicRng >> 7;
-                  musicRng ^= musicRng << 17;
-                  float flipRoll =
-                      static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-                  if (flipRoll < 0.15f)
-                    lastMelodicDirection_ *= -1;
-                }
-              } else if (pitchGravity > 0.0f) {
-                // --- Pitch gravity: bias toward chord tones ---
-                midiNote = quantizer.quantizeWeighted(
-                    row, col, baseOctave, octaveRange, bCols, pitchGravity, musicRng);
-              } else {
-                midiNote = quantizer.quantize(row, col, baseOctave, octaveRange, bCols);
-              }
-
-              // --- Consonance filter: weighted dissonance scoring ---
-              if (consonance > 0.0f && activeNoteCount > 0) {
-                int dissThreshold = static_cast<int>((1.0f - consonance) * 3.0f) + 1;
-                int dissScore = ScaleQuantizer::scoreDissAgainstAll(
-                    midiNote, activeNotes, activeNoteCount);
-                if (dissScore >= dissThreshold) {
-                  int above = quantizer.quantizeToNearest(midiNote + 1);
-                  int below = quantizer.quantizeToNearest(midiNote - 1);
-                  int scoreAbove = ScaleQuantizer::scoreDissAgainstAll(
-                      above, activeNotes, activeNoteCount);
-                  int scoreBelow = ScaleQuantizer::scoreDissAgainstAll(
-                      below, activeNotes, activeNoteCount);
-                  if (scoreAbove < dissScore && scoreAbove <= scoreBelow)
-                    midiNote = above;
-                  else if (scoreBelow < dissScore)
-                    midiNote = below;
-                }
+              int steps = (stepsRoll < 0.7f) ? 1 : 2;
+              int stepped = lastTriggeredMidiNote;
+              for (int s = 0; s < steps; ++s) {
+                int next = quantizer.quantizeToNearest(
+                    stepped + lastMelodicDirection_);
+                if (next == stepped)
+                  next = quantizer.quantizeToNearest(
+                      stepped + lastMelodicDirection_ * 2);
+                stepped = next;
               }
+              midiNote = stepped;
+              // 15% chance of direction flip
+              musicRng ^= musicRng << 13;
+              musicRng ^= musicRng >> 7;
+              musicRng ^= musicRng << 17;
+              float flipRoll =
+                  static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
+              if (flipRoll < 0.15f)
+                lastMelodicDirection_ *= -1;
+            }
+          } else if (pitchGravity > 0.0f) {
+            // --- Pitch gravity: bias toward chord tones ---
+            midiNote = quantizer.quantizeWeighted(
+                row, col, baseOctave, octaveRange, bCols, pitchGravity, musicRng);
+          } else {
+            midiNote = quantizer.quantize(row, col, baseOctave, octaveRange, bCols);
+          }
 
-              // --- Max leap clamping ---
-              if (maxLeap > 0) {
-                midiNote = quantizer.clampLeap(midiNote, lastTriggeredMidiNote, maxLeap);
-              }
-            } else {
-              // Bypassed: raw scale-quantized output only
-              midiNote = quantizer.quantize(row, col, baseOctave, octaveRange, bCols);
+          // --- Consonance filter: weighted dissonance scoring ---
+          if (consonance > 0.0f && activeNoteCount > 0) {
+            int dissThreshold = static_cast<int>((1.0f - consonance) * 3.0f) + 1;
+            int dissScore = ScaleQuantizer::scoreDissAgainstAll(
+                midiNote, activeNotes, activeNoteCount);
+            if (dissScore >= dissThreshold) {
+              int above = quantizer.quantizeToNearest(midiNote + 1);
+              int below = quantizer.quantizeToNearest(midiNote - 1);
+              int scoreAbove = ScaleQuantizer::scoreDissAgainstAll(
+                  above, activeNotes, activeNoteCount);
+              int scoreBelow = ScaleQuantizer::scoreDissAgainstAll(
+                  below, activeNotes, activeNoteCount);
+              if (scoreAbove < dissScore && scoreAbove <= scoreBelow)
+                midiNote = above;
+              else if (scoreBelow < dissScore)
+                midiNote = below;
             }
+          }
 
-            // --- Musical range clamp: C2(36) to C7(96) safety ---
-            if (midiNote < 36) midiNote = 36;
-            if (midiNote > 96) midiNote = 96;
+          // --- Max leap clamping ---
+          if (maxLeap > 0) {
+            midiNote = quantizer.clampLeap(midiNote, lastTriggeredMidiNote, maxLeap);
+          }
+        } else {
+          // Bypassed: raw scale-quantized output only
+          midiNote = quantizer.quantize(row, col, baseOctave, octaveRange, bCols);
+        }
 
-            lastTriggeredMidiNote = midiNote;
+        // --- Musical range clamp: C2(36) to C7(96) safety ---
+        if (midiNote < 36) midiNote = 36;
+        if (midiNote > 96) midiNote = 96;
 
-            // --- Pitch histogram: decaying key detection (RT-safe) ---
-            for (int i = 0; i < 12; ++i) noteHistogram_[i] *= 0.995f;
-            noteHistogram_[midiNote % 12] += 1.0f;
-            float maxW = 0.0f;
-            for (int i = 0; i < 12; ++i) {
-              if (noteHistogram_[i] > maxW) {
-                maxW = noteHistogram_[i];
-                detectedKey_ = i;
-              }
-            }
+        lastTriggeredMidiNote = midiNote;
 
-            float frequency = tuning.getFrequency(midiNote);
+        // --- Pitch histogram: decaying key detection (RT-safe) ---
+        for (int i = 0; i < 12; ++i) noteHistogram_[i] *= 0.995f;
+        noteHistogram_[midiNote % 12] += 1.0f;
+        float maxW = 0.0f;
+        for (int i = 0; i < 12; ++i) {
+          if (noteHistogram_[i] > maxW) {
+            maxW = noteHistogram_[i];
+            detectedKey_ = i;
+          }
+        }
 
-            // --- Velocity humanization + engine intensity ---
-            float vel = lastMidiVelocity;
+        float frequency = tuning.getFrequency(midiNote);
 
-            // Engine-specific intensity modulates velocity
-              float cellIntensity = GpuGridBridge::getCellIntensityLocked(curData, bRows, bCols, row, col);
-            vel *= cellIntensity;
+        // --- Velocity humanization + engine intensity ---
+        float vel = lastMidiVelocity;
 
-            if (velHumanize > 0.0f) {
-              musicRng ^= musicRng << 13;
-              musicRng ^= musicRng >> 7;
-              musicRng ^= musicRng << 17;
-              float velOffset =
-                  (static_cast<float>(musicRng & 0xFFFF) / 65535.0f - 0.5f) *
-                  2.0f * velHumanize;
-              vel = std::clamp(vel + velOffset, 0.1f, 1.0f);
-            }
+        // Engine-specific intensity modulates velocity
+          float cellIntensity = GpuGridBridge::getCellIntensityLocked(curData, bRows, bCols, row, col);
+        vel *= cellIntensity;
 
-            // Apply per-engine gain scale to prevent energy buildup
-            vel *= engineGainScale;
+        if (velHumanize > 0.0f) {
+          musicRng ^= musicRng << 13;
+          musicRng ^= musicRng >> 7;
+          musicRng ^= musicRng << 17;
+          float velOffset =
+              (static_cast<float>(musicRng & 0xFFFF) / 65535.0f - 0.5f) *
+              2.0f * velHumanize;
+          vel = std::clamp(vel + velOffset, 0.1f, 1.0f);
+        }
 
-            // Find a free voice (round-robin: rotate start index)
-            int voiceIdx = -1;
-            int searchStart = 0;
-            if (roundRobin > 0.0f) {
-              musicRng ^= musicRng << 13;
-              musicRng ^= musicRng >> 7;
-              musicRng ^= musicRng << 17;
-              float rrRoll = static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-              if (rrRoll < roundRobin)
-                searchStart = roundRobinIndex;
-            }
-            for (int i = 0; i < kMaxVoices; ++i) {
-              int v = (searchStart + i) % kMaxVoices;
-              if (!voices[v].isActive()) {
-                voiceIdx = v;
-                break;
-              }
-            }
-            roundRobinIndex = (roundRobinIndex + 1) % kMaxVoices;
-            // Steal quietest if no free voice
-            if (voiceIdx < 0) {
-              double quietest = 999.0;
-              for (int v = 0; v < kMaxVoices; ++v) {
-                if (voices[v].getEnvelopeLevel() < quietest) {
-                  quietest = voices[v].getEnvelopeLevel();
-                  voiceIdx = v;
-                }
-              }
+        // Apply per-engine gain scale to prevent energy buildup
+        vel *= engineGainScale;
+
+        // Find a free voice (round-robin: rotate start index)
+        int voiceIdx = -1;
+        int searchStart = 0;
+        if (roundRobin > 0.0f) {
+          musicRng ^= musicRng << 13;
+          musicRng ^= musicRng >> 7;
+          musicRng ^= musicRng << 17;
+          float rrRoll = static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
+          if (rrRoll < roundRobin)
+            searchStart = roundRobinIndex;
+        }
+        for (int i = 0; i < kMaxVoices; ++i) {
+          int v = (searchStart + i) % kMaxVoices;
+          if (!voices[v].isActive()) {
+            voiceIdx = v;
+            break;
+          }
+        }
+        roundRobinIndex = (roundRobinIndex + 1) % kMaxVoices;
+        // Steal quietest if no free voice
+        if (voiceIdx < 0) {
+          double quietest = 999.0;
+          for (int v = 0; v < kMaxVoices; ++v) {
+            if (voices[v].getEnvelopeLevel() < quietest) {
+              quietest = voices[v].getEnvelopeLevel();
+              voiceIdx = v;
             }
+          }
+        }
 
-            if (voiceIdx >= 0) {
-              // Waveshape spread: 0 = all voices use selected shape,
-              // 1 = cycle through shapes (Bell FM excluded from cycling)
-              int shapeIdx = waveshapeIdx;
-              if (waveSpread > 0.0f) {
-                musicRng ^= musicRng << 13;
-                musicRng ^= musicRng >> 7;
-                musicRng ^= musicRng << 17;
-                float spreadRoll =
-                    static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
-                if (spreadRoll < waveSpread) {
-                  shapeIdx = (waveshapeIdx + col) % kCycleShapeCount;
-                }
-              }
-              auto shape = static_cast<PolyBLEPOscillator::Shape>(shapeIdx);
-              voices[voiceIdx].setWaveshape(shape);
-              voices[voiceIdx].setEnvelopeParams(attack, hold, decay, sustain,
-                                                 release, currentSampleRate);
-              voices[voiceIdx].setFilterCutoff(modFilterCutoff);
-              voices[voiceIdx].setFilterResonance(filterRes);
-              voices[voiceIdx].setFilterMode(
-                  static_cast<SVFilter::Mode>(filterModeIdx));
-              voices[voiceIdx].setNoiseLevel(noiseLevel);
-              voices[voiceIdx].setSubLevel(subLevel);
-              voices[voiceIdx].setSubOctave(
-                  static_cast<SubOscillator::OctaveMode>(subOctIdx));
-
-              double pan = (bCols > 1)
-                               ? (2.0 * col / (bCols - 1) - 1.0)
-                               : 0.0;
-              pan *= static_cast<double>(
-                  apvts.getRawParameterValue("stereoWidth")->load());
-              voices[voiceIdx].setPan(pan);
-
-              voices[voiceIdx].setGridPosition(row, col);
-
-              // --- Gate time: set per-voice auto-release countdown ---
-              if (gateTimeFrac < 1.0f && stepIntervalSamples > 0) {
-                int gateSamples =
-                    static_cast<int>(gateTimeFrac * stepIntervalSamples);
-                if (gateSamples < 1)
-                  gateSamples = 1;
-                voices[voiceIdx].setGateTime(gateSamples);
-              }
+        if (voiceIdx >= 0) {
+          // Waveshape spread: 0 = all voices use selected shape,
+          // 1 = cycle through shapes (Bell FM excluded from cycling)
+          int shapeIdx = waveshapeIdx;
+          if (waveSpread > 0.0f) {
+            musicRng ^= musicRng << 13;
+            musicRng ^= musicRng >> 7;
+            musicRng ^= musicRng << 17;
+            float spreadRoll =
+                static_cast<float>(musicRng & 0xFFFF) / 65535.0f;
+            if (spreadRoll < waveSpread) {
+              shapeIdx = (waveshapeIdx + col) % kCycleShapeCount;
+            }
+          }
+          auto shape = static_cast<PolyBLEPOscillator::Shape>(shapeIdx);
+          voices[voiceIdx].setWaveshape(shape);
+          voices[voiceIdx].setEnvelopeParams(attack, hold, decay, sustain,
+                                             release, currentSampleRate);
+          voices[voiceIdx].setFilterCutoff(modFilterCutoff);
+          voices[voiceIdx].setFilterResonance(filterRes);
+          voices[voiceIdx].setFilterMode(
+              static_cast<SVFilter::Mode>(filterModeIdx));
+          voices[voiceIdx].setNoiseLevel(noiseLevel);
+          voices[voiceIdx].setSubLevel(subLevel);
+          voices[voiceIdx].setSubOctave(
+              static_cast<SubOscillator::OctaveMode>(subOctIdx));
+
+          double pan = (bCols > 1)
+                           ? (2.0 * col / (bCols - 1) - 1.0)
+                           : 0.0;
+          pan *= static_cast<double>(params.stereoWidth);
+          voices[voiceIdx].setPan(pan);
+
+          voices[voiceIdx].setGridPosition(row, col);
+
+          // --- Gate time: set per-voice auto-release countdown ---
+          if (gateTimeFrac < 1.0f && stepIntervalSamples > 0) {
+            int gateSamples =
+                static_cast<int>(gateTimeFrac * stepIntervalSamples);
+            if (gateSamples < 1)
+              gateSamples = 1;
+            voices[voiceIdx].setGateTime(gateSamples);
+          }
 
-              // --- Strum spread: onset delay per column position ---
-              if (strumSpread > 0.0f) {
-                float colFrac = (bCols > 1) ? static_cast<float>(col) /
-                                                           (bCols - 1)
-                                                     : 0.0f;
-                int delaySamples = static_cast<int>(colFrac * strumSpread *
-                                                    0.001f * currentSampleRate);
-                voices[voiceIdx].setOnsetDelay(delaySamples);
-              }
+          // --- Strum spread: onset delay per column position ---
+          if (strumSpread > 0.0f) {
+            float colFrac = (bCols > 1) ? static_cast<float>(col) /
+                                                       (bCols - 1)
+                                                 : 0.0f;
+            int delaySamples = static_cast<int>(colFrac * strumSpread *
+                                                0.001f * currentSampleRate);
+            voices[voiceIdx].setOnsetDelay(delaySamples);
+          }
 
-              voices[voiceIdx].noteOn(midiNote, vel, frequency,
-                                      currentSampleRate);
-              ++voicesUsed;
-              ++triggersThisStep;
+          voices[voiceIdx].noteOn(midiNote, vel, frequency,
+                                  currentSampleRate);
+          activeVoices_.add(&voices[voiceIdx]);
+          ++voicesUsed;
+          ++triggersThisStep;
 
-              // Add to active notes for consonance checking of subsequent
-              // triggers
-              if (activeNoteCount < kMaxVoices)
-                activeNotes[activeNoteCount++] = midiNote;
-            }
-            break; // One note per column
-          }
+          // Add to active notes for consonance checking of subsequent
+          // triggers
+          if (activeNoteCount < kMaxVoices)
+            activeNotes[activeNoteCount++] = midiNote;
         }
       }
     }
-    bridge.readUnlock();
+    bridge.readUnlock(curData);
     } // end if (bridgeHasData)
   skipTriggers:;
   }
-
-  // Render all active voices per-sample
-  for (int sample = 0; sample < numSamples; ++sample) {
-    double mixL = 0.0;
-    double mixR = 0.0;
-    for (int v = 0; v < kMaxVoices; ++v) {
-      if (voices[v].isActive()) {
-        auto stereo = voices[v].renderNextSample();
-        mixL += stereo.left;
-        mixR += stereo.right;
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::TriggerScan);
+
+  // Render the active voices block-wise (filter / amp / pan in SIMD lanes
+  // of SynthVoice::kLanes voices), in chunks sized for stack buffers.
+  // Voices reset since the last block leave the list first.
+  const auto voiceStart = juce::Time::getHighResolutionTicks();
+  activeVoices_.retire();
+  const int numActiveVoices = activeVoices_.size();
+
+  // Adaptive gain staging: normalize by the active voice count, once per
+  // block and smoothed (voices start and finish between blocks)
+  smoothVoiceNorm.setTargetValue(
+      numActiveVoices > 1
+          ? 1.0f / std::sqrt(static_cast<float>(numActiveVoices))
+          : 1.0f);
+
+  for (int start = 0; start < numSamples; start += SynthVoice::kBlockSize) {
+    const int len = std::min(SynthVoice::kBlockSize, numSamples - start);
+    float mixL[SynthVoice::kBlockSize] = {};
+    float mixR[SynthVoice::kBlockSize] = {};
+    SynthVoice::renderBlock(activeVoices_.data(), numActiveVoices, mixL, mixR,
+                            len);
+
+    for (int i = 0; i < len; ++i) {
+      const float gain =
+          smoothDensityGain.getNextValue() * smoothVoiceNorm.getNextValue();
+      const int sample = start + i;
+      if (buffer.getNumChannels() >= 2) {
+        buffer.setSample(0, sample, mixL[i] * gain);
+        buffer.setSample(1, sample, mixR[i] * gain);
+      } else if (buffer.getNumChannels() >= 1) {
+        buffer.setSample(0, sample, (mixL[i] + mixR[i]) * 0.5f * gain);
       }
     }
-
-    // Adaptive gain staging: normalize by active voice count
-    int activeVoiceCount = 0;
-    for (int v = 0; v < kMaxVoices; ++v) {
-      if (voices[v].isActive())
-        ++activeVoiceCount;
-    }
-    const double normFactor =
-        (activeVoiceCount > 1)
-            ? 1.0 / std::sqrt(static_cast<double>(activeVoiceCount))
-            : 1.0;
-    const double dGain =
-        static_cast<double>(smoothDensityGain.getNextValue()) * normFactor;
-    if (buffer.getNumChannels() >= 2) {
-      buffer.setSample(0, sample, static_cast<float>(mixL * dGain));
-      buffer.setSample(1, sample, static_cast<float>(mixR * dGain));
-    } else if (buffer.getNumChannels() >= 1) {
-      buffer.setSample(0, sample,
-                       static_cast<float>((mixL + mixR) * 0.5 * dGain));
-    }
   }
+  recordVoiceRender(numActiveVoices,
+                    juce::Time::getHighResolutionTicks() - voiceStart);
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::VoiceRender);
 
   // --- Effect on/off toggles ---
-  chorus.setBypass(!apvts.getRawParameterValue("chorusOn")->load());
-  delay.setBypass(!apvts.getRawParameterValue("delayOn")->load());
-  reverb.setBypass(!apvts.getRawParameterValue("reverbOn")->load());
-  phaser.setBypass(!apvts.getRawParameterValue("phaserOn")->load());
-  flanger.setBypass(!apvts.getRawParameterValue("flangerOn")->load());
-  bitcrush.setBypass(!apvts.getRawParameterValue("bitcrushOn")->load());
-  tapeSat.setBypass(!apvts.getRawParameterValue("tapeOn")->load());
-  shimmer.setBypass(!apvts.getRawParameterValue("shimmerOn")->load());
-  pingPong.setBypass(!apvts.getRawParameterValue("pingPongOn")->load());
+  chorus.setBypass(!params.chorusOn);
+  delay.setBypass(!params.delayOn);
+  reverb.setBypass(!params.reverbOn);
+  phaser.setBypass(!params.phaserOn);
+  flanger.setBypass(!params.flangerOn);
+  bitcrush.setBypass(!params.bitcrushOn);
+  tapeSat.setBypass(!params.tapeOn);
+  shimmer.setBypass(!params.shimmerOn);
+  pingPong.setBypass(!params.pingPongOn);
 
   // --- Modulation LFOs ---
-  modLfo1.setShape(
-      static_cast<int>(apvts.getRawParameterValue("lfo1Shape")->load()));
-  modLfo1.setRate(apvts.getRawParameterValue("lfo1Rate")->load());
-  float lfo1Amount = apvts.getRawParameterValue("lfo1Amount")->load();
-  int lfo1Dest =
-      static_cast<int>(apvts.getRawParameterValue("lfo1Dest")->load());
-  modLfo2.setShape(
-      static_cast<int>(apvts.getRawParameterValue("lfo2Shape")->load()));
-  modLfo2.setRate(apvts.getRawParameterValue("lfo2Rate")->load());
-  float lfo2Amount = apvts.getRawParameterValue("lfo2Amount")->load();
-  int lfo2Dest =
-      static_cast<int>(apvts.getRawParameterValue("lfo2Dest")->load());
+  modLfo1.setShape(static_cast<int>(params.lfo1Shape));
+  modLfo1.setRate(params.lfo1Rate);
+  float lfo1Amount = params.lfo1Amount;
+  int lfo1Dest = static_cast<int>(params.lfo1Dest);
+  modLfo2.setShape(static_cast<int>(params.lfo2Shape));
+  modLfo2.setRate(params.lfo2Rate);
+  float lfo2Amount = params.lfo2Amount;
+  int lfo2Dest = static_cast<int>(params.lfo2Dest);
 
   // Tick LFOs once per block and compute modulation offsets
   float lfo1Val = modLfo1.tickBlock(numSamples) * lfo1Amount;
@@ -1302,63 +1354,55 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
   // --- Read effect parameters (with modulation offsets) ---
   auto clamp01 = [](float v) { return std::max(0.0f, std::min(1.0f, v)); };
-  const float chorusMixP =
-      clamp01(apvts.getRawParameterValue("chorusMix")->load() + modOffsets[1]);
-  const float delayMixP =
-      clamp01(apvts.getRawParameterValue("delayMix")->load() + modOffsets[3]);
-  const float reverbMixP =
-      clamp01(apvts.getRawParameterValue("reverbMix")->load() + modOffsets[5]);
-  const float phaserMixP =
-      clamp01(apvts.getRawParameterValue("phaserMix")->load());
-  const float flangerMixP =
-      clamp01(apvts.getRawParameterValue("flangerMix")->load());
-  const float bitcrushMixP =
-      clamp01(apvts.getRawParameterValue("bitcrushMix")->load());
-  const float tapeMixP = clamp01(apvts.getRawParameterValue("tapeMix")->load());
-  const float shimmerMixP = clamp01(
-      apvts.getRawParameterValue("shimmerMix")->load() + modOffsets[10]);
-  const float pingPongMixP =
-      clamp01(apvts.getRawParameterValue("pingPongMix")->load());
+  const float chorusMixP = clamp01(params.chorusMix + modOffsets[1]);
+  const float delayMixP = clamp01(params.delayMix + modOffsets[3]);
+  const float reverbMixP = clamp01(params.reverbMix + modOffsets[5]);
+  const float phaserMixP = clamp01(params.phaserMix);
+  const float flangerMixP = clamp01(params.flangerMix);
+  const float bitcrushMixP = clamp01(params.bitcrushMix);
+  const float tapeMixP = clamp01(params.tapeMix);
+  const float shimmerMixP = clamp01(params.shimmerMix + modOffsets[10]);
+  const float pingPongMixP = clamp01(params.pingPongMix);
 
   // Configure effects (parameter reads with modulation, not per-sample)
   chorus.setRate(
-      std::max(0.1f, apvts.getRawParameterValue("chorusRate")->load() +
+      std::max(0.1f, params.chorusRate +
                          modOffsets[2] * 5.0f));
-  chorus.setDepth(apvts.getRawParameterValue("chorusDepth")->load());
+  chorus.setDepth(params.chorusDepth);
   chorus.setMix(chorusMixP);
 
   delay.setTime(
-      std::max(0.01f, apvts.getRawParameterValue("delayTime")->load() +
+      std::max(0.01f, params.delayTime +
                           modOffsets[4] * 2.0f));
-  delay.setFeedback(apvts.getRawParameterValue("delayFeedback")->load());
+  delay.setFeedback(params.delayFeedback);
   delay.setMix(delayMixP);
 
-  reverb.setDecay(apvts.getRawParameterValue("reverbDecay")->load());
-  reverb.setDamping(apvts.getRawParameterValue("reverbDamping")->load());
+  reverb.setDecay(params.reverbDecay);
+  reverb.setDamping(params.reverbDamping);
   reverb.setMix(reverbMixP);
 
-  phaser.setRate(apvts.getRawParameterValue("phaserRate")->load());
-  phaser.setDepth(apvts.getRawParameterValue("phaserDepth")->load());
+  phaser.setRate(params.phaserRate);
+  phaser.setDepth(params.phaserDepth);
   phaser.setMix(phaserMixP);
 
-  flanger.setRate(apvts.getRawParameterValue("flangerRate")->load());
-  flanger.setDepth(apvts.getRawParameterValue("flangerDepth")->load());
+  flanger.setRate(params.flangerRate);
+  flanger.setDepth(params.flangerDepth);
   flanger.setMix(flangerMixP);
 
-  bitcrush.setBitDepth(apvts.getRawParameterValue("bitcrushBits")->load());
-  bitcrush.setDownsample(apvts.getRawParameterValue("bitcrushRate")->load());
+  bitcrush.setBitDepth(params.bitcrushBits);
+  bitcrush.setDownsample(params.bitcrushRate);
   bitcrush.setMix(bitcrushMixP);
 
-  tapeSat.setDrive(apvts.getRawParameterValue("tapeDrive")->load());
-  tapeSat.setTone(apvts.getRawParameterValue("tapeTone")->load());
+  tapeSat.setDrive(params.tapeDrive);
+  tapeSat.setTone(params.tapeTone);
   tapeSat.setMix(tapeMixP);
 
-  shimmer.setDecay(apvts.getRawParameterValue("shimmerDecay")->load());
-  shimmer.setShimmer(apvts.getRawParameterValue("shimmerAmount")->load());
+  shimmer.setDecay(params.shimmerDecay);
+  shimmer.setShimmer(params.shimmerAmount);
   shimmer.setMix(shimmerMixP);
 
-  pingPong.setTime(apvts.getRawParameterValue("pingPongTime")->load());
-  pingPong.setFeedback(apvts.getRawParameterValue("pingPongFeedback")->load());
+  pingPong.setTime(params.pingPongTime);
+  pingPong.setFeedback(params.pingPongFeedback);
   pingPong.setMix(pingPongMixP);
 
   // --- Apply effects chain (parallel send/return architecture) ---
@@ -1377,21 +1421,19 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       return x - (x * x * x) / 6.75f;
     };
 
-    for (int sample = 0; sample < numSamples; ++sample) {
-      float dryL = buffer.getSample(0, sample);
-      float dryR = buffer.getSample(1, sample);
-
-      // Soft-clip before feeding effects
-      float clippedL = softClip(dryL);
-      float clippedR = softClip(dryR);
-
-      float outL, outR;
-      effectChain.processParallel(clippedL, clippedR, outL, outR);
+    float *left = buffer.getWritePointer(0);
+    float *right = buffer.getWritePointer(1);
 
-      buffer.setSample(0, sample, outL);
-      buffer.setSample(1, sample, outR);
+    // Soft-clip before feeding effects
+    for (int sample = 0; sample < numSamples; ++sample) {
+      left[sample] = softClip(left[sample]);
+      right[sample] = softClip(right[sample]);
     }
+
+    // Each effect processes the whole block; wet sends summed per block
+    effectChain.processParallelBlock(left, right, left, right, numSamples);
   }
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::Effects);
 
   // --- Safety limiter (brick-wall, always active) ---
   {
@@ -1399,6 +1441,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     juce::dsp::ProcessContextReplacing<float> ctx(block);
     safetyLimiter.process(ctx);
   }
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::SafetyLimiter);
 
   // --- SafetyProcessor (DC filter + ultrasonic LP + brickwall, always active)
   // ---
@@ -1411,6 +1454,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       buffer.setSample(1, sample, R);
     }
   }
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::SafetyProcessor);
 
   // Update grid snapshot for UI thread (only when bridge has new data)
   // Throttle conversion for large grids to prevent audio thread overload:
@@ -1429,6 +1473,7 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     }
   }
   engineGeneration.store(engine->getGeneration(), std::memory_order_relaxed);
+  ALGO_PROFILE_LAP(stageWatch_, stageTimings_, ProfileStage::SnapshotConvert);
 
   // Apply master volume with smoothing (per-sample)
   for (int sample = 0; sample < numSamples; ++sample) {
@@ -1447,6 +1492,44 @@ void AlgoNebulaProcessor::processBlock(juce::AudioBuffer<float> &buffer,
       std::memory_order_relaxed);
 }
 
+AlgoNebulaProcessor::VoiceRenderStats
+AlgoNebulaProcessor::getVoiceRenderStats() const {
+  VoiceRenderStats s;
+  s.blocks = statVoiceBlocks_.load(std::memory_order_relaxed);
+  s.lastUs = statVoiceLastNs_.load(std::memory_order_relaxed) * 1.0e-3;
+  s.maxUs = statVoiceMaxNs_.load(std::memory_order_relaxed) * 1.0e-3;
+  if (s.blocks > 0) {
+    const double blocks = static_cast<double>(s.blocks);
+    s.meanActiveVoices =
+        static_cast<double>(
+            statVoiceActiveSum_.load(std::memory_order_relaxed)) /
+        blocks;
+    s.meanUs = statVoiceSumNs_.load(std::memory_order_relaxed) * 1.0e-3 /
+               blocks;
+  }
+  return s;
+}
+
+void AlgoNebulaProcessor::recordVoiceRender(int activeVoices,
+                                            juce::int64 ticks) {
+  if (resetVoiceStats_.exchange(false, std::memory_order_relaxed)) {
+    statVoiceBlocks_.store(0, std::memory_order_relaxed);
+    statVoiceActiveSum_.store(0, std::memory_order_relaxed);
+    statVoiceLastNs_.store(0, std::memory_order_relaxed);
+    statVoiceSumNs_.store(0, std::memory_order_relaxed);
+    statVoiceMaxNs_.store(0, std::memory_order_relaxed);
+  }
+  const auto ns = static_cast<uint64_t>(
+      juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9);
+  statVoiceActiveSum_.fetch_add(static_cast<uint64_t>(activeVoices),
+                                std::memory_order_relaxed);
+  statVoiceSumNs_.fetch_add(ns, std::memory_order_relaxed);
+  statVoiceLastNs_.store(ns, std::memory_order_relaxed);
+  if (ns > statVoiceMaxNs_.load(std::memory_order_relaxed))
+    statVoiceMaxNs_.store(ns, std::memory_order_relaxed);
+  statVoiceBlocks_.fetch_add(1, std::memory_order_relaxed);
+}
+
 //==============================================================================
 juce::AudioProcessorEditor *AlgoNebulaProcessor::createEditor() {
   return new AlgoNebulaEditor(*this);
@@ -1457,44 +1540,36 @@ void AlgoNebulaProcessor::getStateInformation(juce::MemoryBlock &destData) {
   auto state = apvts.copyState();
   std::unique_ptr<juce::XmlElement> xml(state.createXml());
 
-  // Append grid state as child element
+  // Cells, ages and continuous fields (see GridStateCodec.h), encoded by
+  // the snapshotter: the engine may be stepping right now, so it is never
+  // read here. Every engine swap or restore captures the new state, so an
+  // image always exists; while the first one is still encoding in the
+  // background, the snapshotter encodes its copy here without waiting.
+  const auto image = stateSnapshotter_.latestOrEncode();
+  jassert(image != nullptr);
+  if (image == nullptr) {
+    copyXmlToBinary(*xml, destData); // parameters only
+    return;
+  }
+
+  // Append grid state as child element. Version 2: the grid itself is a
+  // binary GridStateCodec chunk appended after the XML blob (chunkBytes
+  // long); the XML only describes it.
   auto *gridXml = xml->createNewChildElement("GridState");
-  gridXml->setAttribute("version", 1);
+  gridXml->setAttribute("version", 2);
   gridXml->setAttribute("algorithm", lastAlgorithmIdx);
   gridXml->setAttribute("gridSize", lastGridSizeIdx);
   gridXml->setAttribute("seed",
                         juce::String(static_cast<juce::int64>(
                             currentSeed.load(std::memory_order_relaxed))));
+  gridXml->setAttribute("rows", image->rows);
+  gridXml->setAttribute("cols", image->cols);
+  gridXml->setAttribute("chunkBytes", static_cast<int>(image->chunk.size()));
 
-  // Encode grid cells and ages as base64
-  const auto &grid = engine->getGrid();
-  int rows = grid.getRows();
-  int cols = grid.getCols();
-  gridXml->setAttribute("rows", rows);
-  gridXml->setAttribute("cols", cols);
-
-  // Cell data: pack only the active region (rows * cols bytes)
-  juce::MemoryBlock cellBlock(static_cast<size_t>(rows * cols));
-  for (int r = 0; r < rows; ++r)
-    for (int c = 0; c < cols; ++c)
-      static_cast<uint8_t *>(cellBlock.getData())[r * cols + c] =
-          grid.getCell(r, c);
-  gridXml->setAttribute("cells", cellBlock.toBase64Encoding());
-
-  // Age data: pack as little-endian uint16 (rows * cols * 2 bytes)
-  juce::MemoryBlock ageBlock(static_cast<size_t>(rows * cols * 2));
-  auto *agePtr = static_cast<uint8_t *>(ageBlock.getData());
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      uint16_t age = grid.getAge(r, c);
-      int idx = (r * cols + c) * 2;
-      agePtr[idx] = static_cast<uint8_t>(age & 0xFF);
-      agePtr[idx + 1] = static_cast<uint8_t>((age >> 8) & 0xFF);
-    }
-  }
-  gridXml->setAttribute("ages", ageBlock.toBase64Encoding());
-
+  // getXmlFromBinary() reads only the XML blob, so older builds still
+  // restore the parameters
   copyXmlToBinary(*xml, destData);
+  destData.append(image->chunk.data(), image->chunk.size());
 }
 
 void AlgoNebulaProcessor::setStateInformation(const void *data,
@@ -1516,10 +1591,8 @@ void AlgoNebulaProcessor::setStateInformation(const void *data,
     return; // Unknown version ÃƒÆ’Ã‚Â¢ÃƒÂ¢Ã¢â‚¬Å¡Ã‚Â¬ÃƒÂ¢Ã¢â€šÂ¬Ã‚Â skip grid restore
 
   // Use APVTS as source of truth for algorithm/grid (already restored above)
-  int algoIdx =
-      static_cast<int>(apvts.getRawParameterValue("algorithm")->load());
-  int gridSizeIdx =
-      static_cast<int>(apvts.getRawParameterValue("gridSize")->load());
+  int algoIdx = static_cast<int>(paramHandles_.algorithm->load());
+  int gridSizeIdx = static_cast<int>(paramHandles_.gridSize->load());
   auto seed = static_cast<uint64_t>(
       gridXml->getStringAttribute("seed", "12345").getLargeIntValue());
 
@@ -1533,56 +1606,79 @@ void AlgoNebulaProcessor::setStateInformation(const void *data,
   // Recreate engine
   lastAlgorithmIdx = algoIdx;
   lastGridSizeIdx = gridSizeIdx;
+  simThread_.stop(); // joined before the old engine is destroyed
   engine = createEngine(algoIdx, rows, cols);
+  engine->setWorkerPool(&workerPool_);
   currentSeed.store(seed, std::memory_order_relaxed);
 
-  // Decode cell data
-  juce::String cellB64 = gridXml->getStringAttribute("cells", "");
+  if (version >= 2) {
+    // Binary chunk at the end of the data
+    const int chunkBytes = gridXml->getIntAttribute("chunkBytes", 0);
+    if (chunkBytes > 0 && chunkBytes <= sizeInBytes)
+      GridStateCodec::decode(static_cast<const uint8_t *>(data) +
+                                 (sizeInBytes - chunkBytes),
+                             static_cast<size_t>(chunkBytes), *engine);
+  } else {
+    restoreGridStateV1(*gridXml, rows, cols);
+  }
+
+  // Update bridge and snapshot from restored engine state
+  gpuCompute.getBridge().updateFromCpu(engine->getGrid());
+  {
+    int backIdx = 1 - gridReadIdx_.load(std::memory_order_relaxed);
+    gpuCompute.getBridge().convertToGrid(gridSnapshots_[backIdx]);
+    gridReadIdx_.store(backIdx, std::memory_order_release);
+  }
+  stagnationCounter = 0;
+  lastAliveCount = 0;
+
+  // Re-wire the simulation thread to the new engine (stopped above)
+  simThread_.setTargets(engine.get(), &gpuCompute.getBridge(), &cellEditQueue);
+  startSimulation();
+}
+
+void AlgoNebulaProcessor::restoreGridStateV1(const juce::XmlElement &gridXml,
+                                             int rows, int cols) {
+  // Cell data: rows * cols bytes, base64
+  juce::String cellB64 = gridXml.getStringAttribute("cells", "");
   if (cellB64.isNotEmpty()) {
     juce::MemoryBlock cellBlock;
     if (cellBlock.fromBase64Encoding(cellB64) &&
         cellBlock.getSize() >= static_cast<size_t>(rows * cols)) {
-      auto &grid = engine->getGridMutable();
-      const auto *cellData = static_cast<const uint8_t *>(cellBlock.getData());
-      for (int r = 0; r < rows; ++r)
-        for (int c = 0; c < cols; ++c)
-          grid.setCell(r, c, cellData[r * cols + c]);
+      GridStateCodec::unpackCells(
+          engine->getGridMutable(),
+          static_cast<const uint8_t *>(cellBlock.getData()));
     }
   }
 
-  // Decode age data
-  juce::String ageB64 = gridXml->getStringAttribute("ages", "");
+  // Age data: little-endian uint16 (rows * cols * 2 bytes), base64
+  juce::String ageB64 = gridXml.getStringAttribute("ages", "");
   if (ageB64.isNotEmpty()) {
     juce::MemoryBlock ageBlock;
     if (ageBlock.fromBase64Encoding(ageB64) &&
         ageBlock.getSize() >= static_cast<size_t>(rows * cols * 2)) {
-      auto &grid = engine->getGridMutable();
-      const auto *ageData = static_cast<const uint8_t *>(ageBlock.getData());
-      for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
-            int idx = (r * cols + c) * 2;
-            uint16_t age = static_cast<uint16_t>(ageData[idx]) |
-                           (static_cast<uint16_t>(ageData[idx + 1]) << 8);
-            grid.setAge(r, c, age);
-          }
-        }
-      }
+      GridStateCodec::unpackAges(
+          engine->getGridMutable(),
+          static_cast<const uint8_t *>(ageBlock.getData()));
     }
+  }
+}
 
-  // Update bridge and snapshot from restored engine state
+void AlgoNebulaProcessor::rebuildEngine(int algoIdx, int rows, int cols,
+                                        uint64_t seed) {
+  simThread_.stop();
+  engine = createEngine(algoIdx, rows, cols);
+  engine->setWorkerPool(&workerPool_);
+  engine->randomize(seed, 0.3f);
   gpuCompute.getBridge().updateFromCpu(engine->getGrid());
-  {
-    int backIdx = 1 - gridReadIdx_.load(std::memory_order_relaxed);
-    gpuCompute.getBridge().convertToGrid(gridSnapshots_[backIdx]);
-    gridReadIdx_.store(backIdx, std::memory_order_release);
-  }
-  stagnationCounter = 0;
-  lastAliveCount = 0;
+  simThread_.setTargets(engine.get(), &gpuCompute.getBridge(), &cellEditQueue);
+  startSimulation();
+}
 
-  // Re-wire timer to the new engine (setStateInformation replaces engine)
-  cpuStepTimer_.stop();
-  cpuStepTimer_.setTargets(engine.get(), &gpuCompute.getBridge(), &cellEditQueue);
-  cpuStepTimer_.start();
+void AlgoNebulaProcessor::startSimulation() {
+  stateSnapshotter_.reset(*engine);
+  if (!syncStepping_)
+    simThread_.start();
 }
 
 //==============================================================================
@@ -6,22 +6,31 @@
 #include <juce_dsp/juce_dsp.h>
 #include <memory>
 
+#include "BlockParams.h"
+#include "engine/ActiveVoiceList.h"
+#include "engine/AudioWorkerPool.h"
 #include "engine/BriansBrain.h"
 #include "engine/BrownianField.h"
 #include "engine/CellEditQueue.h"
 #include "engine/CellularEngine.h"
-#include "engine/CpuStepTimer.h"
 #include "engine/ClockDivider.h"
 #include "engine/CyclicCA.h"
 #include "engine/FactoryPatternLibrary.h"
 #include "engine/GameOfLife.h"
 #include "engine/Grid.h"
+#include "engine/GridSizes.h"
+#include "engine/GridStateCodec.h"
+#include "engine/HashLife.h"
 #include "engine/LeniaEngine.h"
 #include "engine/Microtuning.h"
 #include "engine/ParticleSwarm.h"
 #include "engine/ReactionDiffusion.h"
 #include "engine/ScaleQuantizer.h"
+#include "engine/SimulationThread.h"
+#include "engine/StageProfiler.h"
+#include "engine/StateSnapshotter.h"
 #include "engine/SynthVoice.h"
+#include "engine/WorkerPool.h"
 
 #include "dsp/Bitcrush.h"
 #include "dsp/EffectChain.h"
@@ -53,6 +62,9 @@ public:
   void prepareToPlay(double sampleRate, int samplesPerBlock) override;
   void releaseResources() override;
   void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
+  /// Also switches between threaded and synchronous engine stepping, for
+  /// hosts that toggle offline rendering without a new prepareToPlay().
+  void setNonRealtime(bool isNonRealtime) noexcept override;
 
   juce::AudioProcessorEditor *createEditor() override;
   bool hasEditor() const override { return true; }
@@ -81,6 +93,39 @@ public:
   float getCpuLoadPercent() const {
     return cpuLoadPercent.load(std::memory_order_relaxed);
   }
+  /// Step request-to-publish latency of the CPU simulation thread.
+  SimulationThread::LatencyStats getSimLatencyStats() const {
+    return simThread_.getLatencyStats();
+  }
+
+  /// Voice rendering per processBlock: active voices and render time.
+  struct VoiceRenderStats {
+    uint64_t blocks = 0;           // processBlock calls measured
+    double meanActiveVoices = 0.0; // voices rendered per block
+    double lastUs = 0.0;
+    double meanUs = 0.0;
+    double maxUs = 0.0;
+  };
+  VoiceRenderStats getVoiceRenderStats() const;
+  void resetVoiceRenderStats() {
+    resetVoiceStats_.store(true, std::memory_order_relaxed);
+  }
+
+  /// Effect send time per chain slot in the last block and the thread that
+  /// ran it (0 = audio thread, 1.. = effect workers).
+  EffectChain::SlotTiming getEffectTiming(int slot) const {
+    return effectChain.getSlotTiming(slot);
+  }
+  int getNumEffectThreads() const { return effectWorkers_.getNumThreads(); }
+
+  /// Per-stage timing (p50 / p99 / max) of processBlock() and of engine
+  /// steps. Drains the timing rings, so call from one thread only (the
+  /// editor timer). Empty when built with ALGO_PROFILING=0.
+  const StageStatistics &collectStageTimings() {
+    stageStats_.collect(stageTimings_);
+    stageStats_.collect(simThread_.getStepTimings());
+    return stageStats_;
+  }
 
   // --- Engine access (UI thread reads grid snapshot, pushes edits) ---
   const Grid &getGridSnapshot() const {
@@ -118,6 +163,8 @@ private:
   createParameterLayout();
 
   juce::AudioProcessorValueTreeState apvts;
+  BlockParamHandles paramHandles_; // resolved once in the constructor
+  juce::RangedAudioParameter *keyParam_ = nullptr; // MIDI key tracking
 
   //--- Smoothed parameters (read by audio thread) ---
   juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> masterVolume;
@@ -129,18 +176,38 @@ private:
   juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smoothSubLevel;
   juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear>
       smoothDensityGain;
+  // 1/sqrt(active voices), retargeted once per block
+  juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear>
+      smoothVoiceNorm;
 
   // --- Pre-allocated audio buffers ---
   juce::AudioBuffer<float> stereoMixBuffer;
 
   // --- Cellular Engine ---
+  // Declared before engine so it outlives it: engines step their row bands
+  // on this pool (from the CPU step thread, never the audio thread).
+  WorkerPool workerPool_;
   std::unique_ptr<CellularEngine> engine;
   static std::unique_ptr<CellularEngine>
   createEngine(int algoIdx, int rows = 12, int cols = 16);
+  /// Replace the engine (seeded) and re-wire the simulation thread. Joins
+  /// the thread: message thread, or the audio thread when rendering offline.
+  void rebuildEngine(int algoIdx, int rows, int cols, uint64_t seed);
+  /// Capture the (new or restored) engine state for saving, then start the
+  /// simulation thread unless rendering offline.
+  void startSimulation();
+  /// Restore cells / ages saved by GridState version 1 (base64 XML).
+  void restoreGridStateV1(const juce::XmlElement &gridXml, int rows, int cols);
   Grid gridSnapshots_[2]; // Double-buffered: audio writes back, UI reads front
   std::atomic<int> gridReadIdx_{0}; // 0 or 1: which buffer UI reads
   CellEditQueue cellEditQueue;
-  CpuStepTimer cpuStepTimer_;
+  // Encoded engine state for getStateInformation(), captured by simThread_
+  StateSnapshotter stateSnapshotter_;
+  SimulationThread simThread_;
+  // Offline render (isNonRealtime()): no simulation thread; processBlock()
+  // runs the step requests itself, deterministically. Set in
+  // prepareToPlay() and setNonRealtime()
+  std::atomic<bool> syncStepping_{false};
   std::atomic<uint64_t> engineGeneration{0};
   uint64_t lastSnapshotGeneration_{UINT64_MAX}; // sentinel: always convert on first call
 
@@ -152,6 +219,9 @@ private:
   // --- Synth Voices ---
   static constexpr int kMaxVoices = 64;
   SynthVoice voices[kMaxVoices];
+  static_assert(ActiveVoiceList::kCapacity >= kMaxVoices,
+                "active list must hold every voice");
+  ActiveVoiceList activeVoices_; // started voices, retired once inactive
   int roundRobinIndex = 0;
   bool stepTriggeredThisBlock = false;
 
@@ -159,6 +229,9 @@ private:
   juce::MidiKeyboardState keyboardState;
   float lastMidiVelocity = 0.8f;
 
+  // --- Trigger candidates (audio thread, one per subsampled column) ---
+  GpuGridBridge::CellPos bornCells_[Grid::kMaxCols];
+
   // --- Auto-reseed stagnation tracking ---
   int lastAliveCount = 0;
   int stagnationCounter = 0;
@@ -196,6 +269,8 @@ private:
   PingPongDelay pingPong;
 
   // --- Effect chain manager ---
+  // Helper threads for the effect sends, declared before the chain
+  AudioWorkerPool effectWorkers_;
   EffectChain effectChain;
 
   // --- Safety limiter (brick-wall, before SafetyProcessor) ---
@@ -211,6 +286,18 @@ private:
 
   // --- Performance monitoring ---
   std::atomic<float> cpuLoadPercent{0.0f};
+  // Per-stage timers: audio thread -> collectStageTimings() caller
+  StageTimingRing stageTimings_;
+  StageStopwatch stageWatch_;
+  StageStatistics stageStats_;
+  void recordVoiceRender(int activeVoices, juce::int64 ticks);
+  // Voice render stats (written by the audio thread only)
+  std::atomic<bool> resetVoiceStats_{false};
+  std::atomic<uint64_t> statVoiceBlocks_{0};
+  std::atomic<uint64_t> statVoiceActiveSum_{0};
+  std::atomic<uint64_t> statVoiceLastNs_{0};
+  std::atomic<uint64_t> statVoiceSumNs_{0};
+  std::atomic<uint64_t> statVoiceMaxNs_{0};
   double currentSampleRate = 44100.0;
   int currentBlockSize = 512;
 
@@ -218,6 +305,9 @@ private:
   GpuComputeManager gpuCompute;
   std::atomic<bool> gpuActive{false};
   std::atomic<bool> gpuPending{false}; // prevents duplicate callAsync
+  // setEngine()/start() failed: stay on the CPU until the algorithm or
+  // grid size changes
+  std::atomic<bool> gpuUnavailable{false};
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AlgoNebulaProcessor)
 };
\ No newline at end of file
@@ -30,16 +30,29 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    // Sample rate reduction via sample-and-hold
-    holdCounter_ += 1.0f;
-    if (holdCounter_ >= downsampleFactor_) {
-      holdCounter_ -= downsampleFactor_;
-      // Bit depth reduction: quantize to N levels
-      holdL_ = std::floor(inL * levels_) / levels_;
-      holdR_ = std::floor(inR * levels_) / levels_;
+    Bitcrush::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
+
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    float holdL = holdL_;
+    float holdR = holdR_;
+    float counter = holdCounter_;
+    for (int i = 0; i < n; ++i) {
+      // Sample rate reduction via sample-and-hold
+      counter += 1.0f;
+      if (counter >= downsampleFactor_) {
+        counter -= downsampleFactor_;
+        // Bit depth reduction: quantize to N levels
+        holdL = std::floor(inL[i] * levels_) / levels_;
+        holdR = std::floor(inR[i] * levels_) / levels_;
+      }
+      outL[i] = sanitize(holdL);
+      outR[i] = sanitize(holdR);
     }
-    outL = sanitize(holdL_);
-    outR = sanitize(holdR_);
+    holdL_ = holdL;
+    holdR_ = holdR;
+    holdCounter_ = counter;
   }
 
   void reset() override {
@@ -1,18 +1,26 @@
 // EffectChain.h - Reorderable effect slot manager
 // Manages an ordered array of StereoEffect pointers with per-effect
 // bypass and parallel send/return architecture.
-// Header-only, no external dependencies beyond StereoEffect.
+// Header-only; large blocks can fan the sends out over an AudioWorkerPool.
 #pragma once
 
+#include "../engine/AudioWorkerPool.h"
 #include "StereoEffect.h"
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 class EffectChain {
 public:
-  static constexpr int kMaxSlots = 9; // Max number of effect slots
+  static constexpr int kMaxSlots = 9;    // Max number of effect slots
+  static constexpr int kBlockSize = 256; // Samples per processBlock() chunk
+  static constexpr int kDefaultParallelThreshold = 1024;
+
+  EffectChain() { resetTimings(); }
 
   void init(float sampleRate) {
     sr_ = sampleRate;
@@ -22,6 +30,50 @@ public:
     }
   }
 
+  // Allocate the per-slot send buffers used when sends run on worker
+  // threads. Call outside the audio thread (prepareToPlay).
+  void prepare(int maxBlockSize) {
+    sendCapacity_ = std::max(0, maxBlockSize);
+    for (int i = 0; i < kMaxSlots; ++i) {
+      sendL_[i].assign(static_cast<size_t>(sendCapacity_), 0.0f);
+      sendR_[i].assign(static_cast<size_t>(sendCapacity_), 0.0f);
+    }
+  }
+
+  // Run the sends of blocks of at least parallelThreshold samples on the
+  // pool, one task per active effect (nullptr: always serial). Requires
+  // prepare(). Set outside the audio thread.
+  void setWorkerPool(AudioWorkerPool *pool) { pool_ = pool; }
+  void setParallelThreshold(int samples) {
+    parallelThreshold_ = std::max(1, samples);
+  }
+  int getParallelThreshold() const { return parallelThreshold_; }
+
+  // Per-effect time of the last processParallelBlock() call, and which
+  // thread ran it (0 = the calling audio thread, 1.. = pool helpers).
+  // Readable from any thread.
+  struct SlotTiming {
+    int thread = -1; // -1: not run since resetTimings()
+    float lastUs = 0.0f;
+    float maxUs = 0.0f;
+  };
+  SlotTiming getSlotTiming(int index) const {
+    SlotTiming t;
+    if (index < 0 || index >= kMaxSlots)
+      return t;
+    t.thread = timingThread_[index].load(std::memory_order_relaxed);
+    t.lastUs = timingLastUs_[index].load(std::memory_order_relaxed);
+    t.maxUs = timingMaxUs_[index].load(std::memory_order_relaxed);
+    return t;
+  }
+  void resetTimings() {
+    for (int i = 0; i < kMaxSlots; ++i) {
+      timingThread_[i].store(-1, std::memory_order_relaxed);
+      timingLastUs_[i].store(0.0f, std::memory_order_relaxed);
+      timingMaxUs_[i].store(0.0f, std::memory_order_relaxed);
+    }
+  }
+
   // Set an effect in a slot. nullptr clears the slot.
   void setSlot(int index, StereoEffect *effect) {
     if (index >= 0 && index < kMaxSlots)
@@ -84,6 +136,32 @@ public:
     outR = dryR + wetSumR * kWetAttenuation;
   }
 
+  // Block form of processParallel(): same output, but each active effect
+  // runs one processBlock() over the chunk and its wet send is accumulated
+  // per block. outL/outR may alias dryL/dryR (in-place). No allocations.
+  // Blocks of parallelThreshold samples or more run the sends on the
+  // worker pool (if set); the sum is taken in slot order either way.
+  void processParallelBlock(const float *dryL, const float *dryR, float *outL,
+                            float *outR, int numSamples) {
+    int64_t slotNs[kMaxSlots] = {};
+    int slotThread[kMaxSlots] = {};
+    if (pool_ != nullptr && pool_->getNumThreads() > 1 &&
+        sendCapacity_ > 0 && numSamples >= parallelThreshold_) {
+      for (int start = 0; start < numSamples; start += sendCapacity_) {
+        const int n = std::min(sendCapacity_, numSamples - start);
+        processParallelSends(dryL + start, dryR + start, outL + start,
+                             outR + start, n, slotNs, slotThread);
+      }
+    } else {
+      for (int start = 0; start < numSamples; start += kBlockSize) {
+        const int n = std::min(kBlockSize, numSamples - start);
+        processParallelChunk(dryL + start, dryR + start, outL + start,
+                             outR + start, n, slotNs);
+      }
+    }
+    recordTimings(slotNs, slotThread);
+  }
+
   // Process in series (for effects that should be chained).
   // Each effect feeds into the next.
   void processSeries(float inL, float inR, float &outL, float &outR) {
@@ -107,6 +185,135 @@ public:
 private:
   static constexpr float kWetAttenuation = 0.5f;
 
+  using Clock = std::chrono::steady_clock;
+
+  void processParallelChunk(const float *dryL, const float *dryR, float *outL,
+                            float *outR, int n, int64_t *slotNs) {
+    std::fill(wetSumL_, wetSumL_ + n, 0.0f);
+    std::fill(wetSumR_, wetSumR_ + n, 0.0f);
+    int activeCount = 0;
+
+    for (int s = 0; s < kMaxSlots; ++s) {
+      StereoEffect *fx = slots_[s];
+      if (fx == nullptr || fx->isBypassed() || fx->getMix() <= 0.0f)
+        continue;
+
+      const auto start = Clock::now();
+      fx->processBlock(dryL, dryR, fxL_, fxR_, n);
+      slotNs[s] += elapsedNs(start);
+
+      // Extract wet-only signal and scale by mix
+      const float mix = fx->getMix();
+      for (int i = 0; i < n; ++i) {
+        wetSumL_[i] += (fxL_[i] - dryL[i]) * mix;
+        wetSumR_[i] += (fxR_[i] - dryR[i]) * mix;
+      }
+      ++activeCount;
+    }
+
+    if (activeCount == 0) {
+      if (outL != dryL)
+        std::copy(dryL, dryL + n, outL);
+      if (outR != dryR)
+        std::copy(dryR, dryR + n, outR);
+      return;
+    }
+
+    // Attenuate summed wet signal to prevent level boost
+    for (int i = 0; i < n; ++i) {
+      outL[i] = dryL[i] + wetSumL_[i] * kWetAttenuation;
+      outR[i] = dryR[i] + wetSumR_[i] * kWetAttenuation;
+    }
+  }
+
+  // One pool task per active effect: each writes its scaled wet send to its
+  // own slot buffer; the caller then sums the sends in slot order, so the
+  // result matches processParallelChunk(). n <= sendCapacity_.
+  void processParallelSends(const float *dryL, const float *dryR, float *outL,
+                            float *outR, int n, int64_t *slotNs,
+                            int *slotThread) {
+    int active[kMaxSlots];
+    float mixes[kMaxSlots];
+    int count = 0;
+    for (int s = 0; s < kMaxSlots; ++s) {
+      StereoEffect *fx = slots_[s];
+      if (fx == nullptr || fx->isBypassed() || fx->getMix() <= 0.0f)
+        continue;
+      active[count] = s;
+      mixes[count] = fx->getMix();
+      ++count;
+    }
+
+    if (count == 0) {
+      if (outL != dryL)
+        std::copy(dryL, dryL + n, outL);
+      if (outR != dryR)
+        std::copy(dryR, dryR + n, outR);
+      return;
+    }
+
+    pool_->run(count, [&](int task, int thread) {
+      const int s = active[task];
+      float *sendL = sendL_[s].data();
+      float *sendR = sendR_[s].data();
+      const auto start = Clock::now();
+      slots_[s]->processBlock(dryL, dryR, sendL, sendR, n);
+      const float mix = mixes[task];
+      for (int i = 0; i < n; ++i) {
+        sendL[i] = (sendL[i] - dryL[i]) * mix;
+        sendR[i] = (sendR[i] - dryR[i]) * mix;
+      }
+      slotNs[s] += elapsedNs(start);
+      slotThread[s] = thread;
+    });
+
+    for (int i = 0; i < n; ++i) {
+      float wetSumL = 0.0f;
+      float wetSumR = 0.0f;
+      for (int k = 0; k < count; ++k) {
+        wetSumL += sendL_[active[k]][i];
+        wetSumR += sendR_[active[k]][i];
+      }
+      outL[i] = dryL[i] + wetSumL * kWetAttenuation;
+      outR[i] = dryR[i] + wetSumR * kWetAttenuation;
+    }
+  }
+
+  static int64_t elapsedNs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                start)
+        .count();
+  }
+
+  void recordTimings(const int64_t *slotNs, const int *slotThread) {
+    for (int s = 0; s < kMaxSlots; ++s) {
+      if (slotNs[s] == 0)
+        continue;
+      const float us = static_cast<float>(slotNs[s]) * 1.0e-3f;
+      timingThread_[s].store(slotThread[s], std::memory_order_relaxed);
+      timingLastUs_[s].store(us, std::memory_order_relaxed);
+      if (us > timingMaxUs_[s].load(std::memory_order_relaxed))
+        timingMaxUs_[s].store(us, std::memory_order_relaxed);
+    }
+  }
+
   float sr_ = 44100.0f;
   StereoEffect *slots_[kMaxSlots] = {};
+
+  // processParallelBlock() scratch: one effect's output, summed wet sends
+  float fxL_[kBlockSize] = {};
+  float fxR_[kBlockSize] = {};
+  float wetSumL_[kBlockSize] = {};
+  float wetSumR_[kBlockSize] = {};
+
+  // Parallel sends: one wet buffer pair per slot (sized by prepare())
+  AudioWorkerPool *pool_ = nullptr;
+  int parallelThreshold_ = kDefaultParallelThreshold;
+  int sendCapacity_ = 0;
+  std::vector<float> sendL_[kMaxSlots];
+  std::vector<float> sendR_[kMaxSlots];
+
+  std::atomic<int> timingThread_[kMaxSlots] = {};
+  std::atomic<float> timingLastUs_[kMaxSlots] = {};
+  std::atomic<float> timingMaxUs_[kMaxSlots] = {};
 };
@@ -48,29 +48,51 @@ public:
   void setWidth(float w) { width_ = std::max(0.0f, std::min(1.0f, w)); }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    // Read delayed samples
-    float tapL = readDelay(bufL_, writePosL_, delaySamples_);
-    float tapR = readDelay(bufR_, writePosR_, delaySamples_);
-
-    // Lowpass filter in feedback path
-    lpStateL_ += lpCoeff_ * (tapR - lpStateL_); // R feeds back to L
-    lpStateR_ += lpCoeff_ * (tapL - lpStateR_); // L feeds back to R
-
-    // Write: input + cross-feedback (ping-pong pattern)
-    // No self-feedback — only cross-feed for ping-pong effect
-    bufL_[writePosL_] = sanitize(inL + lpStateL_ * feedback_);
-    bufR_[writePosR_] = sanitize(inR + lpStateR_ * feedback_);
-
-    writePosL_ = (writePosL_ + 1) % maxDelaySamples_;
-    writePosR_ = (writePosR_ + 1) % maxDelaySamples_;
-
-    // Width: blend between mono delays and stereo ping-pong
-    float monoTap = (tapL + tapR) * 0.5f;
-    float widthL = monoTap * (1.0f - width_) + tapL * width_;
-    float widthR = monoTap * (1.0f - width_) + tapR * width_;
+    PingPongDelay::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
 
-    outL = sanitize(inL + widthL);
-    outR = sanitize(inR + widthR);
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    float *bufL = bufL_.data();
+    float *bufR = bufR_.data();
+    float stateL = lpStateL_;
+    float stateR = lpStateR_;
+    int writePosL = writePosL_;
+    int writePosR = writePosR_;
+    for (int i = 0; i < n; ++i) {
+      const float l = inL[i];
+      const float r = inR[i];
+
+      // Read delayed samples
+      float tapL = readDelay(bufL, writePosL, delaySamples_);
+      float tapR = readDelay(bufR, writePosR, delaySamples_);
+
+      // Lowpass filter in feedback path
+      stateL += lpCoeff_ * (tapR - stateL); // R feeds back to L
+      stateR += lpCoeff_ * (tapL - stateR); // L feeds back to R
+
+      // Write: input + cross-feedback (ping-pong pattern)
+      // No self-feedback — only cross-feed for ping-pong effect
+      bufL[writePosL] = sanitize(l + stateL * feedback_);
+      bufR[writePosR] = sanitize(r + stateR * feedback_);
+
+      if (++writePosL == maxDelaySamples_)
+        writePosL = 0;
+      if (++writePosR == maxDelaySamples_)
+        writePosR = 0;
+
+      // Width: blend between mono delays and stereo ping-pong
+      float monoTap = (tapL + tapR) * 0.5f;
+      float widthL = monoTap * (1.0f - width_) + tapL * width_;
+      float widthR = monoTap * (1.0f - width_) + tapR * width_;
+
+      outL[i] = sanitize(l + widthL);
+      outR[i] = sanitize(r + widthR);
+    }
+    lpStateL_ = stateL;
+    lpStateR_ = stateR;
+    writePosL_ = writePosL;
+    writePosR_ = writePosR;
   }
 
   void reset() override {
@@ -87,8 +109,7 @@ public:
 private:
   static constexpr float kMaxDelaySec = 2.0f;
 
-  float readDelay(const std::vector<float> &buf, int writePos,
-                  float delaySamples) const {
+  float readDelay(const float *buf, int writePos, float delaySamples) const {
     float pos = static_cast<float>(writePos) - delaySamples;
     if (pos < 0.0f)
       pos += maxDelaySamples_;
@@ -63,8 +63,52 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    float monoIn = (inL + inR) * 0.5f;
+    PlateReverb::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
+
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    // Mix using base class getMix()
+    const float mix = getMix();
+    for (int i = 0; i < n; ++i) {
+      const float l = inL[i];
+      const float r = inR[i];
+      float reverbL, reverbR;
+      tick((l + r) * 0.5f, reverbL, reverbR);
+      outL[i] = l * (1.0f - mix) + reverbL * mix;
+      outR[i] = r * (1.0f - mix) + reverbR * mix;
+    }
+  }
+
+  void reset() override {
+    auto clearBuf = [](std::vector<float> &b) {
+      std::fill(b.begin(), b.end(), 0.0f);
+    };
+    clearBuf(preDelay_);
+    clearBuf(inAP1_);
+    clearBuf(inAP2_);
+    clearBuf(inAP3_);
+    clearBuf(inAP4_);
+    clearBuf(tankAP1_);
+    clearBuf(tankDelay1_);
+    clearBuf(tankAP2_);
+    clearBuf(tankDelay2_);
+    clearBuf(tankAP3_);
+    clearBuf(tankDelay3_);
+    clearBuf(tankAP4_);
+    clearBuf(tankDelay4_);
+    damp1State_ = 0.0f;
+    damp2State_ = 0.0f;
+    tank2Out_ = 0.0f;
+    lfoPhase_ = 0.0f;
+    resetPositions();
+  }
+
+  const char *getName() const override { return "Reverb"; }
 
+private:
+  // One sample through the plate: mono input -> scaled wet taps
+  void tick(float monoIn, float &reverbL, float &reverbR) {
     // Pre-delay
     float preDelayed = readBuf(preDelay_, preDelayPos_, preDelaySamples_);
     writeBuf(preDelay_, preDelayPos_, monoIn);
@@ -110,54 +154,22 @@ public:
                         static_cast<int>(tankDelay4_.size()) - 1);
 
     // Tap outputs from multiple points for rich stereo
-    float reverbL = tapOutput(tankDelay1_, tankDelay1Pos_, 0.35f) +
-                    tapOutput(tankDelay1_, tankDelay1Pos_, 0.78f) -
-                    tapOutput(tankAP2_, tankAP2Pos_, 0.5f) +
-                    tapOutput(tankDelay3_, tankDelay3Pos_, 0.62f) -
-                    tapOutput(tankDelay4_, tankDelay4Pos_, 0.45f);
-
-    float reverbR = tapOutput(tankDelay3_, tankDelay3Pos_, 0.38f) +
-                    tapOutput(tankDelay3_, tankDelay3Pos_, 0.73f) -
-                    tapOutput(tankAP4_, tankAP4Pos_, 0.5f) +
-                    tapOutput(tankDelay1_, tankDelay1Pos_, 0.58f) -
-                    tapOutput(tankDelay2_, tankDelay2Pos_, 0.42f);
+    reverbL = tapOutput(tankDelay1_, tankDelay1Pos_, 0.35f) +
+              tapOutput(tankDelay1_, tankDelay1Pos_, 0.78f) -
+              tapOutput(tankAP2_, tankAP2Pos_, 0.5f) +
+              tapOutput(tankDelay3_, tankDelay3Pos_, 0.62f) -
+              tapOutput(tankDelay4_, tankDelay4Pos_, 0.45f);
+
+    reverbR = tapOutput(tankDelay3_, tankDelay3Pos_, 0.38f) +
+              tapOutput(tankDelay3_, tankDelay3Pos_, 0.73f) -
+              tapOutput(tankAP4_, tankAP4Pos_, 0.5f) +
+              tapOutput(tankDelay1_, tankDelay1Pos_, 0.58f) -
+              tapOutput(tankDelay2_, tankDelay2Pos_, 0.42f);
 
     reverbL *= 0.3f; // Scale to reasonable level
     reverbR *= 0.3f;
-
-    // Mix using base class getMix()
-    float mix = getMix();
-    outL = inL * (1.0f - mix) + reverbL * mix;
-    outR = inR * (1.0f - mix) + reverbR * mix;
-  }
-
-  void reset() override {
-    auto clearBuf = [](std::vector<float> &b) {
-      std::fill(b.begin(), b.end(), 0.0f);
-    };
-    clearBuf(preDelay_);
-    clearBuf(inAP1_);
-    clearBuf(inAP2_);
-    clearBuf(inAP3_);
-    clearBuf(inAP4_);
-    clearBuf(tankAP1_);
-    clearBuf(tankDelay1_);
-    clearBuf(tankAP2_);
-    clearBuf(tankDelay2_);
-    clearBuf(tankAP3_);
-    clearBuf(tankDelay3_);
-    clearBuf(tankAP4_);
-    clearBuf(tankDelay4_);
-    damp1State_ = 0.0f;
-    damp2State_ = 0.0f;
-    tank2Out_ = 0.0f;
-    lfoPhase_ = 0.0f;
-    resetPositions();
   }
 
-  const char *getName() const override { return "Reverb"; }
-
-private:
   void resetPositions() {
     preDelayPos_ = 0;
     inAP1Pos_ = 0;
@@ -48,6 +48,34 @@ public:
   void setShimmer(float s) { shimmer_ = std::max(0.0f, std::min(1.0f, s)); }
 
   void process(float inL, float inR, float &outL, float &outR) override {
+    ShimmerReverb::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
+
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    for (int i = 0; i < n; ++i)
+      tick((inL[i] + inR[i]) * 0.5f, outL[i], outR[i]);
+  }
+
+  void reset() override {
+    for (int i = 0; i < kChannels; ++i) {
+      std::fill(delay_[i].begin(), delay_[i].end(), 0.0f);
+      delayPos_[i] = 0;
+      dampState_[i] = 0.0f;
+    }
+    std::fill(pitchBufL_.begin(), pitchBufL_.end(), 0.0f);
+    std::fill(pitchBufR_.begin(), pitchBufR_.end(), 0.0f);
+    pitchWritePos_ = 0;
+    pitchReadPhase_ = 0.0;
+  }
+
+  const char *getName() const override { return "Shimmer"; }
+
+private:
+  static constexpr int kChannels = 4;
+
+  // One sample through the FDN: mono input -> wet output taps
+  void tick(float monoIn, float &outL, float &outR) {
     // Read from FDN delay lines
     float tap[kChannels];
     for (int i = 0; i < kChannels; ++i) {
@@ -69,7 +97,6 @@ public:
     float shiftedR = pitchShiftRead(pitchBufR_);
 
     // Blend shimmer into feedback (shimmer amount controls ratio)
-    float monoIn = (inL + inR) * 0.5f;
     float fbL = mixed[0] + mixed[1];
     float fbR = mixed[2] + mixed[3];
 
@@ -98,23 +125,6 @@ public:
     outR = sanitize(fbR * 0.4f);
   }
 
-  void reset() override {
-    for (int i = 0; i < kChannels; ++i) {
-      std::fill(delay_[i].begin(), delay_[i].end(), 0.0f);
-      delayPos_[i] = 0;
-      dampState_[i] = 0.0f;
-    }
-    std::fill(pitchBufL_.begin(), pitchBufL_.end(), 0.0f);
-    std::fill(pitchBufR_.begin(), pitchBufR_.end(), 0.0f);
-    pitchWritePos_ = 0;
-    pitchReadPhase_ = 0.0;
-  }
-
-  const char *getName() const override { return "Shimmer"; }
-
-private:
-  static constexpr int kChannels = 4;
-
   // Granular pitch shift read: read at 2x speed with crossfade window
   float pitchShiftRead(const std::vector<float> &buf) const {
     int len = pitchBufLen_;
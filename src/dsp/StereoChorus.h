@@ -30,26 +30,42 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    float lfoL = triangleLfo(lfoPhaseL_);
-    float lfoR = triangleLfo(lfoPhaseR_);
-    float centerDelay = sr_ * 0.007f;
-    float modRange = sr_ * 0.003f * depth_;
-    float delayL = centerDelay + lfoL * modRange;
-    float delayR = centerDelay + lfoR * modRange;
-    float wetL = readDelay(delayBufL_, delayL);
-    float wetR = readDelay(delayBufR_, delayR);
-    delayBufL_[writePos_] = sanitize(inL);
-    delayBufR_[writePos_] = sanitize(inR);
-    writePos_ = (writePos_ + 1) % kMaxDelay;
-    lfoPhaseL_ += lfoInc_;
-    if (lfoPhaseL_ >= 1.0f)
-      lfoPhaseL_ -= 1.0f;
-    lfoPhaseR_ += lfoInc_;
-    if (lfoPhaseR_ >= 1.0f)
-      lfoPhaseR_ -= 1.0f;
-    float mix = getMix();
-    outL = inL * (1.0f - mix) + wetL * mix;
-    outR = inR * (1.0f - mix) + wetR * mix;
+    StereoChorus::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
+
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    const float centerDelay = sr_ * 0.007f;
+    const float modRange = sr_ * 0.003f * depth_;
+    const float mix = getMix();
+    float *bufL = delayBufL_.data();
+    float *bufR = delayBufR_.data();
+    float phaseL = lfoPhaseL_;
+    float phaseR = lfoPhaseR_;
+    int writePos = writePos_;
+    for (int i = 0; i < n; ++i) {
+      const float l = inL[i];
+      const float r = inR[i];
+      float delayL = centerDelay + triangleLfo(phaseL) * modRange;
+      float delayR = centerDelay + triangleLfo(phaseR) * modRange;
+      float wetL = readDelay(bufL, writePos, delayL);
+      float wetR = readDelay(bufR, writePos, delayR);
+      bufL[writePos] = sanitize(l);
+      bufR[writePos] = sanitize(r);
+      if (++writePos == kMaxDelay)
+        writePos = 0;
+      phaseL += lfoInc_;
+      if (phaseL >= 1.0f)
+        phaseL -= 1.0f;
+      phaseR += lfoInc_;
+      if (phaseR >= 1.0f)
+        phaseR -= 1.0f;
+      outL[i] = l * (1.0f - mix) + wetL * mix;
+      outR[i] = r * (1.0f - mix) + wetR * mix;
+    }
+    lfoPhaseL_ = phaseL;
+    lfoPhaseR_ = phaseR;
+    writePos_ = writePos;
   }
 
   void reset() override {
@@ -65,7 +81,7 @@ public:
 private:
   static constexpr int kMaxDelay = 2048;
 
-  float triangleLfo(float phase) const {
+  static float triangleLfo(float phase) {
     float t = phase * 4.0f;
     if (t < 1.0f)
       return t;
@@ -74,8 +90,8 @@ private:
     return t - 4.0f;
   }
 
-  float readDelay(const std::vector<float> &buf, float delaySamples) const {
-    float pos = static_cast<float>(writePos_) - delaySamples;
+  static float readDelay(const float *buf, int writePos, float delaySamples) {
+    float pos = static_cast<float>(writePos) - delaySamples;
     if (pos < 0.0f)
       pos += kMaxDelay;
     int i0 = static_cast<int>(pos);
@@ -38,14 +38,28 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    float wetL = readDelay(bufL_, delaySamples_);
-    float wetR = readDelay(bufR_, delaySamples_);
-    bufL_[writePos_] = sanitize(inL);
-    bufR_[writePos_] = sanitize(inR);
-    writePos_ = (writePos_ + 1) % maxDelaySamples_;
-    float mix = getMix();
-    outL = inL * (1.0f - mix) + wetL * mix;
-    outR = inR * (1.0f - mix) + wetR * mix;
+    StereoDelay::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
+
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    const float mix = getMix();
+    float *bufL = bufL_.data();
+    float *bufR = bufR_.data();
+    int writePos = writePos_;
+    for (int i = 0; i < n; ++i) {
+      const float l = inL[i];
+      const float r = inR[i];
+      float wetL = readDelay(bufL, writePos, delaySamples_);
+      float wetR = readDelay(bufR, writePos, delaySamples_);
+      bufL[writePos] = sanitize(l);
+      bufR[writePos] = sanitize(r);
+      if (++writePos == maxDelaySamples_)
+        writePos = 0;
+      outL[i] = l * (1.0f - mix) + wetL * mix;
+      outR[i] = r * (1.0f - mix) + wetR * mix;
+    }
+    writePos_ = writePos;
   }
 
   void reset() override {
@@ -69,8 +83,8 @@ private:
     }
   }
 
-  float readDelay(const std::vector<float> &buf, float delaySamples) const {
-    float pos = static_cast<float>(writePos_) - delaySamples;
+  float readDelay(const float *buf, int writePos, float delaySamples) const {
+    float pos = static_cast<float>(writePos) - delaySamples;
     if (pos < 0.0f)
       pos += maxDelaySamples_;
     int i0 = static_cast<int>(pos);
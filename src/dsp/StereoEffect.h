@@ -10,6 +10,15 @@ public:
 
   virtual void init(float sampleRate) = 0;
   virtual void process(float inL, float inR, float &outL, float &outR) = 0;
+
+  // Process n samples; same result as calling process() per sample.
+  // outL/outR may alias inL/inR (in-place). Effects override this with a
+  // native loop (no virtual call per sample, per-block constants hoisted).
+  virtual void processBlock(const float *inL, const float *inR, float *outL,
+                            float *outR, int n) {
+    for (int i = 0; i < n; ++i)
+      process(inL[i], inR[i], outL[i], outR[i]);
+  }
   virtual void reset() = 0;
   virtual const char *getName() const = 0;
 
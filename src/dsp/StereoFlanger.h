@@ -31,33 +31,50 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    // LFO: triangle wave, stereo offset for width
-    float lfoL = triangleLfo(lfoPhase_);
-    float lfoR = triangleLfo(lfoPhase_ + 0.5f);
-    lfoPhase_ += lfoInc_;
-    if (lfoPhase_ >= 1.0f)
-      lfoPhase_ -= 1.0f;
+    StereoFlanger::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
 
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
     // Modulated delay time: 0.1ms to 5ms
-    float minDelay = sr_ * 0.0001f; // 0.1ms
-    float maxDelay = sr_ * 0.005f;  // 5ms
-    float range = (maxDelay - minDelay) * depth_;
-    float delayL = minDelay + range * (0.5f + 0.5f * lfoL);
-    float delayR = minDelay + range * (0.5f + 0.5f * lfoR);
-
-    // Read from delay with interpolation
-    float wetL = readDelay(bufL_, delayL);
-    float wetR = readDelay(bufR_, delayR);
-
-    // Write to delay (input only, no feedback recirculation for continuous
-    // input)
-    bufL_[writePos_] = sanitize(inL);
-    bufR_[writePos_] = sanitize(inR);
-    writePos_ = (writePos_ + 1) % maxDelaySamples_;
-
-    // Output: direct + delayed creates comb filter effect
-    outL = sanitize(inL + wetL);
-    outR = sanitize(inR + wetR);
+    const float minDelay = sr_ * 0.0001f; // 0.1ms
+    const float maxDelay = sr_ * 0.005f;  // 5ms
+    const float range = (maxDelay - minDelay) * depth_;
+    float *bufL = bufL_.data();
+    float *bufR = bufR_.data();
+    float phase = lfoPhase_;
+    int writePos = writePos_;
+    for (int i = 0; i < n; ++i) {
+      const float l = inL[i];
+      const float r = inR[i];
+
+      // LFO: triangle wave, stereo offset for width
+      float lfoL = triangleLfo(phase);
+      float lfoR = triangleLfo(phase + 0.5f);
+      phase += lfoInc_;
+      if (phase >= 1.0f)
+        phase -= 1.0f;
+
+      float delayL = minDelay + range * (0.5f + 0.5f * lfoL);
+      float delayR = minDelay + range * (0.5f + 0.5f * lfoR);
+
+      // Read from delay with interpolation
+      float wetL = readDelay(bufL, writePos, delayL);
+      float wetR = readDelay(bufR, writePos, delayR);
+
+      // Write to delay (input only, no feedback recirculation for
+      // continuous input)
+      bufL[writePos] = sanitize(l);
+      bufR[writePos] = sanitize(r);
+      if (++writePos == maxDelaySamples_)
+        writePos = 0;
+
+      // Output: direct + delayed creates comb filter effect
+      outL[i] = sanitize(l + wetL);
+      outR[i] = sanitize(r + wetR);
+    }
+    lfoPhase_ = phase;
+    writePos_ = writePos;
   }
 
   void reset() override {
@@ -72,7 +89,7 @@ public:
 private:
   static constexpr float kMaxDelaySec = 0.01f; // 10ms max
 
-  float triangleLfo(float phase) const {
+  static float triangleLfo(float phase) {
     float p = phase - std::floor(phase); // Wrap to 0..1
     float t = p * 4.0f;
     if (t < 1.0f)
@@ -82,8 +99,8 @@ private:
     return t - 4.0f;
   }
 
-  float readDelay(const std::vector<float> &buf, float delaySamples) const {
-    float pos = static_cast<float>(writePos_) - delaySamples;
+  float readDelay(const float *buf, int writePos, float delaySamples) const {
+    float pos = static_cast<float>(writePos) - delaySamples;
     if (pos < 0.0f)
       pos += maxDelaySamples_;
     int i0 = static_cast<int>(pos);
@@ -33,37 +33,56 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    // LFO: sine wave, stereo offset
-    float lfo = std::sin(lfoPhase_ * 6.283185307f);
-    float lfoR = std::sin((lfoPhase_ + 0.25f) * 6.283185307f);
-    lfoPhase_ += lfoInc_;
-    if (lfoPhase_ >= 1.0f)
-      lfoPhase_ -= 1.0f;
-
-    // Map LFO to allpass coefficient range (200Hz - 4kHz)
-    float minFreq = 200.0f;
-    float maxFreq = std::min(4000.0f, sr_ * 0.45f);
-    float freqL = minFreq + (maxFreq - minFreq) * (0.5f + 0.5f * lfo * depth_);
-    float freqR = minFreq + (maxFreq - minFreq) * (0.5f + 0.5f * lfoR * depth_);
-    float coeffL = allpassCoeff(freqL);
-    float coeffR = allpassCoeff(freqR);
-
-    // Feed input + feedback from last output
-    float xL = sanitize(inL + lastOutL_ * feedback_);
-    float xR = sanitize(inR + lastOutR_ * feedback_);
-
-    // 4-stage allpass cascade
-    for (int i = 0; i < kStages; ++i) {
-      xL = allpassProcess(xL, apStateL_[i], coeffL);
-      xR = allpassProcess(xR, apStateR_[i], coeffR);
-    }
+    StereoPhaser::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
+
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    // Allpass sweep range (200Hz - 4kHz)
+    const float minFreq = 200.0f;
+    const float maxFreq = std::min(4000.0f, sr_ * 0.45f);
+    float phase = lfoPhase_;
+    float lastL = lastOutL_;
+    float lastR = lastOutR_;
+    for (int i = 0; i < n; ++i) {
+      const float l = inL[i];
+      const float r = inR[i];
+
+      // LFO: sine wave, stereo offset
+      float lfo = std::sin(phase * 6.283185307f);
+      float lfoR = std::sin((phase + 0.25f) * 6.283185307f);
+      phase += lfoInc_;
+      if (phase >= 1.0f)
+        phase -= 1.0f;
 
-    lastOutL_ = xL;
-    lastOutR_ = xR;
+      // Map LFO to allpass coefficient
+      float freqL =
+          minFreq + (maxFreq - minFreq) * (0.5f + 0.5f * lfo * depth_);
+      float freqR =
+          minFreq + (maxFreq - minFreq) * (0.5f + 0.5f * lfoR * depth_);
+      float coeffL = allpassCoeff(freqL);
+      float coeffR = allpassCoeff(freqR);
 
-    // Output: notch-style interference pattern
-    outL = sanitize(inL + xL);
-    outR = sanitize(inR + xR);
+      // Feed input + feedback from last output
+      float xL = sanitize(l + lastL * feedback_);
+      float xR = sanitize(r + lastR * feedback_);
+
+      // 4-stage allpass cascade
+      for (int s = 0; s < kStages; ++s) {
+        xL = allpassProcess(xL, apStateL_[s], coeffL);
+        xR = allpassProcess(xR, apStateR_[s], coeffR);
+      }
+
+      lastL = xL;
+      lastR = xR;
+
+      // Output: notch-style interference pattern
+      outL[i] = sanitize(l + xL);
+      outR[i] = sanitize(r + xR);
+    }
+    lfoPhase_ = phase;
+    lastOutL_ = lastL;
+    lastOutR_ = lastR;
   }
 
   void reset() override {
@@ -30,25 +30,33 @@ public:
   }
 
   void process(float inL, float inR, float &outL, float &outR) override {
-    // Apply drive (gain + waveshaper)
-    float gainDb = drive_ * 24.0f; // Up to 24dB of drive
-    float gain = std::pow(10.0f, gainDb / 20.0f);
-    float xL = inL * gain;
-    float xR = inR * gain;
-
-    // Soft clipping: tanh approximation (Pade 3/2)
-    xL = tanhApprox(xL);
-    xR = tanhApprox(xR);
-
-    // One-pole lowpass for tape warmth
-    lpStateL_ += lpCoeff_ * (xL - lpStateL_);
-    lpStateR_ += lpCoeff_ * (xR - lpStateR_);
+    TapeSaturation::processBlock(&inL, &inR, &outL, &outR, 1);
+  }
 
+  void processBlock(const float *inL, const float *inR, float *outL,
+                    float *outR, int n) override {
+    // Apply drive (gain + waveshaper)
+    const float gainDb = drive_ * 24.0f; // Up to 24dB of drive
+    const float gain = std::pow(10.0f, gainDb / 20.0f);
     // Compensate output level (drive adds gain, waveshaper reduces it
     // partially)
-    float compensation = 1.0f / std::max(1.0f, gain * 0.5f);
-    outL = sanitize(lpStateL_ * compensation);
-    outR = sanitize(lpStateR_ * compensation);
+    const float compensation = 1.0f / std::max(1.0f, gain * 0.5f);
+    float stateL = lpStateL_;
+    float stateR = lpStateR_;
+    for (int i = 0; i < n; ++i) {
+      // Soft clipping: tanh approximation (Pade 3/2)
+      float xL = tanhApprox(inL[i] * gain);
+      float xR = tanhApprox(inR[i] * gain);
+
+      // One-pole lowpass for tape warmth
+      stateL += lpCoeff_ * (xL - stateL);
+      stateR += lpCoeff_ * (xR - stateR);
+
+      outL[i] = sanitize(stateL * compensation);
+      outR[i] = sanitize(stateR * compensation);
+    }
+    lpStateL_ = stateL;
+    lpStateR_ = stateR;
   }
 
   void reset() override {
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "SynthVoice.h"
+#include <algorithm>
+
+/// Compact list of the voices that may be sounding, so per-block mixing
+/// and counting cost O(active voices) instead of scanning every slot.
+/// Voices join when they are started (add()) and leave in retire() once
+/// they report !isActive() (envelope finished or reset()).
+///
+/// Fixed capacity, no allocations. Audio thread only.
+class ActiveVoiceList {
+public:
+  static constexpr int kCapacity = 64;
+
+  /// Add a started voice. No-op if already listed (retrigger, steal).
+  void add(SynthVoice *voice) {
+    if (count == kCapacity || contains(voice))
+      return;
+    voices[count++] = voice;
+  }
+
+  bool contains(const SynthVoice *voice) const {
+    return std::find(voices, voices + count, voice) != voices + count;
+  }
+
+  /// Drop voices that are no longer active, keeping the order of the rest.
+  /// Returns the number removed.
+  int retire() {
+    SynthVoice **end = std::remove_if(
+        voices, voices + count,
+        [](const SynthVoice *voice) { return !voice->isActive(); });
+    const int removed = count - static_cast<int>(end - voices);
+    count -= removed;
+    return removed;
+  }
+
+  void clear() { count = 0; }
+
+  int size() const { return count; }
+  bool empty() const { return count == 0; }
+  SynthVoice *const *data() const { return voices; }
+  SynthVoice *operator[](int i) const { return voices[i]; }
+
+private:
+  SynthVoice *voices[kCapacity] = {};
+  int count = 0;
+};
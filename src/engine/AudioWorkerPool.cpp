@@ -0,0 +1,101 @@
+#include "AudioWorkerPool.h"
+#include <algorithm>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+AudioWorkerPool::AudioWorkerPool(int numWorkers) {
+  if (numWorkers < 0) {
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    numWorkers = std::min(kMaxDefaultWorkers, std::max(0, hw - 2));
+  }
+
+  workers.reserve(static_cast<size_t>(numWorkers));
+  for (int i = 0; i < numWorkers; ++i)
+    workers.emplace_back([this, i] { workerLoop(i + 1); });
+}
+
+AudioWorkerPool::~AudioWorkerPool() {
+  stopping.store(true, std::memory_order_release);
+  for (size_t i = 0; i < workers.size(); ++i)
+    wake.signal();
+  for (auto &t : workers)
+    t.join();
+}
+
+void AudioWorkerPool::dispatch(int numTasks, TaskFn fn, void *ctx) {
+  // The previous job finished (tasksRemaining reached 0) and late claims
+  // never touch jobFn / jobCtx, so they can be replaced here.
+  jobFn = fn;
+  jobCtx = ctx;
+  tasksRemaining.store(numTasks, std::memory_order_relaxed);
+  job.store(static_cast<uint64_t>(numTasks) << 32, std::memory_order_release);
+
+  const int helpers =
+      std::min(numTasks - 1, static_cast<int>(workers.size()));
+  for (int i = 0; i < helpers; ++i)
+    wake.signal();
+
+  drain(0);
+
+  // Wait for tasks still running on helpers: spin briefly, then yield so a
+  // helper sharing this core can finish.
+  for (int spins = 0;
+       tasksRemaining.load(std::memory_order_acquire) != 0; ++spins) {
+    if (spins >= 64)
+      std::this_thread::yield();
+  }
+}
+
+void AudioWorkerPool::drain(int thread) {
+  for (;;) {
+    const uint64_t claim = job.fetch_add(1, std::memory_order_acq_rel);
+    const uint32_t task = static_cast<uint32_t>(claim);
+    if (task >= static_cast<uint32_t>(claim >> 32))
+      return;
+    jobFn(jobCtx, static_cast<int>(task), thread);
+    tasksRemaining.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void AudioWorkerPool::workerLoop(int thread) {
+  if (setRealtimePriority())
+    realtimeWorkers.fetch_add(1, std::memory_order_relaxed);
+
+  for (;;) {
+    wake.wait();
+    if (stopping.load(std::memory_order_acquire))
+      return;
+    drain(thread);
+  }
+}
+
+bool AudioWorkerPool::setRealtimePriority() {
+#if defined(_WIN32)
+  // The audio thread waits on these workers, so run them at its level
+  return SetThreadPriority(GetCurrentThread(),
+                           THREAD_PRIORITY_TIME_CRITICAL) != 0;
+#elif defined(__APPLE__)
+  return pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0) == 0;
+#else
+  // SCHED_FIFO in the range audio threads typically use. Fails without
+  // CAP_SYS_NICE / rtprio limits; the thread then keeps the default policy.
+  sched_param param{};
+  param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO),
+                                  sched_get_priority_max(SCHED_FIFO) - 20);
+  return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#endif
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Semaphore.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// Persistent helper threads the audio thread can fan work out to.
+///
+/// Unlike WorkerPool, run() takes no locks and never blocks on a condition
+/// variable: the job is published with one atomic store, sleeping workers
+/// are woken through Semaphore (an atomic add, plus one non-blocking OS
+/// wake-up per sleeping worker), the caller drains tasks itself and then
+/// spins until the tasks claimed by workers are done. No allocation after
+/// the constructor.
+///
+/// Tasks are claimed one at a time from a shared counter, so a few uneven
+/// tasks (one per effect send) balance across threads. Meant for a single
+/// caller; a concurrent or recursive run() executes its tasks serially.
+class AudioWorkerPool {
+public:
+  /// @param numWorkers  Helper threads besides the caller. -1 picks
+  ///                    hardware_concurrency() - 2, at most kMaxDefaultWorkers;
+  ///                    0 runs everything on the caller.
+  explicit AudioWorkerPool(int numWorkers = -1);
+  ~AudioWorkerPool();
+
+  AudioWorkerPool(const AudioWorkerPool &) = delete;
+  AudioWorkerPool &operator=(const AudioWorkerPool &) = delete;
+
+  static constexpr int kMaxDefaultWorkers = 4;
+
+  /// Threads taking part in run(), including the caller (thread index 0).
+  int getNumThreads() const { return static_cast<int>(workers.size()) + 1; }
+
+  /// Whether the helper threads got real-time scheduling (all of them).
+  bool isRealtime() const { return realtimeWorkers.load() == workers.size(); }
+
+  /// Run fn(task, thread) for every task in [0, numTasks) and wait for all
+  /// to finish. `thread` is 0 on the caller, 1..getNumThreads()-1 on the
+  /// helpers. Tasks must write disjoint memory.
+  template <typename Fn> void run(int numTasks, Fn &&fn) {
+    if (numTasks <= 0)
+      return;
+    if (numTasks == 1 || workers.empty() ||
+        busy.exchange(true, std::memory_order_acquire)) {
+      for (int i = 0; i < numTasks; ++i)
+        fn(i, 0);
+      return;
+    }
+    using FnType = std::remove_reference_t<Fn>;
+    dispatch(numTasks,
+             [](void *ctx, int task, int thread) {
+               (*static_cast<FnType *>(ctx))(task, thread);
+             },
+             const_cast<void *>(static_cast<const void *>(&fn)));
+    busy.store(false, std::memory_order_release);
+  }
+
+private:
+  using TaskFn = void (*)(void *ctx, int task, int thread);
+
+  void dispatch(int numTasks, TaskFn fn, void *ctx);
+  /// Claim and run tasks until none are left.
+  void drain(int thread);
+  void workerLoop(int thread);
+  static bool setRealtimePriority();
+
+  std::vector<std::thread> workers;
+  Semaphore wake;
+
+  // Job: task count in the high 32 bits, next unclaimed task in the low 32.
+  // A claim below the count pins the job (it cannot finish, so jobFn/jobCtx
+  // stay valid); claims at or past it are late wake-ups and do nothing.
+  alignas(64) std::atomic<uint64_t> job{0};
+  alignas(64) std::atomic<int> tasksRemaining{0};
+  TaskFn jobFn = nullptr;
+  void *jobCtx = nullptr;
+
+  std::atomic<bool> busy{false};
+  std::atomic<bool> stopping{false};
+  std::atomic<size_t> realtimeWorkers{0};
+};
@@ -2,15 +2,30 @@
 
 #include <cstdint>
 #include <cstring>
+#include <utility>
 #include <vector>
 
 /// Bitwise-packed grid for binary-state cellular automata.
 /// Packs 64 cells per uint64_t word for SIMD-friendly neighbor counting.
-/// Layout: row-major, each row is ceil(cols/64) words.
+/// Layout: row-major, each row is ceil(cols/64) words. Bit b of word w holds
+/// column w * 64 + b. Bits past the last column are always kept zero.
 class BitwiseGrid {
 public:
+  /// Planes a bit-sliced multi-state cell can span (cyclic CA: 2^4 states).
+  static constexpr int kMaxStatePlanes = 4;
+
+  /// Per-cell neighbor counts for 64 cells, as 4 bit planes:
+  /// count = b0 + 2 * b1 + 4 * b2 + 8 * b3 (0-8).
+  struct NeighborSum {
+    uint64_t b0 = 0;
+    uint64_t b1 = 0;
+    uint64_t b2 = 0;
+    uint64_t b3 = 0;
+  };
+
   BitwiseGrid() = default;
 
+  /// Allocates storage. Only call outside step() (constructor / reset).
   void resize(int rows, int cols) {
     rows_ = rows;
     cols_ = cols;
@@ -26,6 +41,14 @@ public:
     std::memset(data_.data(), 0, data_.size() * sizeof(uint64_t));
   }
 
+  /// Swap storage with another grid (pointer swap, no allocation).
+  void swap(BitwiseGrid &other) noexcept {
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(wordsPerRow_, other.wordsPerRow_);
+    data_.swap(other.data_);
+  }
+
   bool getCell(int r, int c) const {
     int wordIdx = c / 64;
     int bitIdx = c % 64;
@@ -51,100 +74,251 @@ public:
     return &data_[static_cast<size_t>(r) * wordsPerRow_];
   }
 
-  /// Count live neighbors for all 64 cells in a word at once.
-  /// Returns an array of 8 bytes, each containing the neighbor count (0-8)
-  /// for 8 cells. This uses shift-and-add across the 3 rows.
-  ///
-  /// For a given word position w in a row, the neighbors come from:
-  /// - Same row: word shifted left 1, word shifted right 1
-  /// - Row above and below: word, word shifted left 1, word shifted right 1
-  ///
-  /// Rather than popcount per-cell, we use bit-parallel addition:
-  /// Add 8 shifted versions of the 3 rows bit by bit to get a 4-bit
-  /// count per cell position using carry-chain addition.
-  static void countNeighbors64(const uint64_t *rowAbove,
-                               const uint64_t *rowSame,
-                               const uint64_t *rowBelow, int wordIdx,
-                               int wordsPerRow, int cols, uint8_t counts[64]) {
-    // Get the 3x3 neighborhood words, handling word-boundary shifts
-    auto getShiftedLeft = [&](const uint64_t *row) -> uint64_t {
-      uint64_t cur = row[wordIdx];
-      uint64_t right = (wordIdx + 1 < wordsPerRow) ? row[wordIdx + 1] : 0ULL;
-      return (cur >> 1) | (right << 63);
-    };
-
-    auto getShiftedRight = [&](const uint64_t *row) -> uint64_t {
-      uint64_t cur = row[wordIdx];
-      uint64_t left = (wordIdx > 0) ? row[wordIdx - 1] : 0ULL;
-      return (cur << 1) | (left >> 63);
-    };
-
-    // 8 neighbor bit planes
-    uint64_t n0 = getShiftedLeft(rowAbove);
-    uint64_t n1 = rowAbove[wordIdx]; // directly above
-    uint64_t n2 = getShiftedRight(rowAbove);
-    uint64_t n3 = getShiftedLeft(rowSame);
-    // n4 = self (skip)
-    uint64_t n4 = getShiftedRight(rowSame);
-    uint64_t n5 = getShiftedLeft(rowBelow);
-    uint64_t n6 = rowBelow[wordIdx]; // directly below
-    uint64_t n7 = getShiftedRight(rowBelow);
-
-    // Bit-parallel addition: add 8 values using carry chains
-    // Sum 8 bits per position into a 4-bit count (0-8)
-    // Using full adder chains:
-    // Stage 1: pair-wise half adders (4 pairs -> 4 sums, 4 carries)
-    uint64_t s01 = n0 ^ n1;
-    uint64_t c01 = n0 & n1;
-    uint64_t s23 = n2 ^ n3;
-    uint64_t c23 = n2 & n3;
-    uint64_t s45 = n4 ^ n5;
-    uint64_t c45 = n4 & n5;
-    uint64_t s67 = n6 ^ n7;
-    uint64_t c67 = n6 & n7;
-
-    // Stage 2: add sums pair-wise
-    uint64_t s0123 = s01 ^ s23;
-    uint64_t c_s0123 = s01 & s23;
-    uint64_t s4567 = s45 ^ s67;
-    uint64_t c_s4567 = s45 & s67;
-
-    // Stage 2 carries: combine original carries
-    uint64_t carry2a = c01 ^ c23;
-    uint64_t carry2a_c = c01 & c23;
-    uint64_t carry2b = c45 ^ c67;
-    uint64_t carry2b_c = c45 & c67;
-
-    // Stage 3: add the two 2-bit sums
-    uint64_t bit0 = s0123 ^ s4567; // LSB of count
-    uint64_t gen3 = s0123 & s4567;
-
-    // Bit 1: carry2a + carry2b + c_s0123 + c_s4567 + gen3
-    // This is getting complex. Let's just extract per-cell for reliability.
-    // The bit-parallel approach is error-prone for 8-input addition.
-    // Instead, use a simpler per-cell popcount approach that's still fast.
-
-    // Mask off bits beyond cols for the last word
-    int bitsInWord = cols - wordIdx * 64;
-    if (bitsInWord > 64)
-      bitsInWord = 64;
-
-    // Simple but fast: extract each bit position
-    uint64_t sum = n0 + n1; // This doesn't work for bit-parallel...
-
-    // Fall back to per-bit extraction — still 64 cells per call
-    for (int b = 0; b < bitsInWord; ++b) {
-      counts[b] = static_cast<uint8_t>(((n0 >> b) & 1) + ((n1 >> b) & 1) +
-                                       ((n2 >> b) & 1) + ((n3 >> b) & 1) +
-                                       ((n4 >> b) & 1) + ((n5 >> b) & 1) +
-                                       ((n6 >> b) & 1) + ((n7 >> b) & 1));
+  /// Valid-bit mask for the last word of each row.
+  static uint64_t lastWordMask(int cols) {
+    int bits = cols - ((cols - 1) / 64) * 64;
+    return (bits == 64) ? ~0ULL : ((1ULL << bits) - 1ULL);
+  }
+
+  /// Word w of a row shifted so each bit holds its WEST neighbor (col - 1),
+  /// with toroidal wrap from the last column into column 0.
+  static uint64_t westNeighbors(const uint64_t *row, int w, int wordsPerRow,
+                                int cols) {
+    uint64_t carry;
+    if (w > 0) {
+      carry = row[w - 1] >> 63;
+    } else {
+      const int lastBit = (cols - 1) & 63;
+      carry = (row[wordsPerRow - 1] >> lastBit) & 1ULL;
+    }
+    uint64_t shifted = (row[w] << 1) | carry;
+    return (w == wordsPerRow - 1) ? (shifted & lastWordMask(cols)) : shifted;
+  }
+
+  /// Word w of a row shifted so each bit holds its EAST neighbor (col + 1),
+  /// with toroidal wrap from column 0 into the last column.
+  static uint64_t eastNeighbors(const uint64_t *row, int w, int wordsPerRow,
+                                int cols) {
+    if (w + 1 < wordsPerRow)
+      return (row[w] >> 1) | (row[w + 1] << 63);
+    const int lastBit = (cols - 1) & 63;
+    return (row[w] >> 1) | ((row[0] & 1ULL) << lastBit);
+  }
+
+  /// Count live Moore neighbors for all 64 cells of word wordIdx at once.
+  /// Carry-save adder tree over the 8 neighbor bit planes; no per-bit work.
+  /// Rows are toroidal in columns (callers pick the wrapped rows above/below).
+  static NeighborSum countNeighbors64(const uint64_t *rowAbove,
+                                      const uint64_t *rowSame,
+                                      const uint64_t *rowBelow, int wordIdx,
+                                      int wordsPerRow, int cols) {
+    const int w = wordIdx;
+    const uint64_t n0 = westNeighbors(rowAbove, w, wordsPerRow, cols);
+    const uint64_t n1 = rowAbove[w];
+    const uint64_t n2 = eastNeighbors(rowAbove, w, wordsPerRow, cols);
+    const uint64_t n3 = westNeighbors(rowSame, w, wordsPerRow, cols);
+    const uint64_t n4 = eastNeighbors(rowSame, w, wordsPerRow, cols);
+    const uint64_t n5 = westNeighbors(rowBelow, w, wordsPerRow, cols);
+    const uint64_t n6 = rowBelow[w];
+    const uint64_t n7 = eastNeighbors(rowBelow, w, wordsPerRow, cols);
+    return addNeighborPlanes(n0, n1, n2, n3, n4, n5, n6, n7);
+  }
+
+  /// Sum 8 one-bit planes into a 4-bit count per bit position.
+  static NeighborSum addNeighborPlanes(uint64_t n0, uint64_t n1, uint64_t n2,
+                                       uint64_t n3, uint64_t n4, uint64_t n5,
+                                       uint64_t n6, uint64_t n7) {
+    // Weight 1: two full adders + one half adder
+    uint64_t sA, cA, sB, cB;
+    fullAdd(n0, n1, n2, sA, cA);
+    fullAdd(n3, n4, n5, sB, cB);
+    const uint64_t sC = n6 ^ n7;
+    const uint64_t cC = n6 & n7;
+
+    NeighborSum sum;
+    uint64_t cD;
+    fullAdd(sA, sB, sC, sum.b0, cD);
+
+    // Weight 2: four carries (cA, cB, cC, cD)
+    uint64_t t1, t2;
+    fullAdd(cA, cB, cC, t1, t2);
+    sum.b1 = t1 ^ cD;
+    const uint64_t t3 = t1 & cD;
+
+    // Weight 4: two carries (t2, t3)
+    sum.b2 = t2 ^ t3;
+    sum.b3 = t2 & t3;
+    return sum;
+  }
+
+  /// Bit mask of cells whose neighbor count is any N with bit N set in
+  /// ruleMask (Birth/Survival bitmask, bits 0-8).
+  static uint64_t matchRule(const NeighborSum &s, uint16_t ruleMask) {
+    uint64_t result = 0;
+    for (int n = 0; n <= 8; ++n) {
+      if (ruleMask & (1u << n))
+        result |= countEquals(s, n);
+    }
+    return result;
+  }
+
+  /// Bit mask of cells whose neighbor count equals n exactly.
+  static uint64_t countEquals(const NeighborSum &s, int n) {
+    const uint64_t m0 = (n & 1) ? s.b0 : ~s.b0;
+    const uint64_t m1 = (n & 2) ? s.b1 : ~s.b1;
+    const uint64_t m2 = (n & 4) ? s.b2 : ~s.b2;
+    const uint64_t m3 = (n & 8) ? s.b3 : ~s.b3;
+    return m0 & m1 & m2 & m3;
+  }
+
+  /// Next state of word w under a Life-like (B/S) rule.
+  static uint64_t lifeWord(const uint64_t *rowAbove, const uint64_t *rowSame,
+                           const uint64_t *rowBelow, int w, int wordsPerRow,
+                           int cols, uint16_t birthRule,
+                           uint16_t survivalRule) {
+    const NeighborSum s =
+        countNeighbors64(rowAbove, rowSame, rowBelow, w, wordsPerRow, cols);
+    const uint64_t self = rowSame[w];
+    return (~self & matchRule(s, birthRule)) |
+           (self & matchRule(s, survivalRule));
+  }
+
+  /// Brian's Brain births for word w: Off cells (neither On nor Dying) with
+  /// exactly 2 On neighbors. Rows are On planes; dyingSame is the Dying plane.
+  static uint64_t brainBirthWord(const uint64_t *onAbove,
+                                 const uint64_t *onSame,
+                                 const uint64_t *onBelow,
+                                 const uint64_t *dyingSame, int w,
+                                 int wordsPerRow, int cols) {
+    const NeighborSum s =
+        countNeighbors64(onAbove, onSame, onBelow, w, wordsPerRow, cols);
+    return ~(onSame[w] | dyingSame[w]) & countEquals(s, 2);
+  }
+
+  /// Advance one row of a Life-like (B/S) rule, 64 cells per word.
+  static void stepLifeRow(const uint64_t *rowAbove, const uint64_t *rowSame,
+                          const uint64_t *rowBelow, uint64_t *out,
+                          int wordsPerRow, int cols, uint16_t birthRule,
+                          uint16_t survivalRule) {
+    stepLifeWords(rowAbove, rowSame, rowBelow, out, 0, wordsPerRow,
+                  wordsPerRow, cols, birthRule, survivalRule);
+  }
+
+  /// Same, for words [wordBegin, wordEnd) of the row only.
+  static void stepLifeWords(const uint64_t *rowAbove, const uint64_t *rowSame,
+                            const uint64_t *rowBelow, uint64_t *out,
+                            int wordBegin, int wordEnd, int wordsPerRow,
+                            int cols, uint16_t birthRule,
+                            uint16_t survivalRule) {
+    for (int w = wordBegin; w < wordEnd; ++w)
+      out[w] = lifeWord(rowAbove, rowSame, rowBelow, w, wordsPerRow, cols,
+                        birthRule, survivalRule);
+    if (wordEnd == wordsPerRow)
+      out[wordsPerRow - 1] &= lastWordMask(cols);
+  }
+
+  /// Advance one row of Brian's Brain held as two bit planes.
+  /// On -> Dying, Dying -> Off, Off -> On with exactly 2 On neighbors.
+  static void stepBrainRow(const uint64_t *onAbove, const uint64_t *onSame,
+                           const uint64_t *onBelow, const uint64_t *dyingSame,
+                           uint64_t *onOut, uint64_t *dyingOut,
+                           int wordsPerRow, int cols) {
+    stepBrainWords(onAbove, onSame, onBelow, dyingSame, onOut, dyingOut, 0,
+                   wordsPerRow, wordsPerRow, cols);
+  }
+
+  /// Same, for words [wordBegin, wordEnd) of the row only.
+  static void stepBrainWords(const uint64_t *onAbove, const uint64_t *onSame,
+                             const uint64_t *onBelow,
+                             const uint64_t *dyingSame, uint64_t *onOut,
+                             uint64_t *dyingOut, int wordBegin, int wordEnd,
+                             int wordsPerRow, int cols) {
+    for (int w = wordBegin; w < wordEnd; ++w) {
+      onOut[w] = brainBirthWord(onAbove, onSame, onBelow, dyingSame, w,
+                                wordsPerRow, cols);
+      dyingOut[w] = onSame[w];
     }
-    for (int b = bitsInWord; b < 64; ++b) {
-      counts[b] = 0;
+    if (wordEnd == wordsPerRow)
+      onOut[wordsPerRow - 1] &= lastWordMask(cols);
+  }
+
+  /// Successor states (state + 1) % numStates of 64 bit-sliced cells:
+  /// state = sum of ((plane[i] >> b) & 1) << i. A binary increment across
+  /// the planes, with the last state wrapping to 0.
+  static void cyclicSuccessor(const uint64_t *self, int numPlanes,
+                              int numStates, uint64_t *succ) {
+    uint64_t carry = ~0ULL;
+    uint64_t last = ~0ULL;
+    for (int i = 0; i < numPlanes; ++i) {
+      succ[i] = self[i] ^ carry;
+      carry &= self[i];
+      last &= (((numStates - 1) >> i) & 1) ? self[i] : ~self[i];
     }
+    for (int i = 0; i < numPlanes; ++i)
+      succ[i] &= ~last;
+  }
+
+  /// Next state of word w of a cyclic CA held as bit planes (above / same /
+  /// below hold one row pointer per plane): a cell advances to its
+  /// successor if any Moore neighbor is in that state. Each neighbor
+  /// direction is compared with the successor planes over 64 cells at once.
+  static void cyclicWord(const uint64_t *const *above,
+                         const uint64_t *const *same,
+                         const uint64_t *const *below, uint64_t *const *out,
+                         int numPlanes, int numStates, int w, int wordsPerRow,
+                         int cols) {
+    uint64_t self[kMaxStatePlanes], succ[kMaxStatePlanes];
+    for (int i = 0; i < numPlanes; ++i)
+      self[i] = same[i][w];
+    cyclicSuccessor(self, numPlanes, numStates, succ);
+
+    // match[d]: the neighbor in direction d equals the successor
+    uint64_t match[8];
+    for (uint64_t &m : match)
+      m = ~0ULL;
+    for (int i = 0; i < numPlanes; ++i) {
+      const uint64_t n[8] = {
+          westNeighbors(above[i], w, wordsPerRow, cols),
+          above[i][w],
+          eastNeighbors(above[i], w, wordsPerRow, cols),
+          westNeighbors(same[i], w, wordsPerRow, cols),
+          eastNeighbors(same[i], w, wordsPerRow, cols),
+          westNeighbors(below[i], w, wordsPerRow, cols),
+          below[i][w],
+          eastNeighbors(below[i], w, wordsPerRow, cols)};
+      for (int d = 0; d < 8; ++d)
+        match[d] &= ~(n[d] ^ succ[i]);
+    }
+    uint64_t advance = 0;
+    for (uint64_t m : match)
+      advance |= m;
+    for (int i = 0; i < numPlanes; ++i)
+      out[i][w] = self[i] ^ (advance & (self[i] ^ succ[i]));
+  }
+
+  /// Advance words [wordBegin, wordEnd) of one cyclic CA row.
+  static void stepCyclicWords(const uint64_t *const *above,
+                              const uint64_t *const *same,
+                              const uint64_t *const *below,
+                              uint64_t *const *out, int numPlanes,
+                              int numStates, int wordBegin, int wordEnd,
+                              int wordsPerRow, int cols) {
+    for (int w = wordBegin; w < wordEnd; ++w)
+      cyclicWord(above, same, below, out, numPlanes, numStates, w,
+                 wordsPerRow, cols);
+    if (wordEnd == wordsPerRow)
+      for (int i = 0; i < numPlanes; ++i)
+        out[i][wordsPerRow - 1] &= lastWordMask(cols);
   }
 
 private:
+  static void fullAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t &sum,
+                      uint64_t &carry) {
+    const uint64_t ab = a ^ b;
+    sum = ab ^ c;
+    carry = (a & b) | (ab & c);
+  }
+
   int rows_ = 0;
   int cols_ = 0;
   int wordsPerRow_ = 0;
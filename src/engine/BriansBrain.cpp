@@ -1,5 +1,6 @@
 #include "BriansBrain.h"
-#include "BitwiseGrid.h"
+#include "LifeKernels.h"
+#include <algorithm>
 
 namespace {
 uint64_t xorshift64(uint64_t &state) {
@@ -16,71 +17,18 @@ BriansBrain::BriansBrain(int rows, int cols)
 void BriansBrain::step() {
   const int rows = grid.getRows();
   const int cols = grid.getCols();
+  events.reset(rows, cols);
 
-  // For large grids, use BitwiseGrid to accelerate neighbor counting.
-  // Only "On" (state 1) cells matter for neighbor counting.
-  static constexpr int kBitwiseThreshold = 128 * 128;
   if (rows * cols >= kBitwiseThreshold) {
-    // Pack "On" cells into bitwise grid
-    BitwiseGrid onCells;
-    onCells.resize(rows, cols);
-    for (int r = 0; r < rows; ++r) {
-      for (int c = 0; c < cols; ++c) {
-        if (grid.getCell(r, c) == 1)
-          onCells.setCell(r, c, true);
-      }
-    }
-
-    scratch.resize(rows, cols);
-    int wordsPerRow = onCells.getWordsPerRow();
-
-    for (int r = 0; r < rows; ++r) {
-      int rAbove = (r - 1 + rows) % rows;
-      int rBelow = (r + 1) % rows;
-      const uint64_t *rowAbove = onCells.rowData(rAbove);
-      const uint64_t *rowSame = onCells.rowData(r);
-      const uint64_t *rowBelow = onCells.rowData(rBelow);
-
-      for (int w = 0; w < wordsPerRow; ++w) {
-        uint8_t counts[64];
-        BitwiseGrid::countNeighbors64(rowAbove, rowSame, rowBelow, w,
-                                      wordsPerRow, cols, counts);
-
-        int bitsInWord = cols - w * 64;
-        if (bitsInWord > 64)
-          bitsInWord = 64;
-
-        for (int b = 0; b < bitsInWord; ++b) {
-          int c = w * 64 + b;
-          uint8_t current = grid.getCell(r, c);
-
-          if (current == 0) {
-            if (counts[b] == 2) {
-              scratch.setCell(r, c, 1);
-              scratch.setAge(r, c, 1);
-            } else {
-              scratch.setCell(r, c, 0);
-              scratch.setAge(r, c, 0);
-            }
-          } else if (current == 1) {
-            scratch.setCell(r, c, 2);
-            scratch.setAge(r, c, grid.getAge(r, c) + 1);
-          } else {
-            scratch.setCell(r, c, 0);
-            scratch.setAge(r, c, 0);
-          }
-        }
-      }
-    }
-
-    grid.copyFrom(scratch);
-    ++generation;
+    stepBitwise();
     return;
   }
 
-  // Small grid: original loop
-  scratch.resize(rows, cols);
+  // Small grid: original loop into the back buffer
+  if (scratch.getRows() != rows || scratch.getCols() != cols)
+    scratch.resize(rows, cols);
 
+  CellEventList::Writer out(events);
   for (int r = 0; r < rows; ++r) {
     for (int c = 0; c < cols; ++c) {
       uint8_t current = grid.getCell(r, c);
@@ -99,6 +47,7 @@ void BriansBrain::step() {
         if (onCount == 2) {
           scratch.setCell(r, c, 1);
           scratch.setAge(r, c, 1);
+          out.add(r, c, CellEvent::Birth, 1.0f);
         } else {
           scratch.setCell(r, c, 0);
           scratch.setAge(r, c, 0);
@@ -111,16 +60,180 @@ void BriansBrain::step() {
         // Dying -> Off
         scratch.setCell(r, c, 0);
         scratch.setAge(r, c, 0);
+        out.add(r, c, CellEvent::Death, 0.0f);
       }
     }
   }
+  out.flush();
 
-  grid.copyFrom(scratch);
+  grid.swapBuffers(scratch);
+  packedStale = true;
   ++generation;
 }
 
+void BriansBrain::stepBitwise() {
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+
+  preparePacked();
+  if (packedStale) {
+    forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+      packFromGrid(rowBegin, rowEnd);
+    });
+    busyTiles.scan(onPlane);
+    busyTiles.scanAdd(dyingPlane);
+    busyTilesNext.fill(true); // unknown back planes: empty all of them
+    packedStale = false;
+  }
+
+  // Off cells are only born next to On cells and Dying cells only turn Off,
+  // so only busy tiles and those an On cell touches across a border change.
+  if (tileSkipping)
+    activeTiles.markActiveFrom(busyTiles);
+  else
+    activeTiles.fill(true);
+
+  // Step + unpack per band of tile rows; halo rows come from the untouched
+  // On plane
+  forEachRowBand(busyTiles.getTileRows(), cols * TileActivity::kTileSize,
+                 [&](int tileRowBegin, int tileRowEnd) {
+                   CellEventList::Writer out(events);
+                   for (int tr = tileRowBegin; tr < tileRowEnd; ++tr) {
+                     stepTileRow(tr);
+                     unpackTileRow(tr, out);
+                   }
+                 });
+
+  onPlane.swap(onNext);
+  dyingPlane.swap(dyingNext);
+  busyTiles.swap(busyTilesNext);
+  ++generation;
+}
+
+void BriansBrain::stepTileRow(int tr) {
+  const int tileCols = busyTiles.getTileCols();
+  const int rowBegin = tr * TileActivity::kTileSize;
+  const int rowEnd =
+      std::min(grid.getRows(), rowBegin + TileActivity::kTileSize);
+  const uint8_t *active = activeTiles.tileRow(tr);
+  uint8_t *busyNext = busyTilesNext.tileRow(tr);
+
+  for (int tc = 0; tc < tileCols;) {
+    if (!active[tc]) {
+      if (busyNext[tc]) {
+        TileActivity::clearTile(onNext, tr, tc);
+        TileActivity::clearTile(dyingNext, tr, tc);
+        busyNext[tc] = 0;
+      }
+      ++tc;
+      continue;
+    }
+    int runEnd = tc + 1;
+    while (runEnd < tileCols && active[runEnd])
+      ++runEnd;
+    LifeKernels::stepBriansBrain(onPlane, dyingPlane, onNext, dyingNext,
+                                 rowBegin, rowEnd, tc, runEnd);
+    // Border flags from On cells only (Dying cells cause no births);
+    // Dying(next) == On(prev) just keeps the tile live
+    for (; tc < runEnd; ++tc) {
+      busyNext[tc] = TileActivity::tileFlags(onNext, tr, tc);
+      if (!busyNext[tc] && TileActivity::tileOccupied(onPlane, tr, tc))
+        busyNext[tc] = TileActivity::kLive;
+    }
+  }
+}
+
+void BriansBrain::preparePacked() {
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  if (onPlane.getRows() != rows || onPlane.getCols() != cols) {
+    onPlane.resize(rows, cols);
+    dyingPlane.resize(rows, cols);
+    onNext.resize(rows, cols);
+    dyingNext.resize(rows, cols);
+    busyTiles.resize(rows, cols);
+    busyTilesNext.resize(rows, cols);
+    activeTiles.resize(rows, cols);
+    packedStale = true;
+  }
+}
+
+void BriansBrain::packFromGrid(int rowBegin, int rowEnd) {
+  const int cols = grid.getCols();
+  const int wordsPerRow = onPlane.getWordsPerRow();
+
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const uint8_t *cells = grid.cellRow(r);
+    uint64_t *onWords = onPlane.rowData(r);
+    uint64_t *dyingWords = dyingPlane.rowData(r);
+    for (int w = 0; w < wordsPerRow; ++w) {
+      const int base = w * 64;
+      const int bits = std::min(64, cols - base);
+      uint64_t on = 0;
+      uint64_t dying = 0;
+      for (int b = 0; b < bits; ++b) {
+        on |= static_cast<uint64_t>(cells[base + b] == 1) << b;
+        dying |= static_cast<uint64_t>(cells[base + b] == 2) << b;
+      }
+      onWords[w] = on;
+      dyingWords[w] = dying;
+    }
+  }
+}
+
+void BriansBrain::unpackTileRow(int tr, CellEventList::Writer &out) {
+  const int cols = grid.getCols();
+  const int wordsPerRow = onPlane.getWordsPerRow();
+  const int rowBegin = tr * TileActivity::kTileSize;
+  const int rowEnd =
+      std::min(grid.getRows(), rowBegin + TileActivity::kTileSize);
+  const uint8_t *busyPrev = busyTiles.tileRow(tr);
+  const uint8_t *busyNext = busyTilesNext.tileRow(tr);
+
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    // Dying(next) == On(prev), so On(prev) | Dying(prev) | On(next) covers
+    // every cell that changes or is non-zero.
+    const uint64_t *onPrev = onPlane.rowData(r);
+    const uint64_t *dyingPrev = dyingPlane.rowData(r);
+    const uint64_t *onNow = onNext.rowData(r);
+    uint8_t *cells = grid.cellRow(r);
+    uint16_t *ages = grid.ageRow(r);
+
+    for (int w = 0; w < wordsPerRow; ++w) {
+      if (!(busyPrev[w] | busyNext[w]))
+        continue;
+      const uint64_t on = onNow[w];
+      const uint64_t dying = onPrev[w];
+      if ((on | dying | dyingPrev[w]) == 0)
+        continue;
+
+      const int base = w * 64;
+      const int bits = std::min(64, cols - base);
+      // Alive = On | Dying: births are new On cells, deaths are Dying -> Off
+      const uint64_t valid = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+      out.addWord(r, base, on & ~(dying | dyingPrev[w]) & valid,
+                  dyingPrev[w] & ~(on | dying) & valid);
+      for (int b = 0; b < bits; ++b) {
+        uint16_t &age = ages[base + b];
+        if ((on >> b) & 1ULL) {
+          cells[base + b] = 1;
+          age = 1;
+        } else if ((dying >> b) & 1ULL) {
+          cells[base + b] = 2;
+          if (age < UINT16_MAX)
+            ++age;
+        } else {
+          cells[base + b] = 0;
+          age = 0;
+        }
+      }
+    }
+  }
+}
+
 void BriansBrain::randomize(uint64_t seed, float density) {
   grid.clear();
+  packedStale = true;
   generation = 0;
   uint64_t state = seed ? seed : 1;
 
@@ -137,6 +250,7 @@ void BriansBrain::randomize(uint64_t seed, float density) {
 
 void BriansBrain::randomizeSymmetric(uint64_t seed, float density) {
   grid.clear();
+  packedStale = true;
   generation = 0;
   uint64_t state = seed ? seed : 1;
   const int halfR = (grid.getRows() + 1) / 2;
@@ -163,5 +277,6 @@ void BriansBrain::randomizeSymmetric(uint64_t seed, float density) {
 
 void BriansBrain::clear() {
   grid.clear();
+  packedStale = true;
   generation = 0;
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "BitwiseGrid.h"
 #include "CellularEngine.h"
 #include "Grid.h"
+#include "TileActivity.h"
 #include <cstdint>
 
 /// Brian's Brain: 3-state cellular automaton.
@@ -19,12 +21,59 @@ public:
   void randomizeSymmetric(uint64_t seed, float density) override;
   void clear() override;
   const Grid &getGrid() const override { return grid; }
-  Grid &getGridMutable() override { return grid; }
+  /// Mutable access invalidates the packed planes (re-packed on next step).
+  Grid &getGridMutable() override {
+    packedStale = true;
+    return grid;
+  }
   uint64_t getGeneration() const override { return generation; }
   const char *getName() const override { return "Brian's Brain"; }
+  const TileActivity *getLiveTiles() const override {
+    return packedStale ? nullptr : &busyTiles;
+  }
+
+  /// Skip 64x64 tiles with no On or Dying cell in their tile neighborhood
+  /// (on by default).
+  void setTileSkipping(bool enabled) { tileSkipping = enabled; }
+  bool getTileSkipping() const { return tileSkipping; }
 
 private:
+  /// Two-plane bitwise step for large grids (>= 128x128)
+  void stepBitwise();
+
+  /// Size the persistent planes to the grid (allocates only when dimensions
+  /// change).
+  void preparePacked();
+
+  /// Rebuild rows [rowBegin, rowEnd) of the On / Dying planes from grid cells.
+  void packFromGrid(int rowBegin, int rowEnd);
+
+  /// Advance the active tiles of tile row tr into the next planes, empty
+  /// its inactive ones, and update busyTilesNext.
+  void stepTileRow(int tr);
+
+  /// Write tile row tr of the next planes back into grid cells and ages
+  /// (only tiles busy before or after the step).
+  void unpackTileRow(int tr, CellEventList::Writer &out);
+
+  static constexpr int kBitwiseThreshold = 128 * 128;
+
   Grid grid;
   Grid scratch;
   uint64_t generation = 0;
+
+  // Persistent bit planes for the large-grid path: On (state 1) and
+  // Dying (state 2). Off is the complement of both.
+  BitwiseGrid onPlane;
+  BitwiseGrid dyingPlane;
+  BitwiseGrid onNext;
+  BitwiseGrid dyingNext;
+  bool packedStale = true;
+
+  // Tiles with an On or Dying cell in the current / next planes (supersets)
+  // and this step's tiles to advance.
+  TileActivity busyTiles;
+  TileActivity busyTilesNext;
+  TileActivity activeTiles;
+  bool tileSkipping = true;
 };
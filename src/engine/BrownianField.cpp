@@ -1,4 +1,6 @@
 #include "BrownianField.h"
+#include "CounterRng.h"
+#include "WorkerPool.h"
 #include <algorithm>
 #include <cmath>
 
@@ -13,80 +15,162 @@ uint64_t xorshift64(uint64_t &state) {
 float randFloat(uint64_t &state) {
   return static_cast<float>(xorshift64(state) >> 32) / 4294967296.0f;
 }
+
+// Walkers per hit plane before another band (and plane) is worth it
+constexpr int kMinWalkersPerPlane = 1 << 14;
+// Hit planes at most (memory: rows x cols bytes each)
+constexpr int kMaxHitPlanes = 16;
+// Relative cost of moving one walker against one grid cell, for
+// forEachRowBand()
+constexpr int kWorkPerWalker = 2;
+// Walkers per SIMD group in moveWalkers()
+constexpr int kLanes = 16;
 } // namespace
 
-BrownianField::BrownianField(int r, int c)
-    : energy(Grid::kMaxCells, 0.0f), grid(r, c), rows(r), cols(c) {}
+BrownianField::BrownianField(int r, int c, int walkers)
+    : grid(r, c), rows(grid.getRows()), cols(grid.getCols()),
+      energy(rows, cols, kEnergyDecay, kDepositAmount, kThreshold) {
+  setNumWalkers(walkers);
+}
 
-void BrownianField::step() {
-  // Move walkers (random walk)
-  for (int i = 0; i < kNumWalkers; ++i) {
-    auto &w = walkers[i];
-
-    // Random step in x and y
-    w.x += (randFloat(rng) - 0.5f) * 2.0f;
-    w.y += (randFloat(rng) - 0.5f) * 2.0f;
-
-    // Toroidal wrapping
-    if (w.x < 0)
-      w.x += cols;
-    if (w.x >= cols)
-      w.x -= cols;
-    if (w.y < 0)
-      w.y += rows;
-    if (w.y >= rows)
-      w.y -= rows;
-
-    // Deposit energy at current position
-    int gr = static_cast<int>(w.y) % rows;
-    int gc = static_cast<int>(w.x) % cols;
-    if (gr >= 0 && gr < rows && gc >= 0 && gc < cols) {
-      float &e = energy[gr * Grid::kMaxCols + gc];
-      e += kDepositAmount;
-      if (e > 1.0f)
-        e = 1.0f;
-    }
+void BrownianField::setNumWalkers(int count) {
+  count = std::clamp(count, 1, kMaxWalkers);
+  const int previous = numWalkers;
+  numWalkers = count;
+  wx.resize(static_cast<size_t>(count), 0.0f);
+  wy.resize(static_cast<size_t>(count), 0.0f);
+  walkerCells.resize(static_cast<size_t>(count), 0);
+  for (int i = previous; i < count; ++i) {
+    wx[i] = randFloat(rng) * cols;
+    wy[i] = randFloat(rng) * rows;
   }
+  reserveHitPlanes();
+}
 
-  // Global energy decay
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      float &e = energy[r * Grid::kMaxCols + c];
-      e *= kEnergyDecay;
-      if (e < 0.01f)
-        e = 0.0f;
-    }
+int BrownianField::numHitPlanes() const {
+  const WorkerPool *pool = getWorkerPool();
+  const int threads = pool ? pool->getNumThreads() : 1;
+  return std::max(
+      1, std::min({threads, kMaxHitPlanes, numWalkers / kMinWalkersPerPlane}));
+}
+
+void BrownianField::reserveHitPlanes() {
+  const size_t numCells = static_cast<size_t>(rows) * cols;
+  while (static_cast<int>(hitPlanes.size()) < numHitPlanes())
+    hitPlanes.emplace_back(numCells, 0);
+}
+
+void BrownianField::step() {
+  const uint32_t key = CounterRng::stepKey(walkSeed, generation);
+  events.reset(rows, cols);
+
+  if (!energy.beginStep(numWalkers, grid)) {
+    // Sparse: move, then deposit; only landed-on and live cells are touched
+    forEachRowBand(numWalkers, kWorkPerWalker, [&](int begin, int end) {
+      moveWalkers(begin, end, key);
+    });
+    for (int i = 0; i < numWalkers; ++i)
+      energy.addHit(walkerCells[i]);
+    CellEventList::Writer out(events);
+    energy.stepSparse(grid, out);
+    energy.endStep();
+    ++generation;
+    return;
   }
 
-  projectToGrid();
+  // Dense: one hit plane per walker band, a band per thread given enough
+  // walkers (allocated by reserveHitPlanes())
+  const int planes = numHitPlanes();
+
+  // Move walkers and count their hits
+  const int perPlane = (numWalkers + planes - 1) / planes;
+  forEachRowBand(planes, perPlane * kWorkPerWalker, [&](int p0, int p1) {
+    for (int p = p0; p < p1; ++p) {
+      const int begin = p * perPlane;
+      const int end = std::min(numWalkers, begin + perPlane);
+      moveWalkers(begin, end, key);
+      uint8_t *hits = hitPlanes[p].data();
+      for (int i = begin; i < end; ++i) {
+        uint8_t &h = hits[walkerCells[i]];
+        h = static_cast<uint8_t>(h + (h < 2));
+      }
+    }
+  });
+
+  // Merge the planes, deposit, decay and project, one row at a time
+  uint8_t *planePtrs[kMaxHitPlanes];
+  for (int p = 0; p < planes; ++p)
+    planePtrs[p] = hitPlanes[p].data();
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    CellEventList::Writer out(events);
+    energy.stepRows(rowBegin, rowEnd, planePtrs, planes, grid, out);
+  });
+  energy.endStep();
   ++generation;
 }
 
-void BrownianField::projectToGrid() {
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      float e = energy[r * Grid::kMaxCols + c];
-      if (e > kThreshold) {
-        grid.setCell(r, c, 1);
-        grid.setAge(r, c, static_cast<uint16_t>(e * 255.0f));
-      } else {
-        grid.setCell(r, c, 0);
-        grid.setAge(r, c, 0);
-      }
+void BrownianField::moveWalkers(int begin, int end, uint32_t key) {
+  const auto fcols = static_cast<float>(cols);
+  const auto frows = static_cast<float>(rows);
+  const float maxX = std::nextafter(fcols, 0.0f);
+  const float maxY = std::nextafter(frows, 0.0f);
+  int *cells = walkerCells.data();
+  // Random step in x and y, then toroidal wrapping; returns the cell the
+  // walker lands on. The wraps are integer masks rather than ?: chains,
+  // which GCC does not if-convert for floats; min() catches -epsilon + cols
+  // rounding up to cols.
+  auto walk = [&](int i, float &x, float &y) {
+    const uint32_t h = CounterRng::bits(key, static_cast<uint32_t>(i));
+    x = wx[i] + (CounterRng::unitFloatLow(h) - 0.5f) * 2.0f;
+    y = wy[i] + (CounterRng::unitFloatHigh(h) - 0.5f) * 2.0f;
+    const int wrapX = (x < 0.0f) - (x >= fcols);
+    const int wrapY = (y < 0.0f) - (y >= frows);
+    x = std::min(x + fcols * static_cast<float>(wrapX), maxX);
+    y = std::min(y + frows * static_cast<float>(wrapY), maxY);
+    return static_cast<int>(y) * cols + static_cast<int>(x);
+  };
+
+  // Groups of kLanes walkers are computed into locals, then stored, so
+  // the walk runs in SIMD lanes
+  int i = begin;
+  for (; i + kLanes <= end; i += kLanes) {
+    float nx[kLanes], ny[kLanes];
+    int landed[kLanes];
+    for (int l = 0; l < kLanes; ++l)
+      landed[l] = walk(i + l, nx[l], ny[l]);
+    for (int l = 0; l < kLanes; ++l) {
+      wx[i + l] = nx[l];
+      wy[i + l] = ny[l];
+      cells[i + l] = landed[l];
     }
   }
+  for (; i < end; ++i) {
+    float x, y;
+    cells[i] = walk(i, x, y);
+    wx[i] = x;
+    wy[i] = y;
+  }
+}
+
+void BrownianField::projectToGrid() {
+  events.reset(rows, cols);
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    CellEventList::Writer out(events);
+    energy.projectRows(rowBegin, rowEnd, grid, out);
+  });
 }
 
 void BrownianField::randomize(uint64_t seed, float density) {
   generation = 0;
   rng = seed ? seed : 1;
+  walkSeed = rng;
   (void)density;
 
-  std::fill(energy.begin(), energy.end(), 0.0f);
+  energy.clear();
 
-  for (int i = 0; i < kNumWalkers; ++i) {
-    walkers[i].x = randFloat(rng) * cols;
-    walkers[i].y = randFloat(rng) * rows;
+  for (int i = 0; i < numWalkers; ++i) {
+    wx[i] = randFloat(rng) * cols;
+    wy[i] = randFloat(rng) * rows;
   }
 
   projectToGrid();
@@ -95,22 +179,31 @@ void BrownianField::randomize(uint64_t seed, float density) {
 void BrownianField::randomizeSymmetric(uint64_t seed, float density) {
   generation = 0;
   rng = seed ? seed : 1;
+  walkSeed = rng;
   (void)density;
 
-  std::fill(energy.begin(), energy.end(), 0.0f);
+  energy.clear();
 
-  // Place walkers symmetrically
-  int perQuadrant = kNumWalkers / 4;
+  // Place walkers symmetrically; a remainder starts at the center, which
+  // is its own mirror image
+  int perQuadrant = numWalkers / 4;
   for (int i = 0; i < perQuadrant; ++i) {
     float x = randFloat(rng) * (cols / 2.0f);
     float y = randFloat(rng) * (rows / 2.0f);
 
     int base = i * 4;
-    walkers[base] = {x, y};
-    walkers[base + 1] = {static_cast<float>(cols) - x, y};
-    walkers[base + 2] = {x, static_cast<float>(rows) - y};
-    walkers[base + 3] = {static_cast<float>(cols) - x,
-                         static_cast<float>(rows) - y};
+    wx[base] = x;
+    wy[base] = y;
+    wx[base + 1] = static_cast<float>(cols) - x;
+    wy[base + 1] = y;
+    wx[base + 2] = x;
+    wy[base + 2] = static_cast<float>(rows) - y;
+    wx[base + 3] = static_cast<float>(cols) - x;
+    wy[base + 3] = static_cast<float>(rows) - y;
+  }
+  for (int i = perQuadrant * 4; i < numWalkers; ++i) {
+    wx[i] = cols / 2.0f;
+    wy[i] = rows / 2.0f;
   }
 
   projectToGrid();
@@ -118,8 +211,8 @@ void BrownianField::randomizeSymmetric(uint64_t seed, float density) {
 
 void BrownianField::clear() {
   generation = 0;
-  std::fill(energy.begin(), energy.end(), 0.0f);
-  for (int i = 0; i < kNumWalkers; ++i)
-    walkers[i] = {};
+  energy.clear();
+  std::fill(wx.begin(), wx.end(), 0.0f);
+  std::fill(wy.begin(), wy.end(), 0.0f);
   grid.clear();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CellularEngine.h"
+#include "DecayField.h"
 #include "Grid.h"
 #include <cstdint>
 #include <vector>
@@ -9,16 +10,31 @@
 /// Internal: walker positions (float) + energy field (float).
 /// Grid projection: energy > threshold -> alive; age = energy * 255.
 /// Produces diffuse, slowly-shifting noise patterns.
+///
+/// Walkers are stored as structure-of-arrays and moved with CounterRng, so
+/// each step is a pure function of (seed, generation, walker index) and
+/// runs in SIMD lanes and across the worker pool. The energy is a
+/// DecayField: with few walkers a step touches only the cells they land on
+/// and the live cells. Otherwise walker bands count their hits into
+/// private per-band planes, and one banded pass over the field merges the
+/// planes, deposits, decays and projects. The deposit depends only on the
+/// hit count per cell, so results do not depend on the thread count.
 class BrownianField final : public CellularEngine {
 public:
-  static constexpr int kNumWalkers = 32;
+  /// Constructor default, at any grid size: sparse walkers over a decaying
+  /// field are the engine's sound. Denser fields are opt-in.
+  static constexpr int kDefaultWalkers = 32;
+  static constexpr int kMaxWalkers = 1 << 22;
 
-  struct Walker {
-    float x = 0.0f;
-    float y = 0.0f;
-  };
+  /// @param numWalkers  1..kMaxWalkers (clamped).
+  explicit BrownianField(int rows = 12, int cols = 16,
+                         int numWalkers = kDefaultWalkers);
 
-  explicit BrownianField(int rows = 12, int cols = 16);
+  /// Resize the walker pool (clamped to [1, kMaxWalkers]). Existing
+  /// walkers keep their positions; added ones start at random positions.
+  /// Not while step() runs.
+  void setNumWalkers(int numWalkers);
+  int getNumWalkers() const { return numWalkers; }
 
   // --- CellularEngine interface ---
   EngineType getType() const override { return EngineType::BrownianField; }
@@ -27,7 +43,10 @@ public:
   void randomizeSymmetric(uint64_t seed, float density) override;
   void clear() override;
   const Grid &getGrid() const override { return grid; }
-  Grid &getGridMutable() override { return grid; }
+  Grid &getGridMutable() override {
+    energy.markGridStale();
+    return grid;
+  }
   uint64_t getGeneration() const override { return generation; }
   const char *getName() const override { return "Brownian Field"; }
   int getDefaultTriggerBudget() const override { return 6; }
@@ -35,31 +54,56 @@ public:
 
   // --- Engine-specific intensity ---
   float getCellIntensity(int row, int col) const override {
-    float e = energy[row * Grid::kMaxCols + col];
+    float e = energy.value(row * cols + col);
     return (e > 1.0f) ? 1.0f : ((e < 0.0f) ? 0.0f : e);
   }
   bool cellActivated(int row, int col) const override {
     return getGrid().wasBorn(row, col);
   }
 
-  // --- Native data access for visualizer ---
-  const Walker *getWalkers() const { return walkers; }
-  const float *getEnergyField() const { return energy.data(); }
+  // --- Native data access for visualizer (rows x cols, stride == cols) ---
+  // Walker arrays hold getNumWalkers() values
+  const float *getWalkerX() const { return wx.data(); }
+  const float *getWalkerY() const { return wy.data(); }
+  // Energy decayed to the current generation into out (rows x cols):
+  // O(rows x cols), for tests and diagnostics. Safe alongside other
+  // readers; not while step() runs.
+  void materializeEnergy(float *out) const { energy.materialize(out); }
+  const DecayField &getDecayField() const { return energy; }
+
+protected:
+  void workerPoolChanged() override { reserveHitPlanes(); }
 
 private:
+  /// Hit planes a dense step uses for the current pool and walker count.
+  int numHitPlanes() const;
+  /// Grow hitPlanes to numHitPlanes() (setNumWalkers(), pool changes).
+  void reserveHitPlanes();
+  void moveWalkers(int begin, int end, uint32_t key);
   void projectToGrid();
 
-  static constexpr int kMax = Grid::kMaxRows * Grid::kMaxCols;
   static constexpr float kEnergyDecay = 0.95f;
   static constexpr float kDepositAmount = 0.8f;
   static constexpr float kThreshold = 0.1f;
 
-  Walker walkers[kNumWalkers] = {};
-  std::vector<float> energy;
   uint64_t rng = 12345;
+  uint64_t walkSeed = 12345; // CounterRng seed, from randomize()
 
   Grid grid;
   uint64_t generation = 0;
   int rows = 12;
   int cols = 16;
+
+  // Row-major, stride == cols (declared after rows/cols: sized from them)
+  DecayField energy;
+
+  // Walkers (structure of arrays)
+  int numWalkers = 0;
+  std::vector<float> wx, wy;
+  std::vector<int> walkerCells; // cell each walker landed on this step
+
+  // Per-band hit counts for dense steps (saturating at 2, which already
+  // fills a cell), rows x cols each; all zero between steps. Never grown
+  // in step()
+  std::vector<std::vector<uint8_t>> hitPlanes;
 };
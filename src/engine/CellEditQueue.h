@@ -43,6 +43,12 @@ public:
     return true;
   }
 
+  /// True if no commands are pending (consumer side).
+  bool empty() const {
+    return readPos.load(std::memory_order_relaxed) ==
+           writePos.load(std::memory_order_acquire);
+  }
+
   /// Drain up to maxCount commands into grid. Returns number drained.
   /// Call from audio thread at start of processBlock.
   template <typename GridType>
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// One grid cell whose alive state (cell value 0 vs. non-zero) changed
+/// during a generation. Continuous engines report threshold crossings of
+/// their projected field; intensity is the engine's native value.
+struct CellEvent {
+  enum Type : uint8_t {
+    Birth, ///< dead -> alive (or rose above the threshold)
+    Death, ///< alive -> dead (or fell below the threshold)
+  };
+
+  uint16_t row = 0;
+  uint16_t col = 0;
+  Type type = Birth;
+  float intensity = 0.0f; ///< cell intensity after the step, 0.0-1.0
+};
+
+/// Bounded list of the cell events of one generation.
+///
+/// Storage is sized once to min(rows * cols, kMaxEvents). Row bands running
+/// on different threads append through a Writer, which batches events and
+/// reserves slots with one atomic add per batch; the order of the events is
+/// therefore unspecified. When a generation produces more events than fit,
+/// the list is marked overflowed and consumers fall back to scanning the
+/// grid.
+class CellEventList {
+public:
+  /// Upper bound on stored events per generation (~768 KB at 12 bytes).
+  static constexpr int kMaxEvents = 1 << 16;
+
+  /// Start a new generation. Allocates only when the capacity for this
+  /// grid size was never reached before.
+  void reset(int rows, int cols) {
+    const int needed = std::min(rows * cols, kMaxEvents);
+    if (capacity() < needed)
+      storage.resize(static_cast<size_t>(needed));
+    count.store(0, std::memory_order_relaxed);
+    recorded = true;
+  }
+
+  /// Number of events recorded (call after the producing pass finished).
+  int size() const {
+    return std::min(count.load(std::memory_order_relaxed), capacity());
+  }
+
+  /// More events occurred than the list could hold: contents are partial.
+  bool overflowed() const {
+    return count.load(std::memory_order_relaxed) > capacity();
+  }
+
+  /// Every change of the generation is in the list: reset() was called by
+  /// the producer and nothing overflowed. Engines that never record events
+  /// stay incomplete, so consumers rescan instead of missing changes.
+  bool complete() const { return recorded && !overflowed(); }
+
+  const CellEvent *data() const { return storage.data(); }
+  const CellEvent *begin() const { return storage.data(); }
+  const CellEvent *end() const { return storage.data() + size(); }
+
+  /// Per-band appender. Create one per row band (or loop), call add() for
+  /// every changed cell; the destructor flushes the remainder.
+  class Writer {
+  public:
+    explicit Writer(CellEventList &list) : list(list) {}
+    ~Writer() { flush(); }
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    void add(int row, int col, CellEvent::Type type, float intensity) {
+      if (pending == kBatch)
+        flush();
+      CellEvent &e = batch[pending++];
+      e.row = static_cast<uint16_t>(row);
+      e.col = static_cast<uint16_t>(col);
+      e.type = type;
+      e.intensity = intensity;
+    }
+
+    /// Events for 64 bit-packed cells: bit b of born / died is column
+    /// colBase + b (binary engines, intensity 1 / 0).
+    void addWord(int row, int colBase, uint64_t born, uint64_t died) {
+      for (; born; born &= born - 1)
+        add(row, colBase + lowestBit(born), CellEvent::Birth, 1.0f);
+      for (; died; died &= died - 1)
+        add(row, colBase + lowestBit(died), CellEvent::Death, 0.0f);
+    }
+
+    void flush() {
+      if (pending == 0)
+        return;
+      const int at = list.count.fetch_add(pending, std::memory_order_relaxed);
+      const int room = std::max(0, list.capacity() - at);
+      std::copy(batch, batch + std::min(pending, room),
+                list.storage.begin() + std::min(at, list.capacity()));
+      pending = 0;
+    }
+
+  private:
+    static int lowestBit(uint64_t word) {
+#if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward64(&index, word);
+      return static_cast<int>(index);
+#else
+      return __builtin_ctzll(word);
+#endif
+    }
+
+    static constexpr int kBatch = 64;
+    CellEventList &list;
+    CellEvent batch[kBatch];
+    int pending = 0;
+  };
+
+private:
+  int capacity() const { return static_cast<int>(storage.size()); }
+
+  std::vector<CellEvent> storage;
+  std::atomic<int> count{0}; // may exceed capacity (= overflowed)
+  bool recorded = false;
+};
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "CellEvents.h"
 #include "Grid.h"
+#include "TileActivity.h"
+#include "WorkerPool.h"
+#include <algorithm>
 #include <cstdint>
 
 /// Engine type identifier for safe downcasting by visualizers.
@@ -12,7 +16,8 @@ enum class EngineType {
   ParticleSwarm,
   Lenia,
   BrownianField,
-  Lenia3D
+  Lenia3D,
+  HashLife
 };
 
 /// Abstract interface for all cellular automata engines.
@@ -63,11 +68,32 @@ public:
 
   /// Check if a cell was "activated" this step (newly triggered).
   /// Binary engines use wasBorn(). Continuous engines detect threshold
-  /// crossing.
+  /// crossing. Requires Grid::snapshotPrev() before step(); bulk consumers
+  /// should use getEvents() instead.
   virtual bool cellActivated(int row, int col) const {
     return getGrid().wasBorn(row, col);
   }
 
+  /// Births and deaths (cell value 0 <-> non-zero) produced by the last
+  /// step(), in unspecified order. Continuous engines report threshold
+  /// crossings of their grid projection with the native intensity. Only
+  /// valid right after step(): randomize(), clear() and cell edits do not
+  /// record events.
+  const CellEventList &getEvents() const { return events; }
+
+  /// Generations advanced by one step(). Engines that can jump ahead
+  /// cheaply (HashLife) accept a request and return true; the caller then
+  /// requests one step per tick instead of one per generation. Must be
+  /// safe to call from the audio thread while the engine steps.
+  virtual bool setGenerationsPerStep(int /*generations*/) { return false; }
+  virtual int getGenerationsPerStep() const { return 1; }
+
+  /// Occupancy of 64x64 tiles: every tile holding a non-zero cell of
+  /// getGrid() is set (empty tiles may be set too). nullptr if the engine
+  /// does not track it or the grid was edited since the last step(). Valid
+  /// until the next step() or edit.
+  virtual const TileActivity *getLiveTiles() const { return nullptr; }
+
   /// Default max triggers per step. Dense engines override with lower values.
   /// 0 means no limit (use kMaxVoices).
   virtual int getDefaultTriggerBudget() const { return 32; }
@@ -75,4 +101,83 @@ public:
   /// Per-engine gain scaling. Dense engines override with < 1.0 to prevent
   /// energy buildup when many voices are active simultaneously.
   virtual float getGainScale() const { return 1.0f; }
+
+  // --- Saved state ---
+
+  /// Float fields behind the grid projection (continuous engines), saved
+  /// with the plugin state so a reload resumes exactly. Each holds
+  /// getGrid().getRows() * getCols() values, row-major. Default: none.
+  virtual int getNumFields() const { return 0; }
+  virtual const float *getField(int /*index*/) const { return nullptr; }
+  virtual float *getFieldMutable(int /*index*/) { return nullptr; }
+
+  // --- Multi-threaded stepping ---
+
+  /// Attach a shared worker pool for banded stepping (nullptr = step on the
+  /// calling thread). Not owned: the pool must outlive the engine.
+  void setWorkerPool(WorkerPool *pool) {
+    workerPool = pool;
+    workerPoolChanged();
+  }
+  WorkerPool *getWorkerPool() const { return workerPool; }
+
+protected:
+  /// Called by setWorkerPool(): engines with per-band scratch resize it to
+  /// getMaxRowBands() here, so step() stays allocation-free.
+  virtual void workerPoolChanged() {}
+
+  /// Upper bound on the bands forEachRowBand() runs with the current pool
+  /// (band indices are below it).
+  int getMaxRowBands() const {
+    const int threads = workerPool ? workerPool->getNumThreads() : 1;
+    return threads <= 1 ? 1 : threads * kBandsPerThread;
+  }
+
+  /// Filled by step(); see getEvents().
+  CellEventList events;
+
+  /// Minimum cells per row band. Grids under two bands (128x128) stay on
+  /// the calling thread, where waking workers would cost more than it saves.
+  static constexpr int kMinCellsPerBand = 64 * 128;
+
+  /// Partition rows [0, rows) into contiguous bands and call
+  /// fn(rowBegin, rowEnd) for each, spread across the worker pool.
+  ///
+  /// A band writes only its own rows of the back buffer. The halo rows it
+  /// reads across band edges (one row for 3x3 stencils, kRadius for Lenia)
+  /// come from the front buffer, which no band writes during the pass, so
+  /// there is no exchange step and every cell is computed exactly as on a
+  /// single thread: results are bit-identical for any thread count.
+  template <typename Fn>
+  void forEachRowBand(int rows, int cols, Fn &&fn) const {
+    forEachIndexedRowBand(rows, cols, [&](int /*band*/, int rowBegin,
+                                          int rowEnd) {
+      fn(rowBegin, rowEnd);
+    });
+  }
+
+  /// As forEachRowBand(), calling fn(band, rowBegin, rowEnd). Each band
+  /// index in [0, getMaxRowBands()) runs at most once per call, so it can
+  /// pick scratch that no concurrent band touches.
+  template <typename Fn>
+  void forEachIndexedRowBand(int rows, int cols, Fn &&fn) const {
+    const int threads = workerPool ? workerPool->getNumThreads() : 1;
+    const int maxBands = (rows * cols) / kMinCellsPerBand;
+    if (threads <= 1 || maxBands < 2) {
+      fn(0, 0, rows);
+      return;
+    }
+    // A few bands per thread so faster threads can steal the remainder
+    const int bands = std::min({rows, maxBands, threads * kBandsPerThread});
+    const int bandRows = (rows + bands - 1) / bands;
+    workerPool->parallelFor((rows + bandRows - 1) / bandRows, [&](int band) {
+      const int r0 = band * bandRows;
+      fn(band, r0, std::min(rows, r0 + bandRows));
+    });
+  }
+
+private:
+  static constexpr int kBandsPerThread = 4;
+
+  WorkerPool *workerPool = nullptr;
 };
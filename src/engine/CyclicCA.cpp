@@ -1,4 +1,7 @@
 #include "CyclicCA.h"
+#include "LifeKernels.h"
+#include <algorithm>
+#include <cstring>
 
 namespace {
 uint64_t xorshift64(uint64_t &state) {
@@ -7,49 +10,132 @@ uint64_t xorshift64(uint64_t &state) {
   state ^= state << 17;
   return state;
 }
+
+// Bit b of a byte -> byte b of a word (0 or 1), for unpacking 8 cells at
+// once
+struct ByteSpread {
+  uint64_t table[256];
+  constexpr ByteSpread() : table() {
+    for (int v = 0; v < 256; ++v)
+      for (int b = 0; b < 8; ++b)
+        table[v] |= static_cast<uint64_t>((v >> b) & 1) << (8 * b);
+  }
+  uint64_t operator()(uint64_t word, int byte) const {
+    return table[(word >> (8 * byte)) & 0xff];
+  }
+};
+constexpr ByteSpread kSpread;
 } // namespace
 
-CyclicCA::CyclicCA(int rows, int cols)
-    : grid(rows, cols), scratch(rows, cols) {}
+CyclicCA::CyclicCA(int rows, int cols) : grid(rows, cols) {}
 
 void CyclicCA::step() {
   const int rows = grid.getRows();
   const int cols = grid.getCols();
-  scratch.resize(rows, cols);
-
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      uint8_t current = grid.getCell(r, c);
-      uint8_t next = (current + 1) % kNumStates;
-
-      // Check if any Moore neighbor is at (current+1)%N
-      bool consumed = false;
-      for (int dr = -1; dr <= 1 && !consumed; ++dr) {
-        for (int dc = -1; dc <= 1 && !consumed; ++dc) {
-          if (dr == 0 && dc == 0)
-            continue;
-          if (grid.getCell(r + dr, c + dc) == next)
-            consumed = true;
-        }
-      }
+  events.reset(rows, cols);
+
+  preparePacked();
+  if (packedStale) {
+    forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+      packFromGrid(rowBegin, rowEnd);
+    });
+    packedStale = false;
+  }
+
+  // Step + unpack per row band; halo rows come from the untouched planes
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    LifeKernels::stepCyclic(planes, nextPlanes, kStatePlanes, kNumStates,
+                            rowBegin, rowEnd);
+    CellEventList::Writer out(events);
+    for (int r = rowBegin; r < rowEnd; ++r)
+      unpackRow(r, out);
+  });
 
-      if (consumed) {
-        scratch.setCell(r, c, next);
-        scratch.setAge(r, c, 1);
-      } else {
-        scratch.setCell(r, c, current);
-        uint16_t age = grid.getAge(r, c);
-        scratch.setAge(r, c, age < UINT16_MAX ? age + 1 : age);
+  for (int i = 0; i < kStatePlanes; ++i)
+    planes[i].swap(nextPlanes[i]);
+  ++generation;
+}
+
+void CyclicCA::preparePacked() {
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  if (planes[0].getRows() != rows || planes[0].getCols() != cols) {
+    for (int i = 0; i < kStatePlanes; ++i) {
+      planes[i].resize(rows, cols);
+      nextPlanes[i].resize(rows, cols);
+    }
+    packedStale = true;
+  }
+}
+
+void CyclicCA::packFromGrid(int rowBegin, int rowEnd) {
+  const int cols = grid.getCols();
+  const int wordsPerRow = planes[0].getWordsPerRow();
+
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const uint8_t *cells = grid.cellRow(r);
+    for (int w = 0; w < wordsPerRow; ++w) {
+      const int base = w * 64;
+      const int bits = std::min(64, cols - base);
+      uint64_t words[kStatePlanes] = {};
+      for (int b = 0; b < bits; ++b) {
+        const int state = cells[base + b] % kNumStates;
+        for (int i = 0; i < kStatePlanes; ++i)
+          words[i] |= static_cast<uint64_t>((state >> i) & 1) << b;
       }
+      for (int i = 0; i < kStatePlanes; ++i)
+        planes[i].rowData(r)[w] = words[i];
     }
   }
+}
 
-  grid.copyFrom(scratch);
-  ++generation;
+void CyclicCA::unpackRow(int r, CellEventList::Writer &out) {
+  const int cols = grid.getCols();
+  const int wordsPerRow = planes[0].getWordsPerRow();
+  uint8_t *cells = grid.cellRow(r);
+  uint16_t *ages = grid.ageRow(r);
+
+  for (int w = 0; w < wordsPerRow; ++w) {
+    const int base = w * 64;
+    const int bits = std::min(64, cols - base);
+    uint64_t prev[kStatePlanes], next[kStatePlanes];
+    uint64_t advanced = 0, wasDead = ~0ULL, isDead = ~0ULL;
+    for (int i = 0; i < kStatePlanes; ++i) {
+      prev[i] = planes[i].rowData(r)[w];
+      next[i] = nextPlanes[i].rowData(r)[w];
+      advanced |= prev[i] ^ next[i];
+      wasDead &= ~prev[i];
+      isDead &= ~next[i];
+    }
+
+    // Spread the planes to one byte per cell, 8 cells per table lookup,
+    // then write states and ages in a plain (vectorized) loop. Advanced
+    // cells restart at age 1, the rest age (saturating).
+    uint64_t states[8], restart[8];
+    for (int g = 0; g < 8; ++g) {
+      states[g] = 0;
+      for (int i = 0; i < kStatePlanes; ++i)
+        states[g] |= kSpread(next[i], g) << i;
+      restart[g] = kSpread(advanced, g);
+    }
+    uint8_t stateBytes[64], restartBytes[64];
+    std::memcpy(stateBytes, states, sizeof(stateBytes));
+    std::memcpy(restartBytes, restart, sizeof(restartBytes));
+    std::memcpy(cells + base, stateBytes, static_cast<size_t>(bits));
+    uint16_t *wordAges = ages + base;
+    for (int b = 0; b < bits; ++b) {
+      const uint16_t age = wordAges[b];
+      wordAges[b] = restartBytes[b] ? 1 : age + (age < UINT16_MAX);
+    }
+    // State 0 is the only "dead" state
+    if (advanced != 0)
+      out.addWord(r, base, advanced & wasDead, advanced & isDead);
+  }
 }
 
 void CyclicCA::randomize(uint64_t seed, float density) {
   grid.clear();
+  packedStale = true;
   generation = 0;
   uint64_t state = seed ? seed : 1;
   (void)density; // Cyclic CA always fills all cells with random states
@@ -65,6 +151,7 @@ void CyclicCA::randomize(uint64_t seed, float density) {
 
 void CyclicCA::randomizeSymmetric(uint64_t seed, float density) {
   grid.clear();
+  packedStale = true;
   generation = 0;
   uint64_t state = seed ? seed : 1;
   (void)density;
@@ -90,5 +177,6 @@ void CyclicCA::randomizeSymmetric(uint64_t seed, float density) {
 
 void CyclicCA::clear() {
   grid.clear();
+  packedStale = true;
   generation = 0;
 }
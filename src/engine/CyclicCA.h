@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BitwiseGrid.h"
 #include "CellularEngine.h"
 #include "Grid.h"
 #include <cstdint>
@@ -7,9 +8,18 @@
 /// Cyclic Cellular Automaton: N-state predator/prey system.
 /// A cell advances to (state+1)%N if any Moore neighbor is at (state+1)%N.
 /// Produces expanding spiral waves with color variation per state.
+///
+/// The state is bit-sliced into kStatePlanes persistent bit planes, and
+/// LifeKernels::stepCyclic() tests "some neighbor holds the successor" for
+/// 64 cells per word (256 with AVX2). The grid is updated from the planes.
 class CyclicCA final : public CellularEngine {
 public:
   static constexpr int kNumStates = 6;
+  /// Bit planes per state: state = sum of plane i << i.
+  static constexpr int kStatePlanes = 3;
+  static_assert(kNumStates <= (1 << kStatePlanes) &&
+                    kStatePlanes <= BitwiseGrid::kMaxStatePlanes,
+                "kStatePlanes must hold every state");
 
   explicit CyclicCA(int rows = 12, int cols = 16);
 
@@ -20,14 +30,33 @@ public:
   void randomizeSymmetric(uint64_t seed, float density) override;
   void clear() override;
   const Grid &getGrid() const override { return grid; }
-  Grid &getGridMutable() override { return grid; }
+  /// Mutable access invalidates the state planes (re-packed on next step).
+  Grid &getGridMutable() override {
+    packedStale = true;
+    return grid;
+  }
   uint64_t getGeneration() const override { return generation; }
   const char *getName() const override { return "Cyclic CA"; }
   int getDefaultTriggerBudget() const override { return 5; }
   float getGainScale() const override { return 0.5f; }
 
 private:
+  /// Size the persistent planes to the grid (allocates only when dimensions
+  /// change).
+  void preparePacked();
+
+  /// Rebuild rows [rowBegin, rowEnd) of the state planes from grid cells.
+  void packFromGrid(int rowBegin, int rowEnd);
+
+  /// Write the cells that advanced in row r back into the grid and age the
+  /// rest.
+  void unpackRow(int r, CellEventList::Writer &out);
+
   Grid grid;
-  Grid scratch;
   uint64_t generation = 0;
+
+  // Current state planes and the ones step() writes
+  BitwiseGrid planes[kStatePlanes];
+  BitwiseGrid nextPlanes[kStatePlanes];
+  bool packedStale = true;
 };
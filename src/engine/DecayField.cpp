@@ -0,0 +1,173 @@
+#include "DecayField.h"
+
+DecayField::DecayField(int r, int c, float decayFactor, float deposit,
+                       float projectThreshold)
+    : rows(r), cols(c), decay(decayFactor), depositAmount(deposit),
+      threshold(projectThreshold),
+      energy(static_cast<size_t>(r) * c, 0.0f),
+      stamp(static_cast<size_t>(r) * c, 0),
+      hits(static_cast<size_t>(r) * c, 0) {
+  // Stored values are at most 1, so past the table every cell reads 0
+  for (float p = 1.0f; p >= kCutoff; p *= decay)
+    decayPow.push_back(p);
+  // A sparse pass has (deposits + live cells) * kListCost < rows * cols
+  const size_t listCapacity = static_cast<size_t>(r) * c / kListCost + 1;
+  touched.reserve(listCapacity);
+  alive.reserve(listCapacity);
+}
+
+void DecayField::materialize(float *out) const {
+  const int n = rows * cols;
+  for (int c = 0; c < n; ++c)
+    out[c] = valueAt(c, now);
+}
+
+void DecayField::clear() {
+  std::fill(energy.begin(), energy.end(), 0.0f);
+  std::fill(stamp.begin(), stamp.end(), 0);
+  std::fill(hits.begin(), hits.end(), 0);
+  touched.clear();
+  alive.clear();
+  now = 0;
+  denseStamp = 0;
+  aliveValid = false;
+  aliveCount = 0;
+}
+
+bool DecayField::beginStep(int deposits, const Grid &grid) {
+  const int64_t listWork =
+      (static_cast<int64_t>(deposits) + aliveCount) * kListCost;
+  denseStep = listWork >= static_cast<int64_t>(rows) * cols;
+  if (!denseStep && !aliveValid) {
+    // After a dense pass or an edit: collect the live cells once
+    alive.clear();
+    const uint8_t *cells = grid.cellRow(0);
+    for (int c = 0, n = rows * cols; c < n; ++c)
+      if (cells[c] != 0)
+        alive.push_back(c);
+    aliveValid = true;
+  }
+  return denseStep;
+}
+
+void DecayField::stepRows(int rowBegin, int rowEnd, uint8_t *const *planes,
+                          int numPlanes, Grid &grid,
+                          CellEventList::Writer &out) {
+  // Locals: the byte and float stores below may alias members
+  const int n = cols;
+  const float d = decay, amount = depositAmount;
+  const bool current = denseStamp == now; // last pass was dense too
+  int live = 0;
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const size_t offset = static_cast<size_t>(r) * n;
+    // The band owns these rows of every plane: sum into the first
+    uint8_t *h = planes[0] + offset;
+    for (int p = 1; p < numPlanes; ++p) {
+      uint8_t *plane = planes[p] + offset;
+      for (int c = 0; c < n; ++c)
+        h[c] = static_cast<uint8_t>(h[c] + plane[c]);
+      std::fill(plane, plane + n, 0);
+    }
+    float *row = &energy[offset];
+    if (!current)
+      for (int c = 0; c < n; ++c)
+        row[c] = valueAt(static_cast<int>(offset) + c, now);
+    // Each deposit clamps at 1, so one clamp after all of them gives the
+    // same value (decayed first: min(1, x) * decay as written keeps GCC
+    // from vectorizing)
+    for (int c = 0; c < n; ++c) {
+      const float decayed = (row[c] + static_cast<float>(h[c]) * amount) * d;
+      const float e = std::min(d, decayed);
+      row[c] = e < kCutoff ? 0.0f : e;
+    }
+    std::fill(h, h + n, 0);
+    live += projectRow(r, [row](int col) { return row[col]; }, grid, out);
+  }
+  denseAlive.fetch_add(live, std::memory_order_relaxed);
+}
+
+void DecayField::stepSparse(Grid &grid, CellEventList::Writer &out) {
+  const uint32_t next = now + 1;
+  uint8_t *cells = grid.cellRow(0);
+  uint16_t *ages = grid.ageRow(0);
+
+  // Deposits: read the lazy value, add, decay, restamp
+  for (int c : touched) {
+    const int h = hits[static_cast<size_t>(c)];
+    hits[static_cast<size_t>(c)] = 0;
+    const float e = std::min(
+        decay, (valueAt(c, now) + static_cast<float>(h) * depositAmount) *
+                   decay);
+    energy[static_cast<size_t>(c)] = e < kCutoff ? 0.0f : e;
+    stamp[static_cast<size_t>(c)] = next;
+    if (e > threshold && cells[c] == 0) {
+      out.add(c / cols, c % cols, CellEvent::Birth, e);
+      cells[c] = 1;
+      alive.push_back(c);
+    }
+  }
+  touched.clear();
+
+  // Live cells: age, or retire at or under the threshold
+  for (size_t i = 0; i < alive.size();) {
+    const int c = alive[i];
+    const float e = valueAt(c, next);
+    if (e > threshold) {
+      ages[c] = static_cast<uint16_t>(e * 255.0f);
+      ++i;
+      continue;
+    }
+    if (cells[c] != 0)
+      out.add(c / cols, c % cols, CellEvent::Death, e);
+    cells[c] = 0;
+    ages[c] = 0;
+    alive[i] = alive.back();
+    alive.pop_back();
+  }
+}
+
+void DecayField::endStep() {
+  ++now;
+  lastDense = denseStep;
+  if (denseStep) {
+    denseStamp = now;
+    aliveCount = denseAlive.exchange(0, std::memory_order_relaxed);
+    aliveValid = false;
+  } else {
+    aliveCount = static_cast<int>(alive.size());
+  }
+}
+
+void DecayField::projectRows(int rowBegin, int rowEnd, Grid &grid,
+                             CellEventList::Writer &out) const {
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const int offset = r * cols;
+    projectRow(
+        r, [this, offset](int col) { return valueAt(offset + col, now); },
+        grid, out);
+  }
+}
+
+template <typename Values>
+int DecayField::projectRow(int r, Values values, Grid &grid,
+                           CellEventList::Writer &out) const {
+  uint8_t *cells = grid.cellRow(r);
+  uint16_t *ages = grid.ageRow(r);
+  int live = 0;
+  for (int c = 0; c < cols; ++c) {
+    const float e = values(c);
+    if (e > threshold) {
+      if (cells[c] == 0)
+        out.add(r, c, CellEvent::Birth, e);
+      cells[c] = 1;
+      ages[c] = static_cast<uint16_t>(e * 255.0f);
+      ++live;
+    } else {
+      if (cells[c] != 0)
+        out.add(r, c, CellEvent::Death, e);
+      cells[c] = 0;
+      ages[c] = 0;
+    }
+  }
+  return live;
+}
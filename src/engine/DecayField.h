@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CellEvents.h"
+#include "Grid.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// Float field that decays by a constant factor every generation and takes
+/// point deposits (Brownian Field energy, Particle Swarm trails), projected
+/// onto a Grid: value > threshold -> alive, age = value * 255.
+///
+/// Decay is applied lazily. Each cell keeps its value as of the generation
+/// it was last written (its stamp). A read multiplies by decay^(now - stamp)
+/// from a table, and values under kCutoff read as 0. A sparse generation
+/// then only touches the cells that receive deposits and the live cells
+/// (kept in a list, to age them and catch threshold crossings), so its
+/// cost follows the activity, not rows x cols.
+///
+/// When deposits and live cells cover much of the grid, a list costs more
+/// than a row pass, and beginStep() picks a dense banded pass (stepRows())
+/// instead. A dense pass leaves every cell current, so the next one
+/// multiplies directly without the table.
+///
+/// One generation:
+///   dense = field.beginStep(deposits, grid);
+///   addHit() per deposit (or per-band hit planes for stepRows());
+///   stepRows() over row bands if dense, else stepSparse();
+///   field.endStep();
+class DecayField {
+public:
+  /// Values below this read as 0.
+  static constexpr float kCutoff = 0.01f;
+
+  /// @param decay          factor per generation, in (0, 1)
+  /// @param depositAmount  added per hit; the sum clamps at 1
+  /// @param threshold      projection: value > threshold -> alive
+  DecayField(int rows, int cols, float decay, float depositAmount,
+             float threshold);
+
+  int getRows() const { return rows; }
+  int getCols() const { return cols; }
+
+  /// Value of a cell (row * cols + col) at the current generation.
+  float value(int cell) const { return valueAt(cell, now); }
+
+  /// All values at the current generation, row-major (rows * cols).
+  void materialize(float *out) const;
+
+  /// Zero every cell. The caller projects or clears the grid.
+  void clear();
+
+  /// The grid was edited outside step(): rebuild the live list from it
+  /// before the next sparse pass.
+  void markGridStale() { aliveValid = false; }
+
+  // --- One generation ---
+
+  /// Pick the pass for the next generation from the expected number of
+  /// deposits. Returns true for a dense pass (stepRows()).
+  bool beginStep(int deposits, const Grid &grid);
+
+  /// Count a deposit into getHitPlane() (saturating: two fill a cell).
+  /// Not thread-safe.
+  void addHit(int cell) {
+    uint8_t &h = hits[static_cast<size_t>(cell)];
+    if (h == 0 && !denseStep)
+      touched.push_back(cell);
+    h = static_cast<uint8_t>(h + (h < 2));
+  }
+
+  /// The rows x cols hit counts addHit() fills; pass it to stepRows().
+  uint8_t *getHitPlane() { return hits.data(); }
+
+  /// Dense pass over rows [rowBegin, rowEnd): sums the hit counts of every
+  /// plane into the first, deposits, decays, projects and zeroes the
+  /// planes. Row bands may run concurrently.
+  void stepRows(int rowBegin, int rowEnd, uint8_t *const *planes,
+                int numPlanes, Grid &grid, CellEventList::Writer &out);
+
+  /// Sparse pass: deposits from addHit(), then ages the live cells and
+  /// retires those at or under the threshold.
+  void stepSparse(Grid &grid, CellEventList::Writer &out);
+
+  void endStep();
+
+  /// Project rows [rowBegin, rowEnd) onto the grid without stepping.
+  void projectRows(int rowBegin, int rowEnd, Grid &grid,
+                   CellEventList::Writer &out) const;
+
+  /// Live cells after the last step (tests, diagnostics).
+  int getAliveCount() const { return aliveCount; }
+  /// True if the last step ran the dense pass (tests, benchmarks).
+  bool lastStepWasDense() const { return lastDense; }
+
+private:
+  /// Project row r, reading column c as values(c); returns its live cells.
+  template <typename Values>
+  int projectRow(int r, Values values, Grid &grid,
+                 CellEventList::Writer &out) const;
+
+  float valueAt(int cell, uint32_t generation) const {
+    const uint32_t written = std::max(stamp[static_cast<size_t>(cell)],
+                                      denseStamp);
+    const uint32_t lag = generation - written;
+    if (lag >= decayPow.size())
+      return 0.0f;
+    const float v = energy[static_cast<size_t>(cell)] * decayPow[lag];
+    return v < kCutoff ? 0.0f : v;
+  }
+
+  // Relative cost of a list entry against one cell of a dense pass
+  static constexpr int kListCost = 8;
+
+  int rows, cols;
+  float decay, depositAmount, threshold;
+
+  std::vector<float> energy;   // value as of max(stamp, denseStamp)
+  std::vector<uint32_t> stamp; // generation of the last sparse write
+  std::vector<float> decayPow; // decay^lag until it drops under kCutoff
+  std::vector<uint8_t> hits;   // addHit() counts, all zero between steps
+  // Both stay under rows * cols / kListCost in a sparse pass: reserved
+  std::vector<int> touched; // cells with hits (sparse pass)
+  std::vector<int> alive;   // live cells (sparse pass)
+
+  uint32_t now = 0;
+  uint32_t denseStamp = 0; // every cell was written by the dense pass then
+  bool denseStep = true;
+  bool lastDense = true;
+  bool aliveValid = false; // alive matches the grid
+  int aliveCount = 0;
+  std::atomic<int> denseAlive{0};
+};
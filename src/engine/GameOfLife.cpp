@@ -1,4 +1,6 @@
 #include "GameOfLife.h"
+#include "LifeKernels.h"
+#include <algorithm>
 
 // --- Simple xorshift64 PRNG (allocation-free, deterministic) ---
 namespace {
@@ -23,43 +25,51 @@ static constexpr uint16_t makeBitmask(std::initializer_list<int> counts) {
 GameOfLife::GameOfLife(int rows, int cols, RulePreset preset)
     : grid(rows, cols), scratch(rows, cols) {
   applyPreset(preset);
+  if (grid.getRows() * grid.getCols() >= kBitwiseThreshold)
+    preparePacked();
 }
 
-void GameOfLife::applyPreset(RulePreset preset) {
-  currentPreset = preset;
+void GameOfLife::getPresetRules(RulePreset preset, uint16_t &birth,
+                                uint16_t &survival) {
   switch (preset) {
   case RulePreset::Classic: // B3/S23
-    birthRule = makeBitmask({3});
-    survivalRule = makeBitmask({2, 3});
+    birth = makeBitmask({3});
+    survival = makeBitmask({2, 3});
     break;
   case RulePreset::HighLife: // B36/S23
-    birthRule = makeBitmask({3, 6});
-    survivalRule = makeBitmask({2, 3});
+    birth = makeBitmask({3, 6});
+    survival = makeBitmask({2, 3});
     break;
   case RulePreset::DayAndNight: // B3678/S34678
-    birthRule = makeBitmask({3, 6, 7, 8});
-    survivalRule = makeBitmask({3, 4, 6, 7, 8});
+    birth = makeBitmask({3, 6, 7, 8});
+    survival = makeBitmask({3, 4, 6, 7, 8});
     break;
   case RulePreset::Seeds: // B2/S (nothing survives)
-    birthRule = makeBitmask({2});
-    survivalRule = 0;
+    birth = makeBitmask({2});
+    survival = 0;
     break;
   case RulePreset::Ambient: // B3/S2345 (high survival, slow decay)
-    birthRule = makeBitmask({3});
-    survivalRule = makeBitmask({2, 3, 4, 5});
+    birth = makeBitmask({3});
+    survival = makeBitmask({2, 3, 4, 5});
     break;
   default:
-    birthRule = makeBitmask({3});
-    survivalRule = makeBitmask({2, 3});
+    birth = makeBitmask({3});
+    survival = makeBitmask({2, 3});
     break;
   }
 }
 
+void GameOfLife::applyPreset(RulePreset preset) {
+  currentPreset = preset;
+  getPresetRules(preset, birthRule, survivalRule);
+}
+
 void GameOfLife::setRulePreset(RulePreset preset) { applyPreset(preset); }
 
 void GameOfLife::step() {
   const int rows = grid.getRows();
   const int cols = grid.getCols();
+  events.reset(rows, cols);
 
   // Use bitwise-packed step for large grids
   if (rows * cols >= kBitwiseThreshold) {
@@ -67,8 +77,12 @@ void GameOfLife::step() {
     return;
   }
 
-  scratch.resize(rows, cols);
+  // Every cell of the back buffer is overwritten below: only resize (and
+  // clear) it when the grid dimensions changed.
+  if (scratch.getRows() != rows || scratch.getCols() != cols)
+    scratch.resize(rows, cols);
 
+  CellEventList::Writer out(events);
   for (int r = 0; r < rows; ++r) {
     for (int c = 0; c < cols; ++c) {
       int neighbors = countNeighbors(r, c);
@@ -79,6 +93,7 @@ void GameOfLife::step() {
         if (birthRule & (1 << neighbors)) {
           scratch.setCell(r, c, 1);
           scratch.setAge(r, c, 1);
+          out.add(r, c, CellEvent::Birth, 1.0f);
         } else {
           scratch.setCell(r, c, 0);
           scratch.setAge(r, c, 0);
@@ -93,13 +108,16 @@ void GameOfLife::step() {
         } else {
           scratch.setCell(r, c, 0);
           scratch.setAge(r, c, 0);
+          out.add(r, c, CellEvent::Death, 0.0f);
         }
       }
     }
   }
+  out.flush();
 
-  // Swap scratch into grid (memcpy, no allocation)
-  grid.copyFrom(scratch);
+  // Publish the back buffer (pointer swap, no copy)
+  grid.swapBuffers(scratch);
+  packedStale = true;
   ++generation;
 }
 
@@ -107,82 +125,151 @@ void GameOfLife::stepBitwise() {
   const int rows = grid.getRows();
   const int cols = grid.getCols();
 
-  // Pack current grid into bitwise representation
-  BitwiseGrid packed;
-  packed.resize(rows, cols);
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      if (grid.getCell(r, c) > 0)
-        packed.setCell(r, c, true);
+  preparePacked();
+  if (packedStale) {
+    forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+      packFromGrid(rowBegin, rowEnd);
+    });
+    liveTiles.scan(packed);
+    // The back buffer holds an unknown generation: empty all of it
+    liveTilesNext.fill(true);
+    packedStale = false;
+  }
+
+  // A tile can only change if it has a live cell or a neighbor tile has one
+  // on their shared border, unless the rule gives birth on zero neighbors
+  // (B0, no preset does).
+  if (tileSkipping && (birthRule & 1) == 0)
+    activeTiles.markActiveFrom(liveTiles);
+  else
+    activeTiles.fill(true);
+
+  // Each band advances whole tile rows (AVX-512 / AVX2 / scalar, picked at
+  // runtime) and unpacks them. Unpacking writes only grid rows of the same
+  // band, and the halo rows above/below are read from the untouched packed
+  // grid.
+  forEachRowBand(liveTiles.getTileRows(), cols * TileActivity::kTileSize,
+                 [&](int tileRowBegin, int tileRowEnd) {
+                   CellEventList::Writer out(events);
+                   for (int tr = tileRowBegin; tr < tileRowEnd; ++tr) {
+                     stepTileRow(tr);
+                     unpackTileRow(tr, out);
+                   }
+                 });
+
+  packed.swap(packedNext);
+  liveTiles.swap(liveTilesNext);
+  ++generation;
+}
+
+void GameOfLife::stepTileRow(int tr) {
+  const int tileCols = liveTiles.getTileCols();
+  const int rowBegin = tr * TileActivity::kTileSize;
+  const int rowEnd =
+      std::min(grid.getRows(), rowBegin + TileActivity::kTileSize);
+  const uint8_t *active = activeTiles.tileRow(tr);
+  uint8_t *liveNext = liveTilesNext.tileRow(tr);
+
+  for (int tc = 0; tc < tileCols;) {
+    if (!active[tc]) {
+      // Stays empty; the back buffer may still hold an older generation
+      if (liveNext[tc]) {
+        TileActivity::clearTile(packedNext, tr, tc);
+        liveNext[tc] = 0;
+      }
+      ++tc;
+      continue;
     }
+    // One kernel call per run of adjacent active tiles
+    int runEnd = tc + 1;
+    while (runEnd < tileCols && active[runEnd])
+      ++runEnd;
+    LifeKernels::stepLife(packed, packedNext, birthRule, survivalRule,
+                          rowBegin, rowEnd, tc, runEnd);
+    for (; tc < runEnd; ++tc)
+      liveNext[tc] = TileActivity::tileFlags(packedNext, tr, tc);
   }
+}
 
-  BitwiseGrid next;
-  next.resize(rows, cols);
+void GameOfLife::preparePacked() {
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  if (packed.getRows() != rows || packed.getCols() != cols) {
+    packed.resize(rows, cols);
+    packedNext.resize(rows, cols);
+    liveTiles.resize(rows, cols);
+    liveTilesNext.resize(rows, cols);
+    activeTiles.resize(rows, cols);
+    packedStale = true;
+  }
+}
 
-  // Process each word (64 cells at a time)
-  int wordsPerRow = packed.getWordsPerRow();
-  for (int r = 0; r < rows; ++r) {
-    // Toroidal row indices
-    int rAbove = (r - 1 + rows) % rows;
-    int rBelow = (r + 1) % rows;
-    const uint64_t *rowAbove = packed.rowData(rAbove);
-    const uint64_t *rowSame = packed.rowData(r);
-    const uint64_t *rowBelow = packed.rowData(rBelow);
+void GameOfLife::packFromGrid(int rowBegin, int rowEnd) {
+  const int cols = grid.getCols();
+  const int wordsPerRow = packed.getWordsPerRow();
 
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const uint8_t *cells = grid.cellRow(r);
+    uint64_t *words = packed.rowData(r);
     for (int w = 0; w < wordsPerRow; ++w) {
-      uint8_t counts[64];
-      BitwiseGrid::countNeighbors64(rowAbove, rowSame, rowBelow, w, wordsPerRow,
-                                    cols, counts);
-
-      // Apply rules for each bit position
-      int bitsInWord = cols - w * 64;
-      if (bitsInWord > 64)
-        bitsInWord = 64;
-
-      for (int b = 0; b < bitsInWord; ++b) {
-        int c = w * 64 + b;
-        bool alive = packed.getCell(r, c);
-        int n = counts[b];
-
-        if (!alive && (birthRule & (1 << n))) {
-          next.setCell(r, c, true);
-        } else if (alive && (survivalRule & (1 << n))) {
-          next.setCell(r, c, true);
-        }
-        // else: stays dead (already 0)
-      }
+      const int base = w * 64;
+      const int bits = std::min(64, cols - base);
+      uint64_t word = 0;
+      for (int b = 0; b < bits; ++b)
+        word |= static_cast<uint64_t>(cells[base + b] != 0) << b;
+      words[w] = word;
     }
   }
+}
 
-  // Unpack back to Grid, updating ages
-  scratch.resize(rows, cols);
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      bool wasAlive = grid.getCell(r, c) > 0;
-      bool isAlive = next.getCell(r, c);
+void GameOfLife::unpackTileRow(int tr, CellEventList::Writer &out) {
+  const int cols = grid.getCols();
+  const int wordsPerRow = packed.getWordsPerRow();
+  const int rowBegin = tr * TileActivity::kTileSize;
+  const int rowEnd =
+      std::min(grid.getRows(), rowBegin + TileActivity::kTileSize);
+  // Tiles empty before and after: cells and ages are already zero
+  const uint8_t *livePrev = liveTiles.tileRow(tr);
+  const uint8_t *liveNext = liveTilesNext.tileRow(tr);
+
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const uint64_t *prevWords = packed.rowData(r);
+    const uint64_t *nextWords = packedNext.rowData(r);
+    uint8_t *cells = grid.cellRow(r);
+    uint16_t *ages = grid.ageRow(r);
 
-      if (isAlive) {
-        scratch.setCell(r, c, 1);
-        if (wasAlive) {
-          uint16_t age = grid.getAge(r, c);
-          scratch.setAge(r, c, age < UINT16_MAX ? age + 1 : age);
-        } else {
-          scratch.setAge(r, c, 1);
-        }
-      } else {
-        scratch.setCell(r, c, 0);
-        scratch.setAge(r, c, 0);
+    for (int w = 0; w < wordsPerRow; ++w) {
+      if (!(livePrev[w] | liveNext[w]))
+        continue;
+      const uint64_t prev = prevWords[w];
+      const uint64_t next = nextWords[w];
+      // Dead before and after: cells and ages are already zero
+      if ((prev | next) == 0)
+        continue;
+
+      const int base = w * 64;
+      const int bits = std::min(64, cols - base);
+      const uint64_t valid = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+      out.addWord(r, base, next & ~prev & valid, prev & ~next & valid);
+      for (int b = 0; b < bits; ++b) {
+        const bool isAlive = (next >> b) & 1ULL;
+        const bool wasAlive = (prev >> b) & 1ULL;
+        uint16_t &age = ages[base + b];
+        cells[base + b] = isAlive ? 1 : 0;
+        if (!isAlive)
+          age = 0;
+        else if (!wasAlive)
+          age = 1;
+        else if (age < UINT16_MAX)
+          ++age;
       }
     }
   }
-
-  grid.copyFrom(scratch);
-  ++generation;
 }
 
 void GameOfLife::randomize(uint64_t seed, float density) {
   grid.clear();
+  packedStale = true;
   generation = 0;
 
   uint64_t state = seed;
@@ -207,6 +294,7 @@ void GameOfLife::randomize(uint64_t seed, float density) {
 
 void GameOfLife::randomizeSymmetric(uint64_t seed, float density) {
   grid.clear();
+  packedStale = true;
   generation = 0;
 
   uint64_t state = seed;
@@ -242,12 +330,14 @@ void GameOfLife::randomizeSymmetric(uint64_t seed, float density) {
 
 void GameOfLife::clear() {
   grid.clear();
+  packedStale = true;
   generation = 0;
 }
 
 void GameOfLife::loadPattern(const int (*cells)[2], int count, int originRow,
                              int originCol) {
   grid.clear();
+  packedStale = true;
   generation = 0;
 
   for (int i = 0; i < count; ++i) {
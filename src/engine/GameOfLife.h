@@ -3,6 +3,7 @@
 #include "BitwiseGrid.h"
 #include "CellularEngine.h"
 #include "Grid.h"
+#include "TileActivity.h"
 #include <cstdint>
 
 
@@ -35,14 +36,31 @@ public:
   void randomizeSymmetric(uint64_t seed, float density) override;
   void clear() override;
   const Grid &getGrid() const override { return grid; }
-  Grid &getGridMutable() override { return grid; }
+  /// Mutable access invalidates the packed copy (re-packed on next step).
+  Grid &getGridMutable() override {
+    packedStale = true;
+    return grid;
+  }
   uint64_t getGeneration() const override { return generation; }
   const char *getName() const override { return "Game of Life"; }
+  const TileActivity *getLiveTiles() const override {
+    return packedStale ? nullptr : &liveTiles;
+  }
 
   // --- GoL-specific ---
   void setRulePreset(RulePreset preset);
   RulePreset getRulePreset() const { return currentPreset; }
 
+  /// Birth/survival bitmasks of a preset (bit N set = N neighbors
+  /// triggers). Shared with HashLife.
+  static void getPresetRules(RulePreset preset, uint16_t &birth,
+                             uint16_t &survival);
+
+  /// Skip 64x64 tiles with no live cell in their tile neighborhood (on by
+  /// default; off steps every tile, for benchmarks and parity tests).
+  void setTileSkipping(bool enabled) { tileSkipping = enabled; }
+  bool getTileSkipping() const { return tileSkipping; }
+
   /// Load a known pattern at given offset.
   /// Pattern data is a vector of {row, col} offsets relative to origin.
   void loadPattern(const int (*cells)[2], int count, int originRow,
@@ -55,6 +73,22 @@ private:
   /// Bitwise-packed step for large grids (>= 128x128)
   void stepBitwise();
 
+  /// Size the persistent packed buffers to the grid (allocates only when
+  /// dimensions change).
+  void preparePacked();
+
+  /// Rebuild rows [rowBegin, rowEnd) of the packed grid from grid cells
+  /// (word-at-a-time, no allocation).
+  void packFromGrid(int rowBegin, int rowEnd);
+
+  /// Advance the active tiles of tile row tr into packedNext, empty its
+  /// inactive ones, and update liveTilesNext.
+  void stepTileRow(int tr);
+
+  /// Write tile row tr of the next packed generation back into grid cells
+  /// and ages (only tiles live before or after the step).
+  void unpackTileRow(int tr, CellEventList::Writer &out);
+
   /// Threshold for using bitwise step
   static constexpr int kBitwiseThreshold = 128 * 128;
 
@@ -67,6 +101,19 @@ private:
 
   Grid grid;
   Grid scratch; // Pre-allocated scratch grid for next generation
+
+  // Persistent bit-packed state for the bitwise path. `packed` mirrors grid
+  // cells between steps unless packedStale is set by an external edit.
+  BitwiseGrid packed;
+  BitwiseGrid packedNext;
+  bool packedStale = true;
+
+  // Tile occupancy of packed / packedNext (supersets: a set tile may be
+  // empty, a clear tile is all zero) and this step's tiles to advance.
+  TileActivity liveTiles;
+  TileActivity liveTilesNext;
+  TileActivity activeTiles;
+  bool tileSkipping = true;
   uint64_t generation = 0;
   RulePreset currentPreset = RulePreset::Classic;
 };
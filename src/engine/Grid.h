@@ -3,10 +3,14 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <utility>
 #include <vector>
 
 /// Grid data structure for cellular automata.
 /// Stores cell state (uint8) and cell age (uint16) in row-major order.
+/// Storage is sized to the actual dimensions: row stride == getCols(), and
+/// memory is only (re)allocated by the constructor, resize() to a larger
+/// size than ever reserved, or copyFrom() of a larger grid.
 /// Supports double-buffering: audio thread owns the working grid,
 /// swaps a snapshot for the GL thread to read.
 class Grid {
@@ -15,69 +19,112 @@ public:
   static constexpr int kMaxCols = 1280;
   static constexpr int kMaxCells = kMaxRows * kMaxCols;
 
-  Grid() : cells(kMaxCells, 0), prevCells(kMaxCells, 0), ages(kMaxCells, 0) {}
+  Grid() { allocate(); }
 
-  Grid(int rows, int cols)
-      : numRows(rows), numCols(cols), cells(kMaxCells, 0),
-        prevCells(kMaxCells, 0), ages(kMaxCells, 0) {
+  Grid(int rows, int cols) : numRows(rows), numCols(cols) {
     clampDimensions();
+    allocate();
   }
 
   // --- Dimensions ---
   int getRows() const { return numRows; }
   int getCols() const { return numCols; }
 
+  /// Distance between consecutive rows in cellRow()/ageRow() (== getCols()).
+  int getStride() const { return numCols; }
+
+  /// Change dimensions and clear all cells. Only allocates when the new
+  /// size exceeds the current capacity (see reserve()).
   void resize(int rows, int cols) {
     numRows = rows;
     numCols = cols;
     clampDimensions();
+    allocate();
     clear();
   }
 
+  /// Pre-allocate capacity for up to rows x cols cells without changing
+  /// the dimensions, so later resize() calls up to that size never allocate
+  /// (e.g. grids resized on the audio thread). Untouched capacity is not
+  /// committed by the OS, so this costs address space, not resident memory.
+  void reserve(int rows, int cols) {
+    const size_t n = static_cast<size_t>(std::clamp(rows, 1, kMaxRows)) *
+                     static_cast<size_t>(std::clamp(cols, 1, kMaxCols));
+    cells.reserve(n);
+    prevCells.reserve(n);
+    ages.reserve(n);
+  }
+
   // --- Cell State Access ---
   uint8_t getCell(int row, int col) const {
-    return cells[wrapRow(row) * kMaxCols + wrapCol(col)];
+    return cells[wrapRow(row) * numCols + wrapCol(col)];
   }
 
   void setCell(int row, int col, uint8_t value) {
-    cells[wrapRow(row) * kMaxCols + wrapCol(col)] = value;
+    cells[wrapRow(row) * numCols + wrapCol(col)] = value;
   }
 
   // --- Cell Age Access ---
   uint16_t getAge(int row, int col) const {
-    return ages[wrapRow(row) * kMaxCols + wrapCol(col)];
+    return ages[wrapRow(row) * numCols + wrapCol(col)];
   }
 
   void setAge(int row, int col, uint16_t value) {
-    ages[wrapRow(row) * kMaxCols + wrapCol(col)] = value;
+    ages[wrapRow(row) * numCols + wrapCol(col)] = value;
   }
 
   void incrementAge(int row, int col) {
-    auto &a = ages[wrapRow(row) * kMaxCols + wrapCol(col)];
+    auto &a = ages[wrapRow(row) * numCols + wrapCol(col)];
     if (a < UINT16_MAX)
       ++a;
   }
 
+  // --- Raw Row Access (bulk engine passes) ---
+  // No wrapping: row must be in [0, rows). Row r spans getCols() entries.
+  const uint8_t *cellRow(int row) const { return &cells[row * numCols]; }
+  uint8_t *cellRow(int row) { return &cells[row * numCols]; }
+  const uint16_t *ageRow(int row) const { return &ages[row * numCols]; }
+  uint16_t *ageRow(int row) { return &ages[row * numCols]; }
+
   // --- Bulk Operations ---
   void clear() {
     std::fill(cells.begin(), cells.end(), 0);
     std::fill(ages.begin(), ages.end(), 0);
   }
 
+  /// Copy dimensions, cells and ages (previous-generation state is kept
+  /// if the size matches, cleared otherwise).
   void copyFrom(const Grid &other) {
+    const bool sameSize = cells.size() == other.cells.size();
     numRows = other.numRows;
     numCols = other.numCols;
     cells = other.cells;
     ages = other.ages;
+    if (!sameSize)
+      prevCells.assign(cells.size(), 0);
+  }
+
+  /// Exchange cell and age storage (and dimensions) with another grid in
+  /// O(1). Engines compute the next generation into a back grid and swap it
+  /// in instead of copying. Previous-generation state (snapshotPrev) stays
+  /// with each grid.
+  void swapBuffers(Grid &other) noexcept {
+    std::swap(numRows, other.numRows);
+    std::swap(numCols, other.numCols);
+    cells.swap(other.cells);
+    ages.swap(other.ages);
+    if (prevCells.size() != cells.size())
+      prevCells.assign(cells.size(), 0);
+    if (other.prevCells.size() != other.cells.size())
+      other.prevCells.assign(other.cells.size(), 0);
   }
 
   /// Count total alive cells (state > 0).
   int countAlive() const {
     int count = 0;
-    for (int r = 0; r < numRows; ++r)
-      for (int c = 0; c < numCols; ++c)
-        if (cells[r * kMaxCols + c] > 0)
-          ++count;
+    for (uint8_t cell : cells)
+      if (cell > 0)
+        ++count;
     return count;
   }
 
@@ -91,11 +138,7 @@ public:
   bool operator==(const Grid &other) const {
     if (numRows != other.numRows || numCols != other.numCols)
       return false;
-    for (int r = 0; r < numRows; ++r)
-      for (int c = 0; c < numCols; ++c)
-        if (cells[r * kMaxCols + c] != other.cells[r * kMaxCols + c])
-          return false;
-    return true;
+    return cells == other.cells;
   }
 
   bool operator!=(const Grid &other) const { return !(*this == other); }
@@ -113,27 +156,37 @@ public:
 
   // --- Event Detection (birth/death tracking) ---
   /// Call before engine step to snapshot current state.
-  void snapshotPrev() { prevCells = cells; }
+  void snapshotPrev() {
+    std::copy(cells.begin(), cells.end(), prevCells.begin());
+  }
 
   /// Cell was dead last step, alive now.
   bool wasBorn(int row, int col) const {
-    int idx = wrapRow(row) * kMaxCols + wrapCol(col);
+    int idx = wrapRow(row) * numCols + wrapCol(col);
     return prevCells[idx] == 0 && cells[idx] > 0;
   }
 
   /// Cell was alive last step, dead now.
   bool justDied(int row, int col) const {
-    int idx = wrapRow(row) * kMaxCols + wrapCol(col);
+    int idx = wrapRow(row) * numCols + wrapCol(col);
     return prevCells[idx] > 0 && cells[idx] == 0;
   }
 
   /// Cell was alive last step and still alive.
   bool persists(int row, int col) const {
-    int idx = wrapRow(row) * kMaxCols + wrapCol(col);
+    int idx = wrapRow(row) * numCols + wrapCol(col);
     return prevCells[idx] > 0 && cells[idx] > 0;
   }
 
 private:
+  /// Size storage to numRows x numCols (reuses capacity when possible).
+  void allocate() {
+    const size_t n = static_cast<size_t>(numRows) * numCols;
+    cells.resize(n, 0);
+    prevCells.resize(n, 0);
+    ages.resize(n, 0);
+  }
+
   void clampDimensions() {
     if (numRows < 1)
       numRows = 1;
@@ -148,7 +201,7 @@ private:
   int numRows = 12;
   int numCols = 16;
 
-  // Heap-allocated arrays sized to max capacity (safe for large grids).
+  // Heap-allocated arrays sized to numRows * numCols (stride numCols).
   std::vector<uint8_t> cells;
   std::vector<uint8_t> prevCells; // Previous generation for event detection
   std::vector<uint16_t> ages;
@@ -0,0 +1,10 @@
+#pragma once
+
+/// Grid resolution presets {rows, cols}, indexed by the "gridSize" parameter.
+/// Shared by the processor and the headless benchmarks.
+inline constexpr int kGridSizes[][2] = {
+    {8, 12},  {12, 16},   {16, 24},   {24, 32},   {32, 48},     {48, 64},
+    {64, 96}, {128, 128}, {256, 256}, {512, 512}, {1024, 1024}, {1280, 1280}};
+
+inline constexpr int kNumGridSizes =
+    static_cast<int>(sizeof(kGridSizes) / sizeof(kGridSizes[0]));
@@ -0,0 +1,329 @@
+#include "GridStateCodec.h"
+#include <cstring>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "GridStateCodec copies float fields in host byte order"
+#endif
+
+namespace {
+
+/// Appends little-endian values to a byte vector.
+class Writer {
+public:
+  explicit Writer(std::vector<uint8_t> &out) : out(out) {}
+
+  void u8(uint8_t v) { out.push_back(v); }
+  void u16(uint16_t v) {
+    u8(static_cast<uint8_t>(v));
+    u8(static_cast<uint8_t>(v >> 8));
+  }
+  void u32(uint32_t v) {
+    for (int i = 0; i < 4; ++i)
+      u8(static_cast<uint8_t>(v >> (8 * i)));
+  }
+  void varint(uint64_t v) {
+    while (v >= 0x80) {
+      u8(static_cast<uint8_t>(v | 0x80));
+      v >>= 7;
+    }
+    u8(static_cast<uint8_t>(v));
+  }
+  void bytes(const void *data, size_t n) {
+    const auto *b = static_cast<const uint8_t *>(data);
+    out.insert(out.end(), b, b + n);
+  }
+
+  /// Start a section prefixed with its u32 byte count; returns its offset.
+  size_t beginSection() {
+    const size_t at = out.size();
+    u32(0);
+    return at;
+  }
+  void endSection(size_t at) {
+    const auto n = static_cast<uint32_t>(out.size() - at - 4);
+    for (int i = 0; i < 4; ++i)
+      out[at + static_cast<size_t>(i)] = static_cast<uint8_t>(n >> (8 * i));
+  }
+
+private:
+  std::vector<uint8_t> &out;
+};
+
+/// Bounds-checked little-endian reads; every call fails once data runs out.
+class Reader {
+public:
+  Reader(const uint8_t *data, size_t size) : p(data), left(size) {}
+
+  bool u8(uint8_t &v) {
+    if (left < 1)
+      return false;
+    v = *p++;
+    --left;
+    return true;
+  }
+  bool u16(uint16_t &v) {
+    uint8_t lo, hi;
+    if (!u8(lo) || !u8(hi))
+      return false;
+    v = static_cast<uint16_t>(lo | (hi << 8));
+    return true;
+  }
+  bool u32(uint32_t &v) {
+    if (left < 4)
+      return false;
+    v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) |
+        (static_cast<uint32_t>(p[3]) << 24);
+    p += 4;
+    left -= 4;
+    return true;
+  }
+  bool varint(uint64_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t b;
+      if (!u8(b))
+        return false;
+      v |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if ((b & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+  bool bytes(void *dst, size_t n) {
+    if (left < n)
+      return false;
+    std::memcpy(dst, p, n);
+    return skip(n);
+  }
+  bool skip(size_t n) {
+    if (left < n)
+      return false;
+    p += n;
+    left -= n;
+    return true;
+  }
+  /// Split off the next u32-length-prefixed section.
+  bool section(Reader &sub) {
+    uint32_t n;
+    if (!u32(n) || left < n)
+      return false;
+    sub = Reader(p, n);
+    return skip(n);
+  }
+  bool atEnd() const { return left == 0; }
+
+private:
+  const uint8_t *p;
+  size_t left;
+};
+
+uint32_t zigzag(int32_t v) {
+  return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+int32_t unzigzag(uint32_t u) {
+  return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+}
+
+void writeRuns(Writer &w, const uint8_t *cells, size_t n) {
+  for (size_t i = 0; i < n;) {
+    size_t j = i + 1;
+    while (j < n && cells[j] == cells[i])
+      ++j;
+    w.varint(j - i);
+    w.u8(cells[i]);
+    i = j;
+  }
+}
+
+void writeBitPlane(Writer &w, const uint8_t *cells, size_t n) {
+  for (size_t i = 0; i < n; i += 8) {
+    uint8_t byte = 0;
+    const size_t end = std::min(n, i + 8);
+    for (size_t j = i; j < end; ++j)
+      byte |= static_cast<uint8_t>((cells[j] & 1) << (j - i));
+    w.u8(byte);
+  }
+}
+
+/// Runs of unchanged ages, each followed by one changed age as a zigzag
+/// delta; a final run (possibly empty) closes the plane.
+void writeAges(Writer &w, const uint16_t *ages, size_t n) {
+  int32_t prev = 0;
+  uint64_t unchanged = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const int32_t delta = static_cast<int32_t>(ages[i]) - prev;
+    if (delta == 0) {
+      ++unchanged;
+      continue;
+    }
+    w.varint(unchanged);
+    w.varint(zigzag(delta));
+    unchanged = 0;
+    prev = ages[i];
+  }
+  w.varint(unchanged);
+}
+
+bool readRuns(Reader r, uint8_t *cells, size_t n) {
+  for (size_t i = 0; i < n;) {
+    uint64_t len;
+    uint8_t value;
+    if (!r.varint(len) || !r.u8(value) || len == 0 || len > n - i)
+      return false;
+    std::memset(cells + i, value, static_cast<size_t>(len));
+    i += static_cast<size_t>(len);
+  }
+  return r.atEnd();
+}
+
+bool readBitPlane(Reader r, uint8_t *cells, size_t n) {
+  for (size_t i = 0; i < n; i += 8) {
+    uint8_t byte;
+    if (!r.u8(byte))
+      return false;
+    const size_t end = std::min(n, i + 8);
+    for (size_t j = i; j < end; ++j)
+      cells[j] = (byte >> (j - i)) & 1;
+  }
+  return r.atEnd();
+}
+
+bool readAges(Reader r, uint16_t *ages, size_t n) {
+  int32_t prev = 0;
+  for (size_t i = 0;;) {
+    uint64_t unchanged;
+    if (!r.varint(unchanged) || unchanged > n - i)
+      return false;
+    std::fill(ages + i, ages + i + unchanged, static_cast<uint16_t>(prev));
+    i += static_cast<size_t>(unchanged);
+    if (i == n)
+      return r.atEnd();
+
+    uint64_t zz;
+    if (!r.varint(zz) || zz > UINT32_MAX)
+      return false;
+    prev += unzigzag(static_cast<uint32_t>(zz));
+    if (prev < 0 || prev > UINT16_MAX)
+      return false;
+    ages[i++] = static_cast<uint16_t>(prev);
+  }
+}
+
+} // namespace
+
+void GridStateCodec::encode(const CellularEngine &engine,
+                            std::vector<uint8_t> &out) {
+  std::vector<const float *> fields(
+      static_cast<size_t>(engine.getNumFields()));
+  for (size_t f = 0; f < fields.size(); ++f)
+    fields[f] = engine.getField(static_cast<int>(f));
+  encode(engine.getType(), engine.getGrid(), fields.data(),
+         static_cast<int>(fields.size()), out);
+}
+
+void GridStateCodec::encode(EngineType type, const Grid &grid,
+                            const float *const *fields, int numFields,
+                            std::vector<uint8_t> &out) {
+  const size_t n = cellBytes(grid);
+  // Row stride == cols: each plane is one contiguous block
+  const uint8_t *cells = grid.cellRow(0);
+  const uint16_t *ages = grid.ageRow(0);
+
+  // Binary grids use the bit plane unless runs are smaller (sparse grids)
+  std::vector<uint8_t> runs;
+  Writer runWriter(runs);
+  writeRuns(runWriter, cells, n);
+  const bool binary = *std::max_element(cells, cells + n) <= 1;
+  const bool bitPlane = binary && (n + 7) / 8 <= runs.size();
+
+  out.clear();
+  out.reserve(32 + (bitPlane ? (n + 7) / 8 : runs.size()) + n / 4);
+  Writer w(out);
+  w.u32(kMagic);
+  w.u16(kVersion);
+  w.u8(static_cast<uint8_t>(bitPlane ? CellEncoding::BitPlane
+                                     : CellEncoding::RunLength));
+  w.u8(static_cast<uint8_t>(type));
+  w.u32(static_cast<uint32_t>(grid.getRows()));
+  w.u32(static_cast<uint32_t>(grid.getCols()));
+
+  size_t at = w.beginSection();
+  if (bitPlane)
+    writeBitPlane(w, cells, n);
+  else
+    w.bytes(runs.data(), runs.size());
+  w.endSection(at);
+
+  at = w.beginSection();
+  writeAges(w, ages, n);
+  w.endSection(at);
+
+  w.u32(static_cast<uint32_t>(numFields));
+  for (int f = 0; f < numFields; ++f) {
+    w.u32(static_cast<uint32_t>(n));
+    w.bytes(fields[f], n * sizeof(float));
+  }
+}
+
+bool GridStateCodec::readHeader(const uint8_t *data, size_t size,
+                                Header &header) {
+  Reader r(data, size);
+  uint32_t magic, rows, cols;
+  uint8_t encoding, type;
+  if (!r.u32(magic) || magic != kMagic || !r.u16(header.version) ||
+      header.version != kVersion || !r.u8(encoding) || !r.u8(type) ||
+      !r.u32(rows) || !r.u32(cols))
+    return false;
+  if (encoding > static_cast<uint8_t>(CellEncoding::RunLength) ||
+      type > static_cast<uint8_t>(EngineType::HashLife) || rows < 1 ||
+      rows > static_cast<uint32_t>(Grid::kMaxRows) || cols < 1 ||
+      cols > static_cast<uint32_t>(Grid::kMaxCols))
+    return false;
+  header.cellEncoding = static_cast<CellEncoding>(encoding);
+  header.engineType = static_cast<EngineType>(type);
+  header.rows = static_cast<int>(rows);
+  header.cols = static_cast<int>(cols);
+  return true;
+}
+
+bool GridStateCodec::decode(const uint8_t *data, size_t size,
+                            CellularEngine &engine) {
+  Header header;
+  if (!readHeader(data, size, header))
+    return false;
+  Grid &grid = engine.getGridMutable();
+  if (header.rows != grid.getRows() || header.cols != grid.getCols())
+    return false;
+
+  Reader r(data, size);
+  r.skip(16); // header
+  const size_t n = cellBytes(grid);
+
+  Reader cellSection(nullptr, 0), ageSection(nullptr, 0);
+  if (!r.section(cellSection) || !r.section(ageSection))
+    return false;
+  const bool cellsOk =
+      header.cellEncoding == CellEncoding::BitPlane
+          ? readBitPlane(cellSection, grid.cellRow(0), n)
+          : readRuns(cellSection, grid.cellRow(0), n);
+  if (!cellsOk || !readAges(ageSection, grid.ageRow(0), n))
+    return false;
+
+  uint32_t numFields;
+  if (!r.u32(numFields))
+    return false;
+  const bool sameEngine = header.engineType == engine.getType();
+  for (uint32_t f = 0; f < numFields; ++f) {
+    uint32_t count;
+    if (!r.u32(count))
+      return false;
+    const size_t bytes = static_cast<size_t>(count) * sizeof(float);
+    const bool restore = sameEngine && count == n &&
+                         f < static_cast<uint32_t>(engine.getNumFields());
+    if (restore ? !r.bytes(engine.getFieldMutable(static_cast<int>(f)), bytes)
+                : !r.skip(bytes))
+      return false;
+  }
+  return r.atEnd();
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CellularEngine.h"
+#include "Grid.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Binary grid state saved with the plugin state.
+///
+/// Version 2 (encode() / decode()) is one self-describing little-endian
+/// chunk:
+///
+///   u32 magic "ANGS", u16 version, u8 cell encoding, u8 EngineType,
+///   u32 rows, u32 cols,
+///   u32 bytes + cells: bit plane (binary grids, 1 bit per cell) or
+///                      runs of (varint length, value byte),
+///   u32 bytes + ages:  row-major deltas from the previous age as
+///                      (varint run of zero deltas, zigzag varint delta),
+///   u32 field count, then per field u32 values + raw float32 data
+///   (CellularEngine::getField(), only restored into the same EngineType).
+///
+/// A 1280x1280 Game of Life soup is ~0.5 MB instead of ~6.5 MB of base64
+/// XML, and nothing goes through per-cell setCell() / setAge() calls.
+///
+/// Version 1 (the "cells" / "ages" base64 attributes of older sessions) is
+/// read through packCells() / packAges() / unpackCells() / unpackAges():
+/// cells one byte each, ages little-endian uint16, row-major.
+class GridStateCodec {
+public:
+  static constexpr uint32_t kMagic = 0x53474E41; // "ANGS"
+  static constexpr uint16_t kVersion = 2;
+
+  enum class CellEncoding : uint8_t { BitPlane = 0, RunLength = 1 };
+
+  struct Header {
+    uint16_t version = 0;
+    CellEncoding cellEncoding = CellEncoding::BitPlane;
+    EngineType engineType = EngineType::GoL;
+    int rows = 0;
+    int cols = 0;
+  };
+
+  /// Encode the engine's grid and fields into out (replacing its contents).
+  static void encode(const CellularEngine &engine, std::vector<uint8_t> &out);
+
+  /// Same chunk from a captured grid and fields (numFields arrays of
+  /// rows * cols floats), e.g. a StateSnapshotter copy.
+  static void encode(EngineType type, const Grid &grid,
+                     const float *const *fields, int numFields,
+                     std::vector<uint8_t> &out);
+
+  /// Read the chunk header. False if this is not a version 2 chunk.
+  static bool readHeader(const uint8_t *data, size_t size, Header &header);
+
+  /// Restore cells, ages and (same engine type only) fields. The engine
+  /// grid must already have the chunk's dimensions. Returns false, leaving
+  /// the engine partly restored at most, on malformed or mismatched data.
+  static bool decode(const uint8_t *data, size_t size,
+                     CellularEngine &engine);
+
+  // --- Version 1 layout ---
+
+  static size_t cellBytes(const Grid &grid) {
+    return static_cast<size_t>(grid.getRows()) *
+           static_cast<size_t>(grid.getCols());
+  }
+  static size_t ageBytes(const Grid &grid) { return cellBytes(grid) * 2; }
+
+  /// Write cellBytes(grid) bytes to out.
+  static void packCells(const Grid &grid, uint8_t *out) {
+    const int cols = grid.getCols();
+    for (int r = 0; r < grid.getRows(); ++r) {
+      const uint8_t *row = grid.cellRow(r);
+      std::copy(row, row + cols, out + static_cast<size_t>(r) * cols);
+    }
+  }
+
+  /// Write ageBytes(grid) bytes to out.
+  static void packAges(const Grid &grid, uint8_t *out) {
+    const int cols = grid.getCols();
+    for (int r = 0; r < grid.getRows(); ++r) {
+      const uint16_t *row = grid.ageRow(r);
+      uint8_t *dst = out + static_cast<size_t>(r) * cols * 2;
+      for (int c = 0; c < cols; ++c) {
+        dst[2 * c] = static_cast<uint8_t>(row[c] & 0xFF);
+        dst[2 * c + 1] = static_cast<uint8_t>(row[c] >> 8);
+      }
+    }
+  }
+
+  /// Read cellBytes(grid) bytes into the grid's current dimensions.
+  static void unpackCells(Grid &grid, const uint8_t *in) {
+    const int cols = grid.getCols();
+    for (int r = 0; r < grid.getRows(); ++r) {
+      const uint8_t *src = in + static_cast<size_t>(r) * cols;
+      std::copy(src, src + cols, grid.cellRow(r));
+    }
+  }
+
+  /// Read ageBytes(grid) bytes into the grid's current dimensions.
+  static void unpackAges(Grid &grid, const uint8_t *in) {
+    const int cols = grid.getCols();
+    for (int r = 0; r < grid.getRows(); ++r) {
+      const uint8_t *src = in + static_cast<size_t>(r) * cols * 2;
+      uint16_t *row = grid.ageRow(r);
+      for (int c = 0; c < cols; ++c)
+        row[c] = static_cast<uint16_t>(src[2 * c] | (src[2 * c + 1] << 8));
+    }
+  }
+};
@@ -0,0 +1,563 @@
+#include "HashLife.h"
+#include <algorithm>
+
+// --- Simple xorshift64 PRNG (allocation-free, deterministic) ---
+namespace {
+uint64_t xorshift64(uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+} // namespace
+
+HashLife::HashLife(int rows, int cols, RulePreset preset, int level,
+                   uint32_t maxNodesIn)
+    : grid(rows, cols), scratch(rows, cols) {
+  applyPreset(preset);
+
+  // The universe must hold the whole view
+  int fit = kMinLevel;
+  while (fit < kMaxLevel &&
+         (1 << fit) < std::max(grid.getRows(), grid.getCols()))
+    ++fit;
+  universeLevel = std::clamp(level, fit, kMaxLevel);
+
+  // Room for the leaves and empty nodes plus a working set
+  maxNodes = std::max<uint32_t>(maxNodesIn, 1024);
+  nodes.reserve(maxNodes);
+  uint32_t numBuckets = 1;
+  while (numBuckets < maxNodes)
+    numBuckets <<= 1;
+  buckets.assign(numBuckets, kNil);
+  bucketMask = numBuckets - 1;
+
+  // Level-0 leaves are fixed indices and never hashed
+  nodes.push_back({kNil, kNil, kNil, kNil, kNil, kNil, 0, false});
+  nodes.push_back({kNil, kNil, kNil, kNil, kNil, kNil, 0, false});
+  nodesInUse = 2;
+
+  emptyNode[0] = kDead;
+  for (int l = 1; l <= kMaxLevel + 1; ++l) {
+    const uint32_t e = emptyNode[l - 1];
+    emptyNode[l] = join(e, e, e, e);
+  }
+  root = emptyNode[universeLevel];
+}
+
+void HashLife::applyPreset(RulePreset preset) {
+  currentPreset = preset;
+  GameOfLife::getPresetRules(preset, birthRule, survivalRule);
+}
+
+void HashLife::setRulePreset(RulePreset preset) {
+  applyPreset(preset);
+  clearResults(); // memoized futures depend on the rule
+}
+
+bool HashLife::setGenerationsPerStep(int generations) {
+  int log2 = 0;
+  while (log2 < kMaxLevel && (2LL << log2) <= generations)
+    ++log2;
+  requestedLog2.store(log2, std::memory_order_relaxed);
+  return true;
+}
+
+int HashLife::getGenerationsPerStep() const {
+  return 1 << std::min(requestedLog2.load(std::memory_order_relaxed),
+                       universeLevel - 1);
+}
+
+// --- Stepping ---
+
+void HashLife::step() {
+  events.reset(grid.getRows(), grid.getCols());
+  if (gridStale)
+    syncFromGrid();
+
+  const int log2 = std::min(requestedLog2.load(std::memory_order_relaxed),
+                            universeLevel - 1);
+  if (!advanceUniverse(log2))
+    ++stalledSteps;
+
+  projectView(true);
+}
+
+bool HashLife::advanceUniverse(int log2) {
+  if (nodesInUse > maxNodes / 4 * 3)
+    collectGarbage();
+  if (tryAdvance(log2))
+    return true;
+
+  // Pool ran out mid-jump: reclaim everything but the universe, retry, and
+  // split the jump if it still does not fit.
+  collectGarbage();
+  if (tryAdvance(log2))
+    return true;
+  if (log2 == 0)
+    return false;
+  return advanceUniverse(log2 - 1) && advanceUniverse(log2 - 1);
+}
+
+bool HashLife::tryAdvance(int log2) {
+  if (log2 != jumpLog2) {
+    jumpLog2 = log2;
+    clearResults();
+  }
+  outOfNodes = false;
+
+  // A 2x2 tiling of the torus is the infinite periodic universe as far as
+  // the next 2^log2 <= side/2 generations can see. Its advanced centre is
+  // the torus shifted by side/2; re-tile and take the centre to undo that.
+  const uint32_t tiled = join(root, root, root, root);
+  const uint32_t shifted = advance(tiled);
+  const uint32_t next = centre(join(shifted, shifted, shifted, shifted));
+  if (outOfNodes)
+    return false;
+
+  root = next;
+  generation += uint64_t{1} << log2;
+  return true;
+}
+
+uint32_t HashLife::advance(uint32_t n) {
+  const Node node = nodes[n];
+  if (n == emptyNode[node.level])
+    return emptyNode[node.level - 1];
+  if (node.result != kNil)
+    return node.result;
+
+  uint32_t result;
+  if (node.level == 2) {
+    result = advanceLeaf(n);
+  } else {
+    const Node nw = nodes[node.nw];
+    const Node ne = nodes[node.ne];
+    const Node sw = nodes[node.sw];
+    const Node se = nodes[node.se];
+
+    // The nine overlapping half-size squares, row-major
+    uint32_t sub[9] = {node.nw,
+                       join(nw.ne, ne.nw, nw.se, ne.sw),
+                       node.ne,
+                       join(nw.sw, nw.se, sw.nw, sw.ne),
+                       join(nw.se, ne.sw, sw.ne, se.nw),
+                       join(ne.sw, ne.se, se.nw, se.ne),
+                       node.sw,
+                       join(sw.ne, se.nw, sw.se, se.sw),
+                       node.se};
+
+    // Full speed: both halves advance 2^(level-3) generations. Smaller
+    // jumps take the first half as a plain centre (no time passes).
+    const bool fullSpeed = jumpLog2 >= node.level - 2;
+    for (uint32_t &s : sub)
+      s = fullSpeed ? advance(s) : centre(s);
+
+    const uint32_t rnw = advance(join(sub[0], sub[1], sub[3], sub[4]));
+    const uint32_t rne = advance(join(sub[1], sub[2], sub[4], sub[5]));
+    const uint32_t rsw = advance(join(sub[3], sub[4], sub[6], sub[7]));
+    const uint32_t rse = advance(join(sub[4], sub[5], sub[7], sub[8]));
+    result = join(rnw, rne, rsw, rse);
+  }
+
+  // Never memoize a result computed after the pool ran out
+  if (!outOfNodes)
+    nodes[n].result = result;
+  return result;
+}
+
+uint32_t HashLife::advanceLeaf(uint32_t n) {
+  // Gather the 4x4 block into a mask, bit r * 4 + c
+  const Node node = nodes[n];
+  const uint32_t quads[4] = {node.nw, node.ne, node.sw, node.se};
+  uint32_t bits = 0;
+  for (int q = 0; q < 4; ++q) {
+    const Node &k = nodes[quads[q]];
+    const int shift = (q >> 1) * 8 + (q & 1) * 2;
+    bits |= (static_cast<uint32_t>(k.nw == kAlive) << shift) |
+            (static_cast<uint32_t>(k.ne == kAlive) << (shift + 1)) |
+            (static_cast<uint32_t>(k.sw == kAlive) << (shift + 4)) |
+            (static_cast<uint32_t>(k.se == kAlive) << (shift + 5));
+  }
+
+  uint32_t out[4];
+  for (int i = 0; i < 4; ++i) {
+    const int r = 1 + (i >> 1);
+    const int c = 1 + (i & 1);
+    int neighbors = 0;
+    for (int dr = -1; dr <= 1; ++dr)
+      for (int dc = -1; dc <= 1; ++dc)
+        if (dr != 0 || dc != 0)
+          neighbors += (bits >> ((r + dr) * 4 + c + dc)) & 1;
+    const bool alive = (bits >> (r * 4 + c)) & 1;
+    const uint16_t rule = alive ? survivalRule : birthRule;
+    out[i] = ((rule >> neighbors) & 1) ? kAlive : kDead;
+  }
+  return join(out[0], out[1], out[2], out[3]);
+}
+
+// --- Node cache ---
+
+uint32_t HashLife::hashOf(uint32_t nw, uint32_t ne, uint32_t sw,
+                          uint32_t se) const {
+  uint64_t h = nw * 0x9E3779B97F4A7C15ULL;
+  h ^= ne * 0xC2B2AE3D27D4EB4FULL;
+  h ^= sw * 0x165667B19E3779F9ULL;
+  h ^= se * 0x27D4EB2F165667C5ULL;
+  h ^= h >> 29;
+  return static_cast<uint32_t>(h ^ (h >> 32)) & bucketMask;
+}
+
+uint32_t HashLife::join(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+  const uint8_t level = static_cast<uint8_t>(nodes[nw].level + 1);
+  const uint32_t h = hashOf(nw, ne, sw, se);
+  for (uint32_t i = buckets[h]; i != kNil; i = nodes[i].next) {
+    const Node &n = nodes[i];
+    if (n.nw == nw && n.ne == ne && n.sw == sw && n.se == se)
+      return i;
+  }
+
+  uint32_t index;
+  if (freeList != kNil) {
+    index = freeList;
+    freeList = nodes[index].next;
+  } else if (nodes.size() < maxNodes) {
+    index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({}); // within reserved capacity: no allocation
+  } else {
+    outOfNodes = true;
+    return emptyNode[level];
+  }
+
+  nodes[index] = {nw, ne, sw, se, kNil, buckets[h], level, false};
+  buckets[h] = index;
+  ++nodesInUse;
+  return index;
+}
+
+uint32_t HashLife::centre(uint32_t n) {
+  const Node node = nodes[n];
+  return join(nodes[node.nw].se, nodes[node.ne].sw, nodes[node.sw].ne,
+              nodes[node.se].nw);
+}
+
+void HashLife::mark(uint32_t n) {
+  Node &node = nodes[n];
+  if (node.marked)
+    return;
+  node.marked = true;
+  mark(node.nw); // depth <= kMaxLevel; leaves are pre-marked
+  mark(node.ne);
+  mark(node.sw);
+  mark(node.se);
+}
+
+void HashLife::collectGarbage() {
+  nodes[kDead].marked = true;
+  nodes[kAlive].marked = true;
+  for (uint32_t e : emptyNode)
+    mark(e);
+  mark(root);
+
+  // Keep a memoized result only if it points at a surviving node
+  for (Node &n : nodes)
+    if (n.marked && n.result != kNil && !nodes[n.result].marked)
+      n.result = kNil;
+
+  // Rebuild the hash table from the survivors; the rest become free slots
+  // (lowest indices handed out first)
+  std::fill(buckets.begin(), buckets.end(), kNil);
+  freeList = kNil;
+  nodesInUse = 0;
+  for (uint32_t i = static_cast<uint32_t>(nodes.size()); i-- > 0;) {
+    Node &n = nodes[i];
+    const bool live = n.marked;
+    n.marked = false;
+    if (i <= kAlive) {
+      ++nodesInUse;
+    } else if (live) {
+      const uint32_t h = hashOf(n.nw, n.ne, n.sw, n.se);
+      n.next = buckets[h];
+      buckets[h] = i;
+      ++nodesInUse;
+    } else {
+      n.result = kNil;
+      n.next = freeList;
+      freeList = i;
+    }
+  }
+  ++collections;
+}
+
+void HashLife::clearResults() {
+  for (Node &n : nodes)
+    n.result = kNil;
+}
+
+// --- Universe <-> grid ---
+
+bool HashLife::overlapsView(int r0, int c0, int size) const {
+  const int64_t side = int64_t{1} << universeLevel;
+  const int mask = static_cast<int>(side - 1);
+  const int64_t dr = (r0 - viewRow) & mask;
+  const int64_t dc = (c0 - viewCol) & mask;
+  return (dr < grid.getRows() || dr + size > side) &&
+         (dc < grid.getCols() || dc + size > side);
+}
+
+uint32_t HashLife::setCell(uint32_t n, int level, int row, int col,
+                           bool alive) {
+  if (level == 0)
+    return alive ? kAlive : kDead;
+  const int half = 1 << (level - 1);
+  Node node = nodes[n];
+  if (row < half) {
+    if (col < half)
+      node.nw = setCell(node.nw, level - 1, row, col, alive);
+    else
+      node.ne = setCell(node.ne, level - 1, row, col - half, alive);
+  } else {
+    if (col < half)
+      node.sw = setCell(node.sw, level - 1, row - half, col, alive);
+    else
+      node.se = setCell(node.se, level - 1, row - half, col - half, alive);
+  }
+  return join(node.nw, node.ne, node.sw, node.se);
+}
+
+uint32_t HashLife::buildFromGrid(uint32_t n, int level, int r0, int c0) {
+  if (!overlapsView(r0, c0, 1 << level))
+    return n;
+  const int mask = (1 << universeLevel) - 1;
+  if (level == 0)
+    return grid.cellRow((r0 - viewRow) & mask)[(c0 - viewCol) & mask]
+               ? kAlive
+               : kDead;
+
+  const int half = 1 << (level - 1);
+  const Node node = nodes[n];
+  const uint32_t nw = buildFromGrid(node.nw, level - 1, r0, c0);
+  const uint32_t ne = buildFromGrid(node.ne, level - 1, r0, c0 + half);
+  const uint32_t sw = buildFromGrid(node.sw, level - 1, r0 + half, c0);
+  const uint32_t se = buildFromGrid(node.se, level - 1, r0 + half, c0 + half);
+  return join(nw, ne, sw, se);
+}
+
+void HashLife::projectNode(uint32_t n, int level, int r0, int c0,
+                           Grid &dst) const {
+  if (n == emptyNode[level] || !overlapsView(r0, c0, 1 << level))
+    return;
+  if (level == 0) {
+    const int mask = (1 << universeLevel) - 1;
+    dst.cellRow((r0 - viewRow) & mask)[(c0 - viewCol) & mask] = 1;
+    return;
+  }
+  const int half = 1 << (level - 1);
+  const Node &node = nodes[n];
+  projectNode(node.nw, level - 1, r0, c0, dst);
+  projectNode(node.ne, level - 1, r0, c0 + half, dst);
+  projectNode(node.sw, level - 1, r0 + half, c0, dst);
+  projectNode(node.se, level - 1, r0 + half, c0 + half, dst);
+}
+
+void HashLife::syncFromGrid() {
+  gridStale = false;
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  if (scratch.getRows() != rows || scratch.getCols() != cols)
+    scratch.resize(rows, cols);
+  else
+    scratch.clear();
+  projectNode(root, universeLevel, 0, 0, scratch);
+
+  int changed = 0;
+  for (int r = 0; r < rows; ++r) {
+    const uint8_t *edited = grid.cellRow(r);
+    const uint8_t *shown = scratch.cellRow(r);
+    for (int c = 0; c < cols; ++c)
+      changed += (edited[c] != 0) != (shown[c] != 0);
+  }
+  if (changed == 0)
+    return;
+
+  // A few edits (UI clicks) patch single cells in O(level) each; bulk edits
+  // (pattern loads) rebuild the window once.
+  const bool perCell =
+      static_cast<int64_t>(changed) * universeLevel < int64_t{rows} * cols;
+  const int mask = (1 << universeLevel) - 1;
+  if (nodesInUse > maxNodes / 4 * 3)
+    collectGarbage();
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    outOfNodes = false;
+    uint32_t next = root;
+    if (perCell) {
+      for (int r = 0; r < rows; ++r) {
+        const uint8_t *edited = grid.cellRow(r);
+        const uint8_t *shown = scratch.cellRow(r);
+        for (int c = 0; c < cols; ++c)
+          if ((edited[c] != 0) != (shown[c] != 0))
+            next = setCell(next, universeLevel, (viewRow + r) & mask,
+                           (viewCol + c) & mask, edited[c] != 0);
+      }
+    } else {
+      next = buildFromGrid(root, universeLevel, 0, 0);
+    }
+    if (!outOfNodes) {
+      root = next;
+      return;
+    }
+    collectGarbage();
+  }
+}
+
+void HashLife::projectView(bool stepped) {
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  if (scratch.getRows() != rows || scratch.getCols() != cols)
+    scratch.resize(rows, cols);
+  else
+    scratch.clear();
+  projectNode(root, universeLevel, 0, 0, scratch);
+
+  // Ages follow GameOfLife: 1 on birth, +1 per surviving step
+  CellEventList::Writer out(events);
+  for (int r = 0; r < rows; ++r) {
+    const uint8_t *prev = grid.cellRow(r);
+    const uint16_t *prevAge = grid.ageRow(r);
+    const uint8_t *next = scratch.cellRow(r);
+    uint16_t *age = scratch.ageRow(r);
+    for (int c = 0; c < cols; ++c) {
+      if (!next[c]) {
+        if (prev[c] && stepped)
+          out.add(r, c, CellEvent::Death, 0.0f);
+      } else if (prev[c]) {
+        const uint16_t a = prevAge[c];
+        age[c] = (stepped && a < UINT16_MAX) ? a + 1 : std::max<uint16_t>(a, 1);
+      } else {
+        age[c] = 1;
+        if (stepped)
+          out.add(r, c, CellEvent::Birth, 1.0f);
+      }
+    }
+  }
+  out.flush();
+
+  grid.swapBuffers(scratch);
+}
+
+void HashLife::resetUniverseFromGrid() {
+  gridStale = false;
+  generation = 0;
+  root = emptyNode[universeLevel];
+  collectGarbage(); // drop the old universe
+  root = buildFromGrid(root, universeLevel, 0, 0);
+}
+
+void HashLife::setViewOrigin(int row, int col) {
+  if (gridStale)
+    syncFromGrid();
+  const int mask = (1 << universeLevel) - 1;
+  viewRow = row & mask;
+  viewCol = col & mask;
+  projectView(false);
+}
+
+bool HashLife::getUniverseCell(int row, int col) const {
+  const int mask = (1 << universeLevel) - 1;
+  row &= mask;
+  col &= mask;
+  uint32_t n = root;
+  for (int level = universeLevel; level > 0; --level) {
+    const int half = 1 << (level - 1);
+    const Node &node = nodes[n];
+    const bool south = row >= half;
+    const bool east = col >= half;
+    n = south ? (east ? node.se : node.sw) : (east ? node.ne : node.nw);
+    if (south)
+      row -= half;
+    if (east)
+      col -= half;
+  }
+  return n == kAlive;
+}
+
+void HashLife::setUniverseCell(int row, int col, bool alive) {
+  const int mask = (1 << universeLevel) - 1;
+  row &= mask;
+  col &= mask;
+  if (nodesInUse > maxNodes / 4 * 3)
+    collectGarbage();
+  outOfNodes = false;
+  uint32_t next = setCell(root, universeLevel, row, col, alive);
+  if (outOfNodes) {
+    collectGarbage();
+    outOfNodes = false;
+    next = setCell(root, universeLevel, row, col, alive);
+  }
+  root = next;
+
+  const int gr = (row - viewRow) & mask;
+  const int gc = (col - viewCol) & mask;
+  if (gr < grid.getRows() && gc < grid.getCols()) {
+    grid.setCell(gr, gc, alive ? 1 : 0);
+    grid.setAge(gr, gc, alive ? 1 : 0);
+  }
+}
+
+// --- Seeding (same patterns as GameOfLife for a given seed) ---
+
+void HashLife::randomize(uint64_t seed, float density) {
+  grid.clear();
+
+  uint64_t state = seed;
+  if (state == 0)
+    state = 1; // xorshift64 needs non-zero seed
+
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < cols; ++c) {
+      uint64_t rng = xorshift64(state);
+      float normalized = static_cast<float>(rng >> 32) / 4294967296.0f;
+      if (normalized < density) {
+        grid.setCell(r, c, 1);
+        grid.setAge(r, c, 1);
+      }
+    }
+  }
+  resetUniverseFromGrid();
+}
+
+void HashLife::randomizeSymmetric(uint64_t seed, float density) {
+  grid.clear();
+
+  uint64_t state = seed;
+  if (state == 0)
+    state = 1;
+
+  const int rows = grid.getRows();
+  const int cols = grid.getCols();
+  const int halfR = (rows + 1) / 2;
+  const int halfC = (cols + 1) / 2;
+  for (int r = 0; r < halfR; ++r) {
+    for (int c = 0; c < halfC; ++c) {
+      uint64_t rng = xorshift64(state);
+      float normalized = static_cast<float>(rng >> 32) / 4294967296.0f;
+      if (normalized < density) {
+        const int mirrorR = rows - 1 - r;
+        const int mirrorC = cols - 1 - c;
+        for (int rr : {r, mirrorR})
+          for (int cc : {c, mirrorC}) {
+            grid.setCell(rr, cc, 1);
+            grid.setAge(rr, cc, 1);
+          }
+      }
+    }
+  }
+  resetUniverseFromGrid();
+}
+
+void HashLife::clear() {
+  grid.clear();
+  resetUniverseFromGrid();
+}
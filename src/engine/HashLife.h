@@ -0,0 +1,178 @@
+#pragma once
+
+#include "CellularEngine.h"
+#include "GameOfLife.h"
+#include "Grid.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// Hashlife (memoized, hash-consed quadtree) engine for the Life-like rule
+/// presets of GameOfLife.
+///
+/// The universe is a torus of 2^level x 2^level cells, at least as large as
+/// the grid and up to 2^kMaxLevel on a side. The grid is a view window onto
+/// it (origin set with setViewOrigin(), wrapping across the torus seam);
+/// cells outside the window keep evolving. Identical sub-squares share one
+/// node and every node memoizes its future, so repetitive patterns (guns,
+/// oscillators, still-life debris) cost almost nothing per generation, and
+/// one step() can jump 2^n generations (setGenerationsPerStep()).
+///
+/// Nodes live in a fixed-capacity pool reserved in the constructor. When it
+/// fills up, nodes unreachable from the current universe are reclaimed
+/// (mark and sweep) and memoized results that pointed at them are dropped,
+/// so memory stays flat however long the pattern runs. step() never
+/// allocates.
+///
+/// On a power-of-two grid with the view at the origin the result is
+/// identical to GameOfLife on the same grid.
+class HashLife final : public CellularEngine {
+public:
+  using RulePreset = GameOfLife::RulePreset;
+
+  static constexpr int kMinLevel = 3;  ///< smallest universe: 8x8
+  static constexpr int kMaxLevel = 30; ///< largest universe: 2^30 x 2^30
+
+  /// Default node pool capacity (~28 MB when full; pages are only touched
+  /// as nodes are first used).
+  static constexpr uint32_t kDefaultMaxNodes = 1u << 20;
+
+  /// Construct with grid (view) dimensions and rule preset.
+  /// @param universeLevel  log2 of the universe side; clamped up to fit the
+  ///                       grid (0 = smallest that fits).
+  /// @param maxNodes  node pool capacity.
+  explicit HashLife(int rows = 12, int cols = 16,
+                    RulePreset preset = RulePreset::Classic,
+                    int universeLevel = 0,
+                    uint32_t maxNodes = kDefaultMaxNodes);
+
+  // --- CellularEngine interface ---
+  EngineType getType() const override { return EngineType::HashLife; }
+  void step() override;
+  void randomize(uint64_t seed, float density) override;
+  void randomizeSymmetric(uint64_t seed, float density) override;
+  void clear() override;
+  const Grid &getGrid() const override { return grid; }
+  /// Mutable access marks the view as edited: the next step() folds the
+  /// grid's cells back into the universe first.
+  Grid &getGridMutable() override {
+    gridStale = true;
+    return grid;
+  }
+  uint64_t getGeneration() const override { return generation; }
+  const char *getName() const override { return "HashLife"; }
+
+  /// Advance 2^n generations per step() (n rounded down, capped at
+  /// universeLevel - 1). Safe to call from any thread.
+  bool setGenerationsPerStep(int generations) override;
+  int getGenerationsPerStep() const override;
+
+  // --- HashLife-specific ---
+  void setRulePreset(RulePreset preset);
+  RulePreset getRulePreset() const { return currentPreset; }
+
+  int getUniverseLevel() const { return universeLevel; }
+  int getUniverseSize() const { return 1 << universeLevel; }
+
+  /// Move the view window to universe cell (row, col) and re-project the
+  /// grid (toroidal: coordinates wrap at getUniverseSize()).
+  void setViewOrigin(int row, int col);
+  int getViewRow() const { return viewRow; }
+  int getViewCol() const { return viewCol; }
+
+  /// Universe cell access (wraps). Setting a cell inside the view also
+  /// updates the grid.
+  bool getUniverseCell(int row, int col) const;
+  void setUniverseCell(int row, int col, bool alive);
+
+  // --- Node cache statistics ---
+  uint32_t getNodeCount() const { return nodesInUse; }
+  uint32_t getMaxNodes() const { return maxNodes; }
+  uint64_t getCollectionCount() const { return collections; }
+  /// Steps that could not advance even one generation because a single
+  /// generation needed more nodes than the pool holds.
+  uint64_t getStalledSteps() const { return stalledSteps; }
+
+private:
+  static constexpr uint32_t kNil = 0xFFFFFFFFu;
+  static constexpr uint32_t kDead = 0; // level-0 leaves
+  static constexpr uint32_t kAlive = 1;
+
+  struct Node {
+    uint32_t nw, ne, sw, se; // children (level - 1)
+    uint32_t result;         // memoized advance() for jumpLog2, or kNil
+    uint32_t next;           // hash chain / free list
+    uint8_t level;
+    bool marked;             // garbage collection
+  };
+
+  // --- Node cache ---
+  /// Canonical node with these children (hash-consed). Returns the empty
+  /// node of the level and sets outOfNodes when the pool is exhausted.
+  uint32_t join(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se);
+  uint32_t centre(uint32_t n);
+  uint32_t hashOf(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) const;
+  void collectGarbage();
+  void mark(uint32_t n);
+  /// Drop all memoized results (jump size or rule changed).
+  void clearResults();
+
+  // --- Evolution ---
+  /// Centre half of a level >= 2 node, min(2^(level-2), 2^jumpLog2)
+  /// generations later.
+  uint32_t advance(uint32_t n);
+  /// 4x4 -> centre 2x2, one generation.
+  uint32_t advanceLeaf(uint32_t n);
+  /// Advance the torus by 2^log2 generations, splitting the jump when the
+  /// pool cannot hold it. Returns false if not even one generation fit.
+  bool advanceUniverse(int log2);
+  bool tryAdvance(int log2);
+
+  // --- Universe <-> grid ---
+  uint32_t setCell(uint32_t n, int level, int row, int col, bool alive);
+  /// Replace the view window of node n (square of 2^level at r0, c0) with
+  /// the grid's cells, keeping everything outside the window.
+  uint32_t buildFromGrid(uint32_t n, int level, int r0, int c0);
+  /// Set the alive cells of node n that fall inside the view in dst.
+  void projectNode(uint32_t n, int level, int r0, int c0, Grid &dst) const;
+  bool overlapsView(int r0, int c0, int size) const;
+  /// Fold grid edits back into the universe.
+  void syncFromGrid();
+  /// Project the universe into the grid. After a step ages advance as in
+  /// GameOfLife and births/deaths are recorded; otherwise (view moved)
+  /// ages are kept and no events are recorded.
+  void projectView(bool stepped);
+  /// Rebuild the whole universe from the grid (after randomize/clear).
+  void resetUniverseFromGrid();
+
+  void applyPreset(RulePreset preset);
+
+  Grid grid;
+  Grid scratch; // next projection, swapped into grid
+
+  std::vector<Node> nodes;       // capacity maxNodes, never reallocated
+  std::vector<uint32_t> buckets; // hash table heads
+  uint32_t bucketMask = 0;
+  uint32_t freeList = kNil;
+  uint32_t maxNodes = 0;
+  uint32_t nodesInUse = 0;
+  bool outOfNodes = false;
+  uint32_t emptyNode[kMaxLevel + 2] = {}; // canonical empty node per level
+
+  uint32_t root = kDead; // the torus, level universeLevel
+  int universeLevel = kMinLevel;
+  int viewRow = 0;
+  int viewCol = 0;
+  bool gridStale = false;
+
+  uint16_t birthRule = 0;
+  uint16_t survivalRule = 0;
+  RulePreset currentPreset = RulePreset::Classic;
+
+  std::atomic<int> requestedLog2{0}; // set from any thread
+  int jumpLog2 = 0;                  // the memoized results' jump
+
+  uint64_t generation = 0;
+  uint64_t collections = 0;
+  uint64_t stalledSteps = 0;
+};
@@ -14,10 +14,147 @@ uint64_t xorshift64(uint64_t &state) {
 }
 } // namespace
 
+namespace {
+using pocketfft::detail::arr;
+using pocketfft::detail::cmplx;
+
+// One SIMD vector of floats as pocketfft vectorizes them (a plain float
+// where it has no vector support, e.g. MSVC)
+#ifndef POCKETFFT_NO_VECTORS
+using Lanes = pocketfft::detail::vtype_t<float>;
+#else
+using Lanes = float;
+#endif
+constexpr int kLanes = static_cast<int>(sizeof(Lanes) / sizeof(float));
+
+/// Lane j of vector v is floats[v * kLanes + j] (vector types alias their
+/// element type).
+inline float *floatsOf(Lanes *v) { return reinterpret_cast<float *>(v); }
+inline float *floatsOf(cmplx<Lanes> *v) { return reinterpret_cast<float *>(v); }
+
+/// Gaussian growth centered at mu, width sigma, in [-1, 1].
+inline float growthOf(float potential, float mu, float sigma) {
+  float diff = potential - mu;
+  return 2.0f * std::exp(-0.5f * diff * diff / (sigma * sigma)) - 1.0f;
+}
+} // namespace
+
+// Separable 2D real FFT with 1D plans built once per engine (pocketfft's
+// r2c / c2r rebuild them on every call). Rows are transformed kLanes at a
+// time, one row per SIMD lane, and their bins are stored transposed in
+// blocks of kLanes columns: each column block is one contiguous array of
+// SIMD vectors, so the column pass needs no gather and multiplies by the
+// kernel spectrum between its forward and inverse transforms.
+struct LeniaEngine::FFTState {
+  FFTState(int rows, int cols)
+      : rows(rows), cols(cols), numBins(cols / 2 + 1),
+        blocks((numBins + kLanes - 1) / kLanes), rowPlan(cols),
+        columnPlan(rows), bins(static_cast<size_t>(blocks) * rows),
+        kernel(static_cast<size_t>(blocks) * rows) {}
+
+  /// Rows [r0, r0 + n) of src (n <= kLanes) -> bins. work: cols vectors.
+  void forwardRows(const float *src, int r0, int n, Lanes *work) {
+    float *w = floatsOf(work);
+    for (int j = 0; j < kLanes; ++j) {
+      if (j >= n) {
+        for (int c = 0; c < cols; ++c)
+          w[c * kLanes + j] = 0.0f;
+        continue;
+      }
+      const float *row = src + static_cast<size_t>(r0 + j) * cols;
+      for (int c = 0; c < cols; ++c)
+        w[c * kLanes + j] = row[c];
+    }
+    rowPlan.exec(work, 1.0f, true);
+    // FFTPACK half-complex (r0, r1, i1, r2, i2, ...[, r(n/2)]) -> bins.
+    // Each block of kLanes bins x kLanes rows is a small transpose.
+    for (int b = 0; b < blocks; ++b) {
+      float *block = floatsOf(&bins[static_cast<size_t>(b) * rows + r0]);
+      for (int l = 0; l < kLanes; ++l) {
+        const int k = b * kLanes + l;
+        const float *re = k == 0 ? w : w + (2 * k - 1) * kLanes;
+        const float *im = (k > 0 && 2 * k < cols) ? w + 2 * k * kLanes
+                                                  : nullptr; // DC / Nyquist
+        for (int j = 0; j < n; ++j) {
+          float *bin = block + j * 2 * kLanes;
+          bin[l] = k < numBins ? re[j] : 0.0f;
+          bin[kLanes + l] = (k < numBins && im) ? im[j] : 0.0f;
+        }
+      }
+    }
+  }
+
+  /// Bins -> real rows [r0, r0 + n): lane j of work[c] is (r0 + j, c).
+  void inverseRows(int r0, int n, Lanes *work) {
+    float *w = floatsOf(work);
+    for (int b = 0; b < blocks; ++b) {
+      const float *block =
+          floatsOf(&bins[static_cast<size_t>(b) * rows + r0]);
+      for (int l = 0; l < kLanes; ++l) {
+        const int k = b * kLanes + l;
+        if (k >= numBins)
+          break;
+        float *re = k == 0 ? w : w + (2 * k - 1) * kLanes;
+        float *im = (k > 0 && 2 * k < cols) ? w + 2 * k * kLanes : nullptr;
+        for (int j = 0; j < kLanes; ++j) {
+          const float *bin = block + j * 2 * kLanes;
+          re[j] = j < n ? bin[l] : 0.0f;
+          if (im)
+            im[j] = j < n ? bin[kLanes + l] : 0.0f;
+        }
+      }
+    }
+    rowPlan.exec(work, 1.0f, false);
+  }
+
+  /// Per-band row buffers (cols vectors each) for up to `bands` bands.
+  void reserveBands(int bands) {
+    if (bands <= workBands)
+      return;
+    work.resize(static_cast<size_t>(bands) * cols);
+    workBands = bands;
+  }
+  Lanes *bandWork(int band) {
+    return work.data() + static_cast<size_t>(band) * cols;
+  }
+
+  /// Column block b: forward, multiply by the kernel spectrum, inverse.
+  void convolveBlock(int b) {
+    cmplx<Lanes> *col = &bins[static_cast<size_t>(b) * rows];
+    const Lanes *k = &kernel[static_cast<size_t>(b) * rows];
+    columnPlan.exec(col, 1.0f, true);
+    for (int r = 0; r < rows; ++r) {
+      col[r].r *= k[r];
+      col[r].i *= k[r];
+    }
+    columnPlan.exec(col, 1.0f, false);
+  }
+
+  const int rows, cols;
+  const int numBins; // cols / 2 + 1 (Hermitian half)
+  const int blocks;  // column blocks of kLanes bins
+  pocketfft::detail::pocketfft_r<float> rowPlan;
+  pocketfft::detail::pocketfft_c<float> columnPlan;
+  arr<cmplx<Lanes>> bins; // [block][row], lane j = bin block * kLanes + j
+  arr<Lanes> kernel;      // kernel spectrum, same layout, real, scaled by 1/N
+  arr<Lanes> work;        // row-pass buffers, one per band (reserveBands)
+  int workBands = 0;
+};
+
 LeniaEngine::LeniaEngine(int r, int c)
-    : stateField(Grid::kMaxCells, 0.0f), scratch(Grid::kMaxCells, 0.0f),
-      grid(r, c), rows(r), cols(c) {
+    : grid(r, c), rows(grid.getRows()), cols(grid.getCols()),
+      stateField(static_cast<size_t>(rows) * cols, 0.0f),
+      scratch(static_cast<size_t>(rows) * cols, 0.0f) {
   precomputeKernel();
+  if (rows * cols >= kFFTThreshold)
+    prepareFFT();
+}
+
+LeniaEngine::~LeniaEngine() = default;
+
+void LeniaEngine::workerPoolChanged() {
+  if (fft)
+    fft->reserveBands(getMaxRowBands());
 }
 
 void LeniaEngine::precomputeKernel() {
@@ -40,182 +177,162 @@ void LeniaEngine::precomputeKernel() {
 }
 
 void LeniaEngine::prepareFFT() {
-  // Build the kernel in a zero-padded rows x cols real array,
-  // then transform it once. We reuse this every step.
-  const size_t N = static_cast<size_t>(rows) * static_cast<size_t>(cols);
+  if (!fft)
+    fft = std::make_unique<FFTState>(rows, cols); // dimensions are fixed
+  fft->reserveBands(getMaxRowBands());
 
-  // Contiguous real buffer for the kernel (rows x cols, packed)
-  fftReal.assign(N, 0.0f);
-
-  // Place kernel centered at (0,0) with toroidal wrap
+  // Kernel image centered at (0,0) with toroidal wrap, in the (otherwise
+  // unused) direct-path back buffer
+  std::fill(scratch.begin(), scratch.end(), 0.0f);
   int kidx = 0;
   for (int dr = -kRadius; dr <= kRadius; ++dr) {
     for (int dc = -kRadius; dc <= kRadius; ++dc) {
       int wr = ((dr % rows) + rows) % rows;
       int wc = ((dc % cols) + cols) % cols;
-      fftReal[static_cast<size_t>(wr) * static_cast<size_t>(cols) +
-              static_cast<size_t>(wc)] += kernel[kidx] / kernelSum;
+      scratch[static_cast<size_t>(wr) * cols + wc] += kernel[kidx] / kernelSum;
       ++kidx;
     }
   }
 
-  // Forward FFT of kernel (real-to-complex, 2D)
-  pocketfft::shape_t shape = {static_cast<size_t>(rows),
-                              static_cast<size_t>(cols)};
-  pocketfft::stride_t strideIn = {static_cast<ptrdiff_t>(cols * sizeof(float)),
-                                  static_cast<ptrdiff_t>(sizeof(float))};
-  // Complex output: last axis is cols/2+1 (hermitian symmetry)
-  size_t cCols = static_cast<size_t>(cols / 2 + 1);
-  pocketfft::stride_t strideOut = {
-      static_cast<ptrdiff_t>(cCols * sizeof(std::complex<float>)),
-      static_cast<ptrdiff_t>(sizeof(std::complex<float>))};
-
-  kernelFFT.resize(static_cast<size_t>(rows) * cCols);
-
-  pocketfft::r2c(shape, strideIn, strideOut, {0, 1}, pocketfft::FORWARD,
-                 fftReal.data(), kernelFFT.data(), 1.0f);
-
-  // Pre-allocate field FFT buffer
-  fieldFFT.resize(static_cast<size_t>(rows) * cCols);
+  // Forward transform once. The kernel is point-symmetric, so its spectrum
+  // is real: keep the real part only, with the inverse's 1/N folded in.
+  for (int r0 = 0; r0 < rows; r0 += kLanes)
+    fft->forwardRows(scratch.data(), r0, std::min(kLanes, rows - r0),
+                     fft->bandWork(0));
+  const float scale = 1.0f / static_cast<float>(rows * cols);
+  for (int b = 0; b < fft->blocks; ++b) {
+    cmplx<Lanes> *col = &fft->bins[static_cast<size_t>(b) * rows];
+    fft->columnPlan.exec(col, 1.0f, true);
+    for (int r = 0; r < rows; ++r)
+      fft->kernel[static_cast<size_t>(b) * rows + r] = col[r].r * scale;
+  }
 
   fftPrepared = true;
 }
 
 void LeniaEngine::step() {
-  if (rows * cols >= kFFTThreshold) {
+  if (fftEnabled && rows * cols >= kFFTThreshold) {
+    events.reset(rows, cols);
     stepFFT();
   } else {
     stepDirect();
+    projectToGrid();
   }
-  projectToGrid();
   ++generation;
 }
 
 void LeniaEngine::stepDirect() {
   // Original direct convolution (fast for small grids)
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      float neighborSum = 0.0f;
-      int kidx = 0;
-      for (int dr = -kRadius; dr <= kRadius; ++dr) {
-        for (int dc = -kRadius; dc <= kRadius; ++dc) {
-          int nr = ((r + dr) % rows + rows) % rows;
-          int nc = ((c + dc) % cols + cols) % cols;
-          neighborSum += stateField[nr * Grid::kMaxCols + nc] * kernel[kidx];
-          ++kidx;
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    for (int r = rowBegin; r < rowEnd; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        float neighborSum = 0.0f;
+        int kidx = 0;
+        for (int dr = -kRadius; dr <= kRadius; ++dr) {
+          for (int dc = -kRadius; dc <= kRadius; ++dc) {
+            int nr = ((r + dr) % rows + rows) % rows;
+            int nc = ((c + dc) % cols + cols) % cols;
+            neighborSum += stateField[nr * cols + nc] * kernel[kidx];
+            ++kidx;
+          }
         }
-      }
 
-      // Normalize by kernel sum
-      float potential = (kernelSum > 0.0f) ? neighborSum / kernelSum : 0.0f;
+        // Normalize by kernel sum
+        float potential = (kernelSum > 0.0f) ? neighborSum / kernelSum : 0.0f;
 
-      // Growth function: Gaussian centered at mu, width sigma
-      float diff = potential - kMu;
-      float growth =
-          2.0f * std::exp(-0.5f * diff * diff / (kSigma * kSigma)) - 1.0f;
+        // Update state
+        int idx = r * cols + c;
+        scratch[idx] = stateField[idx] + kDt * growthOf(potential, kMu, kSigma);
 
-      // Update state
-      int idx = r * Grid::kMaxCols + c;
-      scratch[idx] = stateField[idx] + kDt * growth;
-
-      // Clamp to [0, 1]
-      if (scratch[idx] < 0.0f)
-        scratch[idx] = 0.0f;
-      if (scratch[idx] > 1.0f)
-        scratch[idx] = 1.0f;
+        // Clamp to [0, 1]
+        if (scratch[idx] < 0.0f)
+          scratch[idx] = 0.0f;
+        if (scratch[idx] > 1.0f)
+          scratch[idx] = 1.0f;
+      }
     }
-  }
+  });
 
-  std::copy(scratch.begin(), scratch.end(), stateField.begin());
+  // Swap front/back fields (every back cell was written above)
+  stateField.swap(scratch);
 }
 
 void LeniaEngine::stepFFT() {
   if (!fftPrepared)
     prepareFFT();
 
-  const size_t N = static_cast<size_t>(rows) * static_cast<size_t>(cols);
-  const size_t cCols = static_cast<size_t>(cols / 2 + 1);
-
-  // 1) Pack state field into contiguous real buffer (rows x cols, no kMaxCols
-  // stride)
-  fftReal.resize(N);
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      fftReal[static_cast<size_t>(r) * static_cast<size_t>(cols) +
-              static_cast<size_t>(c)] = stateField[r * Grid::kMaxCols + c];
-    }
-  }
-
-  // 2) Forward FFT of state field
-  pocketfft::shape_t shape = {static_cast<size_t>(rows),
-                              static_cast<size_t>(cols)};
-  pocketfft::stride_t strideIn = {static_cast<ptrdiff_t>(cols * sizeof(float)),
-                                  static_cast<ptrdiff_t>(sizeof(float))};
-  pocketfft::stride_t strideOut = {
-      static_cast<ptrdiff_t>(cCols * sizeof(std::complex<float>)),
-      static_cast<ptrdiff_t>(sizeof(std::complex<float>))};
-
-  fieldFFT.resize(static_cast<size_t>(rows) * cCols);
-  pocketfft::r2c(shape, strideIn, strideOut, {0, 1}, pocketfft::FORWARD,
-                 fftReal.data(), fieldFFT.data(), 1.0f);
-
-  // 3) Pointwise multiply in frequency domain
-  for (size_t i = 0; i < fieldFFT.size(); ++i) {
-    fieldFFT[i] *= kernelFFT[i];
-  }
-
-  // 4) Inverse FFT back to spatial domain
-  pocketfft::c2r(shape, strideOut, strideIn, {0, 1}, pocketfft::BACKWARD,
-                 fieldFFT.data(), fftReal.data(), 1.0f / static_cast<float>(N));
-
-  // 5) Apply growth function and update state
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      float potential =
-          fftReal[static_cast<size_t>(r) * static_cast<size_t>(cols) +
-                  static_cast<size_t>(c)];
-
-      // Growth function: Gaussian centered at mu, width sigma
-      float diff = potential - kMu;
-      float growth =
-          2.0f * std::exp(-0.5f * diff * diff / (kSigma * kSigma)) - 1.0f;
-
-      int idx = r * Grid::kMaxCols + c;
-      float newVal = stateField[idx] + kDt * growth;
-
-      // Clamp to [0, 1]
-      if (newVal < 0.0f)
-        newVal = 0.0f;
-      if (newVal > 1.0f)
-        newVal = 1.0f;
-
-      scratch[idx] = newVal;
+  // Row passes work on groups of kLanes rows; each band transforms in its
+  // own cols-vector buffer from FFTState (pocketfft's exec still allocates
+  // its internal scratch)
+  const int groups = (rows + kLanes - 1) / kLanes;
+
+  // 1) Forward transform of every row
+  forEachIndexedRowBand(groups, cols * kLanes, [&](int band, int groupBegin,
+                                                   int groupEnd) {
+    Lanes *work = fft->bandWork(band);
+    for (int g = groupBegin; g < groupEnd; ++g)
+      fft->forwardRows(stateField.data(), g * kLanes,
+                       std::min(kLanes, rows - g * kLanes), work);
+  });
+
+  // 2) Per column block: forward transform, multiply by the kernel
+  // spectrum, inverse transform
+  forEachRowBand(fft->blocks, rows * kLanes, [&](int blockBegin,
+                                                 int blockEnd) {
+    for (int b = blockBegin; b < blockEnd; ++b)
+      fft->convolveBlock(b);
+  });
+
+  // 3) One streaming pass: inverse row transforms, growth and projection.
+  // In place: the potential already holds every neighbor's old state.
+  forEachIndexedRowBand(groups, cols * kLanes, [&](int band, int groupBegin,
+                                                   int groupEnd) {
+    Lanes *work = fft->bandWork(band);
+    CellEventList::Writer out(events);
+    for (int g = groupBegin; g < groupEnd; ++g) {
+      const int r0 = g * kLanes;
+      const int n = std::min(kLanes, rows - r0);
+      fft->inverseRows(r0, n, work);
+      const float *potential = floatsOf(work);
+      for (int j = 0; j < n; ++j) {
+        float *state = &stateField[static_cast<size_t>(r0 + j) * cols];
+        for (int c = 0; c < cols; ++c) {
+          float newVal =
+              state[c] + kDt * growthOf(potential[c * kLanes + j], kMu, kSigma);
+          state[c] = std::min(1.0f, std::max(0.0f, newVal));
+        }
+        projectRow(r0 + j, out);
+      }
     }
-  }
-
-  std::copy(scratch.begin(), scratch.end(), stateField.begin());
+  });
 }
 
 void LeniaEngine::projectToGrid() {
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      int idx = r * Grid::kMaxCols + c;
-      float s = stateField[idx];
-      if (s > kThreshold) {
-        grid.setCell(r, c, 1);
-        grid.setAge(r, c, static_cast<uint16_t>(s * 255.0f));
-      } else {
-        grid.setCell(r, c, 0);
-        grid.setAge(r, c, 0);
-      }
-    }
+  events.reset(rows, cols);
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    CellEventList::Writer out(events);
+    for (int r = rowBegin; r < rowEnd; ++r)
+      projectRow(r, out);
+  });
+}
+
+void LeniaEngine::projectRow(int r, CellEventList::Writer &out) {
+  const float *state = &stateField[static_cast<size_t>(r) * cols];
+  uint8_t *cells = grid.cellRow(r);
+  uint16_t *ages = grid.ageRow(r);
+  for (int c = 0; c < cols; ++c) {
+    const float s = state[c];
+    const bool alive = s > kThreshold;
+    if (alive != (cells[c] != 0))
+      out.add(r, c, alive ? CellEvent::Birth : CellEvent::Death, s);
+    cells[c] = alive ? 1 : 0;
+    ages[c] = alive ? static_cast<uint16_t>(s * 255.0f) : 0;
   }
 }
 
 void LeniaEngine::randomize(uint64_t seed, float density) {
   generation = 0;
   uint64_t state = seed ? seed : 1;
-  fftPrepared = false; // Grid dimensions may have changed
 
   std::fill(stateField.begin(), stateField.end(), 0.0f);
 
@@ -223,7 +340,7 @@ void LeniaEngine::randomize(uint64_t seed, float density) {
     for (int c = 0; c < cols; ++c) {
       float val = static_cast<float>(xorshift64(state) >> 32) / 4294967296.0f;
       if (val < density) {
-        stateField[r * Grid::kMaxCols + c] = 0.5f + 0.5f * val;
+        stateField[r * cols + c] = 0.5f + 0.5f * val;
       }
     }
   }
@@ -234,7 +351,6 @@ void LeniaEngine::randomize(uint64_t seed, float density) {
 void LeniaEngine::randomizeSymmetric(uint64_t seed, float density) {
   generation = 0;
   uint64_t state = seed ? seed : 1;
-  fftPrepared = false;
   std::fill(stateField.begin(), stateField.end(), 0.0f);
 
   const int halfR = (rows + 1) / 2;
@@ -247,10 +363,10 @@ void LeniaEngine::randomizeSymmetric(uint64_t seed, float density) {
         float v = 0.5f + 0.5f * val;
         int mr = rows - 1 - r;
         int mc = cols - 1 - c;
-        stateField[r * Grid::kMaxCols + c] = v;
-        stateField[r * Grid::kMaxCols + mc] = v;
-        stateField[mr * Grid::kMaxCols + c] = v;
-        stateField[mr * Grid::kMaxCols + mc] = v;
+        stateField[r * cols + c] = v;
+        stateField[r * cols + mc] = v;
+        stateField[mr * cols + c] = v;
+        stateField[mr * cols + mc] = v;
       }
     }
   }
@@ -260,7 +376,6 @@ void LeniaEngine::randomizeSymmetric(uint64_t seed, float density) {
 
 void LeniaEngine::clear() {
   generation = 0;
-  fftPrepared = false;
   std::fill(stateField.begin(), stateField.end(), 0.0f);
   grid.clear();
 }
@@ -2,11 +2,10 @@
 
 #include "CellularEngine.h"
 #include "Grid.h"
-#include <complex>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
-
 /// Lenia: Continuous-neighborhood cellular automaton.
 /// Internal: float state field (0.0-1.0) with wide bell-curve kernel
 /// convolution (radius 3) and Gaussian growth function.
@@ -15,6 +14,7 @@
 class LeniaEngine final : public CellularEngine {
 public:
   explicit LeniaEngine(int rows = 12, int cols = 16);
+  ~LeniaEngine() override;
 
   // --- CellularEngine interface ---
   EngineType getType() const override { return EngineType::Lenia; }
@@ -31,22 +31,43 @@ public:
 
   // --- Engine-specific intensity ---
   float getCellIntensity(int row, int col) const override {
-    return stateField[row * Grid::kMaxCols + col];
+    return stateField[row * cols + col];
   }
   bool cellActivated(int row, int col) const override {
     // For continuous: use grid's wasBorn (threshold crossing projected)
     return getGrid().wasBorn(row, col);
   }
 
-  // --- Native data access for visualizer ---
+  // --- Native data access for visualizer (rows x cols, stride == cols) ---
   const float *getStateField() const { return stateField.data(); }
 
+  // --- Saved state: the state field ---
+  int getNumFields() const override { return 1; }
+  const float *getField(int index) const override {
+    return index == 0 ? stateField.data() : nullptr;
+  }
+  float *getFieldMutable(int index) override {
+    return index == 0 ? stateField.data() : nullptr;
+  }
+
+  /// FFT convolution for grids >= 64x64 (default). Off forces the direct
+  /// convolution everywhere (parity tests, benchmarks).
+  void setFFTEnabled(bool enabled) { fftEnabled = enabled; }
+  bool getFFTEnabled() const { return fftEnabled; }
+
+protected:
+  void workerPoolChanged() override;
+
 private:
+  struct FFTState; // cached pocketfft plans + spectra (LeniaEngine.cpp)
+
   void projectToGrid();
+  /// Threshold row r of the state field into the grid, recording events.
+  void projectRow(int r, CellEventList::Writer &out);
   void precomputeKernel();
   void stepDirect(); // Direct convolution for small grids
-  void stepFFT();    // FFT convolution for large grids
-  void prepareFFT(); // One-time FFT kernel setup
+  void stepFFT();    // FFT convolution for large grids; also projects
+  void prepareFFT(); // Plans + kernel spectrum (constructor / kernel change)
 
   // Lenia parameters
   static constexpr int kRadius = 5;
@@ -58,22 +79,24 @@ private:
   // FFT threshold: use FFT when grid has >= this many cells
   static constexpr int kFFTThreshold = 64 * 64;
 
-  static constexpr int kMax = Grid::kMaxRows * Grid::kMaxCols;
   static constexpr int kKernelSize = (2 * kRadius + 1) * (2 * kRadius + 1);
 
-  std::vector<float> stateField;
-  std::vector<float> scratch;
   float kernel[kKernelSize] = {};
   float kernelSum = 0.0f;
 
-  // FFT buffers (allocated on first FFT step)
+  // FFT plans and spectra, built in the constructor for grids >=
+  // kFFTThreshold; the kernel spectrum is redone only when the kernel
+  // changes.
   bool fftPrepared = false;
-  std::vector<std::complex<float>> kernelFFT;
-  std::vector<std::complex<float>> fieldFFT;
-  std::vector<float> fftReal; // Contiguous real buffer for FFT
+  bool fftEnabled = true;
+  std::unique_ptr<FFTState> fft;
 
   Grid grid;
   uint64_t generation = 0;
   int rows = 12;
   int cols = 16;
+
+  // Row-major, stride == cols (declared after rows/cols: sized from them)
+  std::vector<float> stateField;
+  std::vector<float> scratch;
 };
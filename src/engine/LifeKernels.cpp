@@ -0,0 +1,558 @@
+#include "LifeKernels.h"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define ALGO_LIFE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define ALGO_LIFE_X86 0
+#endif
+
+// GCC/Clang need per-function target attributes to emit AVX code without
+// raising the baseline for the whole translation unit. MSVC accepts the
+// intrinsics unconditionally.
+#if ALGO_LIFE_X86 && (defined(__GNUC__) || defined(__clang__))
+#define ALGO_TARGET_AVX2 __attribute__((target("avx2")))
+#define ALGO_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define ALGO_TARGET_AVX2
+#define ALGO_TARGET_AVX512
+#endif
+
+namespace {
+
+// Row kernels over words [wordBegin, wordEnd) (same argument order as
+// BitwiseGrid::stepLifeWords / stepBrainWords)
+using LifeRowFn = void (*)(const uint64_t *, const uint64_t *,
+                           const uint64_t *, uint64_t *, int, int, int, int,
+                           uint16_t, uint16_t);
+using BrainRowFn = void (*)(const uint64_t *, const uint64_t *,
+                            const uint64_t *, const uint64_t *, uint64_t *,
+                            uint64_t *, int, int, int, int);
+using CyclicRowFn = void (*)(const uint64_t *const *, const uint64_t *const *,
+                             const uint64_t *const *, uint64_t *const *, int,
+                             int, int, int, int, int);
+
+#if ALGO_LIFE_X86
+
+// --- CPUID feature detection ---
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool cpuHasAvx512() {
+#if defined(_MSC_VER)
+  if (!cpuHasAvx2())
+    return false;
+  // OS must save opmask + ZMM state (XCR0 bits 5-7)
+  if ((_xgetbv(0) & 0xE6) != 0xE6)
+    return false;
+  int info[4];
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 16)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f");
+#endif
+}
+
+// --- AVX2: 4 words (256 cells) per iteration ---
+
+ALGO_TARGET_AVX2 inline void fullAdd256(__m256i a, __m256i b, __m256i c,
+                                        __m256i &sum, __m256i &carry) {
+  const __m256i ab = _mm256_xor_si256(a, b);
+  sum = _mm256_xor_si256(ab, c);
+  carry = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(ab, c));
+}
+
+/// Neighbor-count bit planes for 4 interior words starting at w.
+ALGO_TARGET_AVX2 inline void countNeighbors256(const uint64_t *above,
+                                               const uint64_t *same,
+                                               const uint64_t *below, int w,
+                                               __m256i plane[4]) {
+  const uint64_t *rows[3] = {above, same, below};
+  __m256i west[3], centre[3], east[3];
+  for (int i = 0; i < 3; ++i) {
+    const __m256i x = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(rows[i] + w));
+    const __m256i xPrev = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(rows[i] + w - 1));
+    const __m256i xNext = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(rows[i] + w + 1));
+    centre[i] = x;
+    west[i] =
+        _mm256_or_si256(_mm256_slli_epi64(x, 1), _mm256_srli_epi64(xPrev, 63));
+    east[i] =
+        _mm256_or_si256(_mm256_srli_epi64(x, 1), _mm256_slli_epi64(xNext, 63));
+  }
+
+  // Same adder tree as BitwiseGrid::addNeighborPlanes
+  __m256i sA, cA, sB, cB, cD, t1, t2;
+  fullAdd256(west[0], centre[0], east[0], sA, cA);
+  fullAdd256(west[1], east[1], west[2], sB, cB);
+  const __m256i sC = _mm256_xor_si256(centre[2], east[2]);
+  const __m256i cC = _mm256_and_si256(centre[2], east[2]);
+  fullAdd256(sA, sB, sC, plane[0], cD);
+  fullAdd256(cA, cB, cC, t1, t2);
+  plane[1] = _mm256_xor_si256(t1, cD);
+  const __m256i t3 = _mm256_and_si256(t1, cD);
+  plane[2] = _mm256_xor_si256(t2, t3);
+  plane[3] = _mm256_and_si256(t2, t3);
+}
+
+ALGO_TARGET_AVX2 inline __m256i countEquals256(const __m256i plane[4], int n) {
+  __m256i result = _mm256_set1_epi64x(-1);
+  for (int bit = 0; bit < 4; ++bit) {
+    result = (n & (1 << bit)) ? _mm256_and_si256(result, plane[bit])
+                              : _mm256_andnot_si256(plane[bit], result);
+  }
+  return result;
+}
+
+ALGO_TARGET_AVX2 inline __m256i matchRule256(const __m256i plane[4],
+                                             uint16_t ruleMask) {
+  __m256i result = _mm256_setzero_si256();
+  for (int n = 0; n <= 8; ++n) {
+    if (ruleMask & (1u << n))
+      result = _mm256_or_si256(result, countEquals256(plane, n));
+  }
+  return result;
+}
+
+ALGO_TARGET_AVX2 void lifeRowAVX2(const uint64_t *above, const uint64_t *same,
+                                  const uint64_t *below, uint64_t *out,
+                                  int wordBegin, int wordEnd, int wordsPerRow,
+                                  int cols, uint16_t birth,
+                                  uint16_t survival) {
+  // Word 0 and the tail need the toroidal column wrap: scalar
+  int w = wordBegin;
+  if (w == 0 && wordEnd > 0)
+    out[w++] = BitwiseGrid::lifeWord(above, same, below, 0, wordsPerRow, cols,
+                                     birth, survival);
+  for (; w + 4 <= wordEnd && w + 4 < wordsPerRow; w += 4) {
+    __m256i plane[4];
+    countNeighbors256(above, same, below, w, plane);
+    const __m256i self =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(same + w));
+    const __m256i next =
+        _mm256_or_si256(_mm256_andnot_si256(self, matchRule256(plane, birth)),
+                        _mm256_and_si256(self, matchRule256(plane, survival)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + w), next);
+  }
+  for (; w < wordEnd; ++w)
+    out[w] = BitwiseGrid::lifeWord(above, same, below, w, wordsPerRow, cols,
+                                   birth, survival);
+  if (wordEnd == wordsPerRow)
+    out[wordsPerRow - 1] &= BitwiseGrid::lastWordMask(cols);
+}
+
+ALGO_TARGET_AVX2 void brainRowAVX2(const uint64_t *onAbove,
+                                   const uint64_t *onSame,
+                                   const uint64_t *onBelow,
+                                   const uint64_t *dyingSame, uint64_t *onOut,
+                                   uint64_t *dyingOut, int wordBegin,
+                                   int wordEnd, int wordsPerRow, int cols) {
+  int w = wordBegin;
+  if (w == 0 && wordEnd > 0)
+    onOut[w++] = BitwiseGrid::brainBirthWord(onAbove, onSame, onBelow,
+                                             dyingSame, 0, wordsPerRow, cols);
+  for (; w + 4 <= wordEnd && w + 4 < wordsPerRow; w += 4) {
+    __m256i plane[4];
+    countNeighbors256(onAbove, onSame, onBelow, w, plane);
+    const __m256i busy = _mm256_or_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(onSame + w)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dyingSame + w)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(onOut + w),
+                        _mm256_andnot_si256(busy, countEquals256(plane, 2)));
+  }
+  for (; w < wordEnd; ++w)
+    onOut[w] = BitwiseGrid::brainBirthWord(onAbove, onSame, onBelow, dyingSame,
+                                           w, wordsPerRow, cols);
+  if (wordEnd == wordsPerRow)
+    onOut[wordsPerRow - 1] &= BitwiseGrid::lastWordMask(cols);
+  for (int i = wordBegin; i < wordEnd; ++i)
+    dyingOut[i] = onSame[i];
+}
+
+ALGO_TARGET_AVX2 void cyclicRowAVX2(const uint64_t *const *above,
+                                    const uint64_t *const *same,
+                                    const uint64_t *const *below,
+                                    uint64_t *const *out, int numPlanes,
+                                    int numStates, int wordBegin, int wordEnd,
+                                    int wordsPerRow, int cols) {
+  constexpr int kPlanes = BitwiseGrid::kMaxStatePlanes;
+  int w = wordBegin;
+  if (w == 0 && wordEnd > 0)
+    BitwiseGrid::cyclicWord(above, same, below, out, numPlanes, numStates,
+                            w++, wordsPerRow, cols);
+  for (; w + 4 <= wordEnd && w + 4 < wordsPerRow; w += 4) {
+    // Successor planes (same increment as BitwiseGrid::cyclicSuccessor)
+    __m256i self[kPlanes], succ[kPlanes];
+    __m256i carry = _mm256_set1_epi64x(-1);
+    __m256i last = _mm256_set1_epi64x(-1);
+    for (int i = 0; i < numPlanes; ++i) {
+      self[i] =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(same[i] + w));
+      succ[i] = _mm256_xor_si256(self[i], carry);
+      carry = _mm256_and_si256(carry, self[i]);
+      last = (((numStates - 1) >> i) & 1)
+                 ? _mm256_and_si256(last, self[i])
+                 : _mm256_andnot_si256(self[i], last);
+    }
+    for (int i = 0; i < numPlanes; ++i)
+      succ[i] = _mm256_andnot_si256(last, succ[i]);
+
+    __m256i match[8];
+    for (__m256i &m : match)
+      m = _mm256_set1_epi64x(-1);
+    for (int i = 0; i < numPlanes; ++i) {
+      const uint64_t *rows[3] = {above[i], same[i], below[i]};
+      __m256i west[3], centre[3], east[3];
+      for (int k = 0; k < 3; ++k) {
+        const __m256i x = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(rows[k] + w));
+        const __m256i xPrev = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(rows[k] + w - 1));
+        const __m256i xNext = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(rows[k] + w + 1));
+        centre[k] = x;
+        west[k] = _mm256_or_si256(_mm256_slli_epi64(x, 1),
+                                  _mm256_srli_epi64(xPrev, 63));
+        east[k] = _mm256_or_si256(_mm256_srli_epi64(x, 1),
+                                  _mm256_slli_epi64(xNext, 63));
+      }
+      const __m256i n[8] = {west[0], centre[0], east[0], west[1],
+                            east[1], west[2],   centre[2], east[2]};
+      for (int d = 0; d < 8; ++d)
+        match[d] = _mm256_andnot_si256(_mm256_xor_si256(n[d], succ[i]),
+                                       match[d]);
+    }
+    __m256i advance = match[0];
+    for (int d = 1; d < 8; ++d)
+      advance = _mm256_or_si256(advance, match[d]);
+    for (int i = 0; i < numPlanes; ++i) {
+      const __m256i delta = _mm256_xor_si256(self[i], succ[i]);
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i *>(out[i] + w),
+          _mm256_xor_si256(self[i], _mm256_and_si256(advance, delta)));
+    }
+  }
+  for (; w < wordEnd; ++w)
+    BitwiseGrid::cyclicWord(above, same, below, out, numPlanes, numStates, w,
+                            wordsPerRow, cols);
+  if (wordEnd == wordsPerRow)
+    for (int i = 0; i < numPlanes; ++i)
+      out[i][wordsPerRow - 1] &= BitwiseGrid::lastWordMask(cols);
+}
+
+// --- AVX-512: 8 words (512 cells) per iteration ---
+
+// GCC 12's avx512fintrin.h seeds results with a self-initialised
+// _mm512_undefined_epi32(), which trips -Wmaybe-uninitialized once inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+ALGO_TARGET_AVX512 inline void fullAdd512(__m512i a, __m512i b, __m512i c,
+                                          __m512i &sum, __m512i &carry) {
+  const __m512i ab = _mm512_xor_si512(a, b);
+  sum = _mm512_xor_si512(ab, c);
+  carry = _mm512_or_si512(_mm512_and_si512(a, b), _mm512_and_si512(ab, c));
+}
+
+ALGO_TARGET_AVX512 inline void countNeighbors512(const uint64_t *above,
+                                                 const uint64_t *same,
+                                                 const uint64_t *below, int w,
+                                                 __m512i plane[4]) {
+  const uint64_t *rows[3] = {above, same, below};
+  __m512i west[3], centre[3], east[3];
+  for (int i = 0; i < 3; ++i) {
+    const __m512i x = _mm512_loadu_si512(rows[i] + w);
+    const __m512i xPrev = _mm512_loadu_si512(rows[i] + w - 1);
+    const __m512i xNext = _mm512_loadu_si512(rows[i] + w + 1);
+    centre[i] = x;
+    west[i] =
+        _mm512_or_si512(_mm512_slli_epi64(x, 1), _mm512_srli_epi64(xPrev, 63));
+    east[i] =
+        _mm512_or_si512(_mm512_srli_epi64(x, 1), _mm512_slli_epi64(xNext, 63));
+  }
+
+  __m512i sA, cA, sB, cB, cD, t1, t2;
+  fullAdd512(west[0], centre[0], east[0], sA, cA);
+  fullAdd512(west[1], east[1], west[2], sB, cB);
+  const __m512i sC = _mm512_xor_si512(centre[2], east[2]);
+  const __m512i cC = _mm512_and_si512(centre[2], east[2]);
+  fullAdd512(sA, sB, sC, plane[0], cD);
+  fullAdd512(cA, cB, cC, t1, t2);
+  plane[1] = _mm512_xor_si512(t1, cD);
+  const __m512i t3 = _mm512_and_si512(t1, cD);
+  plane[2] = _mm512_xor_si512(t2, t3);
+  plane[3] = _mm512_and_si512(t2, t3);
+}
+
+ALGO_TARGET_AVX512 inline __m512i countEquals512(const __m512i plane[4],
+                                                 int n) {
+  __m512i result = _mm512_set1_epi64(-1);
+  for (int bit = 0; bit < 4; ++bit) {
+    result = (n & (1 << bit)) ? _mm512_and_si512(result, plane[bit])
+                              : _mm512_andnot_si512(plane[bit], result);
+  }
+  return result;
+}
+
+ALGO_TARGET_AVX512 inline __m512i matchRule512(const __m512i plane[4],
+                                               uint16_t ruleMask) {
+  __m512i result = _mm512_setzero_si512();
+  for (int n = 0; n <= 8; ++n) {
+    if (ruleMask & (1u << n))
+      result = _mm512_or_si512(result, countEquals512(plane, n));
+  }
+  return result;
+}
+
+ALGO_TARGET_AVX512 void lifeRowAVX512(const uint64_t *above,
+                                      const uint64_t *same,
+                                      const uint64_t *below, uint64_t *out,
+                                      int wordBegin, int wordEnd,
+                                      int wordsPerRow, int cols,
+                                      uint16_t birth, uint16_t survival) {
+  int w = wordBegin;
+  if (w == 0 && wordEnd > 0)
+    out[w++] = BitwiseGrid::lifeWord(above, same, below, 0, wordsPerRow, cols,
+                                     birth, survival);
+  for (; w + 8 <= wordEnd && w + 8 < wordsPerRow; w += 8) {
+    __m512i plane[4];
+    countNeighbors512(above, same, below, w, plane);
+    const __m512i self = _mm512_loadu_si512(same + w);
+    const __m512i next =
+        _mm512_or_si512(_mm512_andnot_si512(self, matchRule512(plane, birth)),
+                        _mm512_and_si512(self, matchRule512(plane, survival)));
+    _mm512_storeu_si512(out + w, next);
+  }
+  for (; w < wordEnd; ++w)
+    out[w] = BitwiseGrid::lifeWord(above, same, below, w, wordsPerRow, cols,
+                                   birth, survival);
+  if (wordEnd == wordsPerRow)
+    out[wordsPerRow - 1] &= BitwiseGrid::lastWordMask(cols);
+}
+
+ALGO_TARGET_AVX512 void brainRowAVX512(const uint64_t *onAbove,
+                                       const uint64_t *onSame,
+                                       const uint64_t *onBelow,
+                                       const uint64_t *dyingSame,
+                                       uint64_t *onOut, uint64_t *dyingOut,
+                                       int wordBegin, int wordEnd,
+                                       int wordsPerRow, int cols) {
+  int w = wordBegin;
+  if (w == 0 && wordEnd > 0)
+    onOut[w++] = BitwiseGrid::brainBirthWord(onAbove, onSame, onBelow,
+                                             dyingSame, 0, wordsPerRow, cols);
+  for (; w + 8 <= wordEnd && w + 8 < wordsPerRow; w += 8) {
+    __m512i plane[4];
+    countNeighbors512(onAbove, onSame, onBelow, w, plane);
+    const __m512i busy = _mm512_or_si512(_mm512_loadu_si512(onSame + w),
+                                         _mm512_loadu_si512(dyingSame + w));
+    _mm512_storeu_si512(onOut + w,
+                        _mm512_andnot_si512(busy, countEquals512(plane, 2)));
+  }
+  for (; w < wordEnd; ++w)
+    onOut[w] = BitwiseGrid::brainBirthWord(onAbove, onSame, onBelow, dyingSame,
+                                           w, wordsPerRow, cols);
+  if (wordEnd == wordsPerRow)
+    onOut[wordsPerRow - 1] &= BitwiseGrid::lastWordMask(cols);
+  for (int i = wordBegin; i < wordEnd; ++i)
+    dyingOut[i] = onSame[i];
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // ALGO_LIFE_X86
+
+std::atomic<int> &selectedIsa() {
+  static std::atomic<int> isa{
+      static_cast<int>(LifeKernels::detectBestIsa())};
+  return isa;
+}
+
+LifeRowFn lifeRowFor(LifeKernels::Isa isa) {
+#if ALGO_LIFE_X86
+  if (isa == LifeKernels::Isa::AVX512)
+    return lifeRowAVX512;
+  if (isa == LifeKernels::Isa::AVX2)
+    return lifeRowAVX2;
+#endif
+  (void)isa;
+  return BitwiseGrid::stepLifeWords;
+}
+
+BrainRowFn brainRowFor(LifeKernels::Isa isa) {
+#if ALGO_LIFE_X86
+  if (isa == LifeKernels::Isa::AVX512)
+    return brainRowAVX512;
+  if (isa == LifeKernels::Isa::AVX2)
+    return brainRowAVX2;
+#endif
+  (void)isa;
+  return BitwiseGrid::stepBrainWords;
+}
+
+CyclicRowFn cyclicRowFor(LifeKernels::Isa isa) {
+#if ALGO_LIFE_X86
+  // No AVX-512 variant: AVX-512 CPUs run the AVX2 kernel
+  if (isa != LifeKernels::Isa::Scalar)
+    return cyclicRowAVX2;
+#endif
+  (void)isa;
+  return BitwiseGrid::stepCyclicWords;
+}
+
+} // namespace
+
+LifeKernels::Isa LifeKernels::detectBestIsa() {
+#if ALGO_LIFE_X86
+  if (cpuHasAvx512())
+    return Isa::AVX512;
+  if (cpuHasAvx2())
+    return Isa::AVX2;
+#endif
+  return Isa::Scalar;
+}
+
+bool LifeKernels::isSupported(Isa isa) {
+  return static_cast<int>(isa) <= static_cast<int>(detectBestIsa());
+}
+
+LifeKernels::Isa LifeKernels::getIsa() {
+  return static_cast<Isa>(selectedIsa().load(std::memory_order_relaxed));
+}
+
+bool LifeKernels::setIsa(Isa isa) {
+  if (!isSupported(isa))
+    return false;
+  selectedIsa().store(static_cast<int>(isa), std::memory_order_relaxed);
+  return true;
+}
+
+const char *LifeKernels::getIsaName(Isa isa) {
+  switch (isa) {
+  case Isa::AVX2:
+    return "AVX2";
+  case Isa::AVX512:
+    return "AVX-512";
+  default:
+    return "Scalar";
+  }
+}
+
+void LifeKernels::stepLife(const BitwiseGrid &cur, BitwiseGrid &next,
+                           uint16_t birthRule, uint16_t survivalRule) {
+  stepLife(cur, next, birthRule, survivalRule, 0, cur.getRows());
+}
+
+void LifeKernels::stepLife(const BitwiseGrid &cur, BitwiseGrid &next,
+                           uint16_t birthRule, uint16_t survivalRule,
+                           int rowBegin, int rowEnd) {
+  stepLife(cur, next, birthRule, survivalRule, rowBegin, rowEnd, 0,
+           cur.getWordsPerRow());
+}
+
+void LifeKernels::stepLife(const BitwiseGrid &cur, BitwiseGrid &next,
+                           uint16_t birthRule, uint16_t survivalRule,
+                           int rowBegin, int rowEnd, int wordBegin,
+                           int wordEnd) {
+  const int rows = cur.getRows();
+  const int cols = cur.getCols();
+  const int wordsPerRow = cur.getWordsPerRow();
+  const LifeRowFn rowFn = lifeRowFor(getIsa());
+
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const int rAbove = (r == 0) ? rows - 1 : r - 1;
+    const int rBelow = (r == rows - 1) ? 0 : r + 1;
+    rowFn(cur.rowData(rAbove), cur.rowData(r), cur.rowData(rBelow),
+          next.rowData(r), wordBegin, wordEnd, wordsPerRow, cols, birthRule,
+          survivalRule);
+  }
+}
+
+void LifeKernels::stepBriansBrain(const BitwiseGrid &on,
+                                  const BitwiseGrid &dying,
+                                  BitwiseGrid &onNext,
+                                  BitwiseGrid &dyingNext) {
+  stepBriansBrain(on, dying, onNext, dyingNext, 0, on.getRows());
+}
+
+void LifeKernels::stepBriansBrain(const BitwiseGrid &on,
+                                  const BitwiseGrid &dying,
+                                  BitwiseGrid &onNext, BitwiseGrid &dyingNext,
+                                  int rowBegin, int rowEnd) {
+  stepBriansBrain(on, dying, onNext, dyingNext, rowBegin, rowEnd, 0,
+                  on.getWordsPerRow());
+}
+
+void LifeKernels::stepBriansBrain(const BitwiseGrid &on,
+                                  const BitwiseGrid &dying,
+                                  BitwiseGrid &onNext, BitwiseGrid &dyingNext,
+                                  int rowBegin, int rowEnd, int wordBegin,
+                                  int wordEnd) {
+  const int rows = on.getRows();
+  const int cols = on.getCols();
+  const int wordsPerRow = on.getWordsPerRow();
+  const BrainRowFn rowFn = brainRowFor(getIsa());
+
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const int rAbove = (r == 0) ? rows - 1 : r - 1;
+    const int rBelow = (r == rows - 1) ? 0 : r + 1;
+    rowFn(on.rowData(rAbove), on.rowData(r), on.rowData(rBelow),
+          dying.rowData(r), onNext.rowData(r), dyingNext.rowData(r),
+          wordBegin, wordEnd, wordsPerRow, cols);
+  }
+}
+
+void LifeKernels::stepCyclic(const BitwiseGrid *planes,
+                             BitwiseGrid *nextPlanes, int numPlanes,
+                             int numStates, int rowBegin, int rowEnd) {
+  const int rows = planes[0].getRows();
+  const int cols = planes[0].getCols();
+  const int wordsPerRow = planes[0].getWordsPerRow();
+  const CyclicRowFn rowFn = cyclicRowFor(getIsa());
+
+  const uint64_t *above[BitwiseGrid::kMaxStatePlanes];
+  const uint64_t *same[BitwiseGrid::kMaxStatePlanes];
+  const uint64_t *below[BitwiseGrid::kMaxStatePlanes];
+  uint64_t *out[BitwiseGrid::kMaxStatePlanes];
+  for (int r = rowBegin; r < rowEnd; ++r) {
+    const int rAbove = (r == 0) ? rows - 1 : r - 1;
+    const int rBelow = (r == rows - 1) ? 0 : r + 1;
+    for (int i = 0; i < numPlanes; ++i) {
+      above[i] = planes[i].rowData(rAbove);
+      same[i] = planes[i].rowData(r);
+      below[i] = planes[i].rowData(rBelow);
+      out[i] = nextPlanes[i].rowData(r);
+    }
+    rowFn(above, same, below, out, numPlanes, numStates, 0, wordsPerRow,
+          wordsPerRow, cols);
+  }
+}
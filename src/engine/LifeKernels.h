@@ -0,0 +1,72 @@
+#pragma once
+
+#include "BitwiseGrid.h"
+#include <cstdint>
+
+/// Runtime-dispatched SIMD kernels for binary cellular automata held in
+/// BitwiseGrid layout. AVX2 processes 4 words (256 cells) and AVX-512 8 words
+/// (512 cells) per instruction; the scalar path handles one 64-cell word.
+///
+/// Multi-state automata are bit-sliced: one BitwiseGrid per bit of the
+/// state.
+///
+/// The instruction set is chosen once via CPUID on first use. All kernels are
+/// bit-exact with the scalar BitwiseGrid row functions and allocation-free.
+class LifeKernels {
+public:
+  enum class Isa : int { Scalar = 0, AVX2, AVX512 };
+
+  /// Best instruction set supported by this CPU and OS.
+  static Isa detectBestIsa();
+
+  /// Instruction set currently used by the step functions.
+  static Isa getIsa();
+
+  /// Force an instruction set (tests / benchmarks). Returns false and leaves
+  /// the selection unchanged if this CPU does not support it.
+  static bool setIsa(Isa isa);
+
+  static bool isSupported(Isa isa);
+  static const char *getIsaName(Isa isa);
+
+  /// Advance a Life-like (B/S) rule one generation, toroidal in both axes.
+  /// cur and next must have identical dimensions.
+  static void stepLife(const BitwiseGrid &cur, BitwiseGrid &next,
+                       uint16_t birthRule, uint16_t survivalRule);
+
+  /// Same, writing only rows [rowBegin, rowEnd) of next (one row band).
+  static void stepLife(const BitwiseGrid &cur, BitwiseGrid &next,
+                       uint16_t birthRule, uint16_t survivalRule,
+                       int rowBegin, int rowEnd);
+
+  /// Same, writing only words [wordBegin, wordEnd) of those rows (a run of
+  /// active 64-column tiles).
+  static void stepLife(const BitwiseGrid &cur, BitwiseGrid &next,
+                       uint16_t birthRule, uint16_t survivalRule,
+                       int rowBegin, int rowEnd, int wordBegin, int wordEnd);
+
+  /// Advance Brian's Brain one generation held as two bit planes
+  /// (On = firing, Dying = refractory), toroidal in both axes.
+  static void stepBriansBrain(const BitwiseGrid &on, const BitwiseGrid &dying,
+                              BitwiseGrid &onNext, BitwiseGrid &dyingNext);
+
+  /// Same, writing only rows [rowBegin, rowEnd) of the next planes.
+  static void stepBriansBrain(const BitwiseGrid &on, const BitwiseGrid &dying,
+                              BitwiseGrid &onNext, BitwiseGrid &dyingNext,
+                              int rowBegin, int rowEnd);
+
+  /// Same, writing only words [wordBegin, wordEnd) of those rows.
+  static void stepBriansBrain(const BitwiseGrid &on, const BitwiseGrid &dying,
+                              BitwiseGrid &onNext, BitwiseGrid &dyingNext,
+                              int rowBegin, int rowEnd, int wordBegin,
+                              int wordEnd);
+
+  /// Advance a cyclic CA one generation, toroidal in both axes. The state
+  /// is bit-sliced over numPlanes grids (state = sum of plane i << i;
+  /// numStates <= 1 << numPlanes; numPlanes <= BitwiseGrid::kMaxStatePlanes).
+  /// Writes rows [rowBegin, rowEnd) of nextPlanes. AVX-512 runs the AVX2
+  /// kernel.
+  static void stepCyclic(const BitwiseGrid *planes, BitwiseGrid *nextPlanes,
+                         int numPlanes, int numStates, int rowBegin,
+                         int rowEnd);
+};
@@ -31,6 +31,14 @@ public:
     return normalized * level;
   }
 
+  /// Add the next n samples to out (same values as n nextSample() calls).
+  void addBlock(float *out, int n) {
+    if (level <= 0.0)
+      return;
+    for (int i = 0; i < n; ++i)
+      out[i] += static_cast<float>(nextSample());
+  }
+
 private:
   double level = 0.0;
   uint64_t state = 12345ULL;
@@ -1,4 +1,5 @@
 #include "ParticleSwarm.h"
+#include "CounterRng.h"
 #include <algorithm>
 #include <cmath>
 
@@ -13,123 +14,204 @@ uint64_t xorshift64(uint64_t &state) {
 float randFloat(uint64_t &state) {
   return static_cast<float>(xorshift64(state) >> 32) / 4294967296.0f;
 }
+
+// Relative cost of one particle update against one grid cell, for
+// forEachRowBand() (a 3x3 bucket neighbourhood holds a few dozen particles)
+constexpr int kWorkPerParticle = 32;
 } // namespace
 
-ParticleSwarm::ParticleSwarm(int r, int c)
-    : trail(Grid::kMaxCells, 0.0f), grid(r, c), rows(r), cols(c) {}
+int ParticleSwarm::defaultParticleCount(int rows, int cols) {
+  return std::clamp(rows * cols / kCellsPerParticle, kMinParticles,
+                    kMaxParticles);
+}
+
+ParticleSwarm::ParticleSwarm(int r, int c, int particles)
+    : grid(r, c), rows(grid.getRows()), cols(grid.getCols()),
+      trail(rows, cols, kTrailDecay, 1.0f, kTrailThreshold) {
+  const int radius = static_cast<int>(kNeighborRadius);
+  bucketCols = (cols + radius - 1) / radius;
+  bucketRows = (rows + radius - 1) / radius;
+  bucketStart.assign(static_cast<size_t>(bucketCols) * bucketRows + 1, 0);
+  setNumParticles(particles == kAutoParticles ? defaultParticleCount(rows, cols)
+                                              : particles);
+}
+
+void ParticleSwarm::setNumParticles(int count) {
+  count = std::clamp(count, 1, kMaxParticles);
+  const int previous = numParticles;
+  numParticles = count;
+  const auto n = static_cast<size_t>(count);
+  for (auto *v : {&px, &py, &pvx, &pvy, &sx, &sy, &svx, &svy})
+    v->resize(n, 0.0f);
+  bucketOf.resize(n);
+  for (int i = previous; i < count; ++i) {
+    px[i] = randFloat(rng) * cols;
+    py[i] = randFloat(rng) * rows;
+  }
+}
 
 void ParticleSwarm::step() {
   // Compute center of mass
-  float cx = 0.0f, cy = 0.0f;
-  for (int i = 0; i < kNumParticles; ++i) {
-    cx += particles[i].x;
-    cy += particles[i].y;
+  double sumX = 0.0, sumY = 0.0;
+  for (int i = 0; i < numParticles; ++i) {
+    sumX += px[i];
+    sumY += py[i];
   }
-  cx /= kNumParticles;
-  cy /= kNumParticles;
+  const auto cx = static_cast<float>(sumX / numParticles);
+  const auto cy = static_cast<float>(sumY / numParticles);
 
-  // Update each particle
-  for (int i = 0; i < kNumParticles; ++i) {
-    auto &p = particles[i];
+  // Sort the current state into buckets, then update every particle from
+  // that copy
+  buildCellList();
+  const uint32_t key = CounterRng::stepKey(jitterSeed, generation);
+  forEachRowBand(numParticles, kWorkPerParticle, [&](int begin, int end) {
+    updateParticles(begin, end, cx, cy, key);
+  });
+
+  // Deposit trail (serial: particles share cells)
+  const bool dense = trail.beginStep(numParticles, grid);
+  for (int i = 0; i < numParticles; ++i) {
+    int gr = static_cast<int>(py[i]) % rows;
+    int gc = static_cast<int>(px[i]) % cols;
+    if (gr >= 0 && gr < rows && gc >= 0 && gc < cols)
+      trail.addHit(gr * cols + gc);
+  }
+
+  // Decay trail and project: one row at a time, or only the visited and
+  // live cells when the swarm is sparse
+  events.reset(rows, cols);
+  if (dense) {
+    uint8_t *const hits[] = {trail.getHitPlane()};
+    forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+      CellEventList::Writer out(events);
+      trail.stepRows(rowBegin, rowEnd, hits, 1, grid, out);
+    });
+  } else {
+    CellEventList::Writer out(events);
+    trail.stepSparse(grid, out);
+  }
+  trail.endStep();
+  ++generation;
+}
+
+void ParticleSwarm::buildCellList() {
+  // Counting sort by bucket; stable, so the order is deterministic
+  const float toBucket = 1.0f / kNeighborRadius;
+  const int numBuckets = bucketCols * bucketRows;
+  std::fill(bucketStart.begin(), bucketStart.end(), 0);
+  for (int i = 0; i < numParticles; ++i) {
+    const int bx = std::min(static_cast<int>(px[i] * toBucket), bucketCols - 1);
+    const int by = std::min(static_cast<int>(py[i] * toBucket), bucketRows - 1);
+    const int b = std::max(0, by) * bucketCols + std::max(0, bx);
+    bucketOf[i] = b;
+    ++bucketStart[b];
+  }
+  for (int b = 1; b < numBuckets; ++b) // bucketStart[b] = end of bucket b
+    bucketStart[b] += bucketStart[b - 1];
+  for (int i = numParticles - 1; i >= 0; --i) {
+    const int s = --bucketStart[bucketOf[i]]; // ends up at the start
+    sx[s] = px[i];
+    sy[s] = py[i];
+    svx[s] = pvx[i];
+    svy[s] = pvy[i];
+  }
+  bucketStart[numBuckets] = numParticles;
+}
 
-    // Flocking: average velocity of nearby particles
-    float avgVx = 0.0f, avgVy = 0.0f;
+void ParticleSwarm::updateParticles(int begin, int end, float cx, float cy,
+                                    uint32_t key) {
+  const float toBucket = 1.0f / kNeighborRadius;
+  const float radius2 = kNeighborRadius * kNeighborRadius;
+
+  // Flocking: average velocity of particles within the radius, from the
+  // 3x3 buckets around each particle (each bucket row is one contiguous
+  // range of the sorted arrays). Kept in pvx / pvy until the update below.
+  for (int s = begin; s < end; ++s) {
+    const float x = sx[s], y = sy[s];
+    const int bx = std::min(static_cast<int>(x * toBucket), bucketCols - 1);
+    const int by = std::min(static_cast<int>(y * toBucket), bucketRows - 1);
+    const int bx0 = std::max(0, bx - 1), bx1 = std::min(bucketCols - 1, bx + 1);
+    float sumVx = 0.0f, sumVy = 0.0f;
     int neighbors = 0;
-    for (int j = 0; j < kNumParticles; ++j) {
-      if (j == i)
-        continue;
-      float dx = particles[j].x - p.x;
-      float dy = particles[j].y - p.y;
-      float dist = std::sqrt(dx * dx + dy * dy);
-      if (dist < 4.0f) {
-        avgVx += particles[j].vx;
-        avgVy += particles[j].vy;
-        ++neighbors;
+    for (int r = std::max(0, by - 1); r <= std::min(bucketRows - 1, by + 1);
+         ++r) {
+      const int j0 = bucketStart[r * bucketCols + bx0];
+      const int j1 = bucketStart[r * bucketCols + bx1 + 1];
+      for (int j = j0; j < j1; ++j) {
+        const float dx = sx[j] - x;
+        const float dy = sy[j] - y;
+        const bool near = dx * dx + dy * dy < radius2 && j != s;
+        sumVx += near ? svx[j] : 0.0f;
+        sumVy += near ? svy[j] : 0.0f;
+        neighbors += near ? 1 : 0;
       }
     }
-    if (neighbors > 0) {
-      avgVx /= neighbors;
-      avgVy /= neighbors;
-      p.vx += (avgVx - p.vx) * kFlockWeight;
-      p.vy += (avgVy - p.vy) * kFlockWeight;
-    }
+    pvx[s] = neighbors > 0 ? sumVx / static_cast<float>(neighbors) : svx[s];
+    pvy[s] = neighbors > 0 ? sumVy / static_cast<float>(neighbors) : svy[s];
+  }
+
+  // Velocity and position update: branch-free over the band
+  const auto fcols = static_cast<float>(cols);
+  const auto frows = static_cast<float>(rows);
+  const float maxX = std::nextafter(fcols, 0.0f);
+  const float maxY = std::nextafter(frows, 0.0f);
+  for (int s = begin; s < end; ++s) {
+    float vx = svx[s], vy = svy[s];
+    vx += (pvx[s] - vx) * kFlockWeight;
+    vy += (pvy[s] - vy) * kFlockWeight;
 
     // Attract toward center of mass
-    p.vx += (cx - p.x) * kCenterWeight;
-    p.vy += (cy - p.y) * kCenterWeight;
+    vx += (cx - sx[s]) * kCenterWeight;
+    vy += (cy - sy[s]) * kCenterWeight;
 
     // Random jitter
-    p.vx += (randFloat(rng) - 0.5f) * 0.3f;
-    p.vy += (randFloat(rng) - 0.5f) * 0.3f;
+    const uint32_t h = CounterRng::bits(key, static_cast<uint32_t>(s));
+    vx += (CounterRng::unitFloatLow(h) - 0.5f) * 0.3f;
+    vy += (CounterRng::unitFloatHigh(h) - 0.5f) * 0.3f;
 
     // Clamp speed
-    float speed = std::sqrt(p.vx * p.vx + p.vy * p.vy);
-    if (speed > kMaxSpeed) {
-      p.vx = p.vx / speed * kMaxSpeed;
-      p.vy = p.vy / speed * kMaxSpeed;
-    }
+    const float speed = std::sqrt(vx * vx + vy * vy);
+    const float scale = kMaxSpeed / std::max(speed, kMaxSpeed);
+    vx *= scale;
+    vy *= scale;
 
-    // Move (toroidal)
-    p.x += p.vx;
-    p.y += p.vy;
-    if (p.x < 0)
-      p.x += cols;
-    if (p.x >= cols)
-      p.x -= cols;
-    if (p.y < 0)
-      p.y += rows;
-    if (p.y >= rows)
-      p.y -= rows;
-
-    // Deposit trail
-    int gr = static_cast<int>(p.y) % rows;
-    int gc = static_cast<int>(p.x) % cols;
-    if (gr >= 0 && gr < rows && gc >= 0 && gc < cols) {
-      trail[gr * Grid::kMaxCols + gc] = 1.0f;
-    }
-  }
+    // Move (toroidal, as integer masks; min() catches -epsilon + cols
+    // rounding up to cols)
+    float x = sx[s] + vx;
+    float y = sy[s] + vy;
+    const int wrapX = (x < 0.0f) - (x >= fcols);
+    const int wrapY = (y < 0.0f) - (y >= frows);
+    x = std::min(x + fcols * static_cast<float>(wrapX), maxX);
+    y = std::min(y + frows * static_cast<float>(wrapY), maxY);
 
-  // Decay trail
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      float &t = trail[r * Grid::kMaxCols + c];
-      t *= kTrailDecay;
-      if (t < 0.01f)
-        t = 0.0f;
-    }
+    px[s] = x;
+    py[s] = y;
+    pvx[s] = vx;
+    pvy[s] = vy;
   }
-
-  projectToGrid();
-  ++generation;
 }
 
 void ParticleSwarm::projectToGrid() {
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      float t = trail[r * Grid::kMaxCols + c];
-      if (t > 0.05f) {
-        grid.setCell(r, c, 1);
-        grid.setAge(r, c, static_cast<uint16_t>(t * 255.0f));
-      } else {
-        grid.setCell(r, c, 0);
-        grid.setAge(r, c, 0);
-      }
-    }
-  }
+  events.reset(rows, cols);
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    CellEventList::Writer out(events);
+    trail.projectRows(rowBegin, rowEnd, grid, out);
+  });
 }
 
 void ParticleSwarm::randomize(uint64_t seed, float density) {
   generation = 0;
   rng = seed ? seed : 1;
+  jitterSeed = rng;
   (void)density;
 
-  std::fill(trail.begin(), trail.end(), 0.0f);
+  trail.clear();
 
-  for (int i = 0; i < kNumParticles; ++i) {
-    particles[i].x = randFloat(rng) * cols;
-    particles[i].y = randFloat(rng) * rows;
-    particles[i].vx = (randFloat(rng) - 0.5f) * 2.0f;
-    particles[i].vy = (randFloat(rng) - 0.5f) * 2.0f;
+  for (int i = 0; i < numParticles; ++i) {
+    px[i] = randFloat(rng) * cols;
+    py[i] = randFloat(rng) * rows;
+    pvx[i] = (randFloat(rng) - 0.5f) * 2.0f;
+    pvy[i] = (randFloat(rng) - 0.5f) * 2.0f;
   }
 
   projectToGrid();
@@ -138,12 +220,14 @@ void ParticleSwarm::randomize(uint64_t seed, float density) {
 void ParticleSwarm::randomizeSymmetric(uint64_t seed, float density) {
   generation = 0;
   rng = seed ? seed : 1;
+  jitterSeed = rng;
   (void)density;
 
-  std::fill(trail.begin(), trail.end(), 0.0f);
+  trail.clear();
 
-  // Place particles symmetrically (4 quadrants)
-  int perQuadrant = kNumParticles / 4;
+  // Place particles symmetrically (4 quadrants); a remainder waits at
+  // the center, which is its own mirror image
+  int perQuadrant = numParticles / 4;
   for (int i = 0; i < perQuadrant; ++i) {
     float x = randFloat(rng) * (cols / 2.0f);
     float y = randFloat(rng) * (rows / 2.0f);
@@ -151,10 +235,22 @@ void ParticleSwarm::randomizeSymmetric(uint64_t seed, float density) {
     float vy = (randFloat(rng) - 0.5f) * 2.0f;
 
     int base = i * 4;
-    particles[base] = {x, y, vx, vy};
-    particles[base + 1] = {cols - x, y, -vx, vy};
-    particles[base + 2] = {x, rows - y, vx, -vy};
-    particles[base + 3] = {cols - x, rows - y, -vx, -vy};
+    const float xs[4] = {x, cols - x, x, cols - x};
+    const float ys[4] = {y, y, rows - y, rows - y};
+    const float vxs[4] = {vx, -vx, vx, -vx};
+    const float vys[4] = {vy, vy, -vy, -vy};
+    for (int q = 0; q < 4; ++q) {
+      px[base + q] = xs[q];
+      py[base + q] = ys[q];
+      pvx[base + q] = vxs[q];
+      pvy[base + q] = vys[q];
+    }
+  }
+  for (int i = perQuadrant * 4; i < numParticles; ++i) {
+    px[i] = cols / 2.0f;
+    py[i] = rows / 2.0f;
+    pvx[i] = 0.0f;
+    pvy[i] = 0.0f;
   }
 
   projectToGrid();
@@ -162,8 +258,8 @@ void ParticleSwarm::randomizeSymmetric(uint64_t seed, float density) {
 
 void ParticleSwarm::clear() {
   generation = 0;
-  std::fill(trail.begin(), trail.end(), 0.0f);
-  for (int i = 0; i < kNumParticles; ++i)
-    particles[i] = {};
+  trail.clear();
+  for (auto *v : {&px, &py, &pvx, &pvy})
+    std::fill(v->begin(), v->end(), 0.0f);
   grid.clear();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CellularEngine.h"
+#include "DecayField.h"
 #include "Grid.h"
 #include <cstdint>
 #include <vector>
@@ -8,18 +9,36 @@
 /// Particle Swarm: pool of particles with flocking behavior.
 /// Internal: float positions + velocities for each particle.
 /// Grid projection: trail deposit + decay produces flowing patterns.
+///
+/// Particles are stored as structure-of-arrays. Each step sorts them into
+/// a cell list of kNeighborRadius-sized buckets, so flocking only looks at
+/// the 3x3 buckets around a particle instead of every other particle, then
+/// updates them across the worker pool. Every particle reads the previous
+/// step's state only, and its jitter comes from a hash of (seed,
+/// generation, index), so results do not depend on the thread count.
 class ParticleSwarm final : public CellularEngine {
 public:
-  static constexpr int kNumParticles = 24;
+  /// Particle count chosen from the grid area (constructor default).
+  static constexpr int kAutoParticles = 0;
+  static constexpr int kMinParticles = 24;
+  static constexpr int kMaxParticles = 1 << 18;
+  /// Grid cells per particle for kAutoParticles.
+  static constexpr int kCellsPerParticle = 128;
+  /// Flocking radius, also the cell list bucket size.
+  static constexpr float kNeighborRadius = 4.0f;
 
-  struct Particle {
-    float x = 0.0f;
-    float y = 0.0f;
-    float vx = 0.0f;
-    float vy = 0.0f;
-  };
+  static int defaultParticleCount(int rows, int cols);
 
-  explicit ParticleSwarm(int rows = 12, int cols = 16);
+  /// @param numParticles  1..kMaxParticles, or kAutoParticles for
+  ///                       defaultParticleCount(rows, cols).
+  explicit ParticleSwarm(int rows = 12, int cols = 16,
+                         int numParticles = kAutoParticles);
+
+  /// Resize the pool (clamped to [1, kMaxParticles]). Existing particles
+  /// keep their state; added ones start at rest at random positions. Not
+  /// while step() runs.
+  void setNumParticles(int numParticles);
+  int getNumParticles() const { return numParticles; }
 
   // --- CellularEngine interface ---
   EngineType getType() const override { return EngineType::ParticleSwarm; }
@@ -28,7 +47,10 @@ public:
   void randomizeSymmetric(uint64_t seed, float density) override;
   void clear() override;
   const Grid &getGrid() const override { return grid; }
-  Grid &getGridMutable() override { return grid; }
+  Grid &getGridMutable() override {
+    trail.markGridStale();
+    return grid;
+  }
   uint64_t getGeneration() const override { return generation; }
   const char *getName() const override { return "Particle Swarm"; }
   int getDefaultTriggerBudget() const override { return 4; }
@@ -36,32 +58,58 @@ public:
 
   // --- Engine-specific intensity ---
   float getCellIntensity(int row, int col) const override {
-    float t = trail[row * Grid::kMaxCols + col];
+    float t = trail.value(row * cols + col);
     return (t > 1.0f) ? 1.0f : ((t < 0.0f) ? 0.0f : t);
   }
   bool cellActivated(int row, int col) const override {
     return getGrid().wasBorn(row, col);
   }
 
-  // --- Native data access for visualizer ---
-  const Particle *getParticles() const { return particles; }
-  const float *getTrailField() const { return trail.data(); }
+  // --- Native data access for visualizer (rows x cols, stride == cols) ---
+  // Particle arrays hold getNumParticles() values; the order changes every
+  // step (bucket order).
+  const float *getParticleX() const { return px.data(); }
+  const float *getParticleY() const { return py.data(); }
+  const float *getParticleVX() const { return pvx.data(); }
+  const float *getParticleVY() const { return pvy.data(); }
+  // Trail decayed to the current generation into out (rows x cols):
+  // O(rows x cols), for tests and diagnostics. Safe alongside other
+  // readers; not while step() runs.
+  void materializeTrail(float *out) const { trail.materialize(out); }
 
 private:
+  void buildCellList();
+  void updateParticles(int begin, int end, float cx, float cy, uint32_t key);
   void projectToGrid();
 
-  static constexpr int kMax = Grid::kMaxRows * Grid::kMaxCols;
   static constexpr float kTrailDecay = 0.92f;
+  static constexpr float kTrailThreshold = 0.05f;
   static constexpr float kMaxSpeed = 1.5f;
   static constexpr float kFlockWeight = 0.05f;
   static constexpr float kCenterWeight = 0.01f;
 
-  Particle particles[kNumParticles] = {};
-  std::vector<float> trail;
   uint64_t rng = 12345;
+  uint64_t jitterSeed = 12345; // CounterRng seed, from randomize()
 
   Grid grid;
   uint64_t generation = 0;
   int rows = 12;
   int cols = 16;
+
+  // Row-major, stride == cols (declared after rows/cols: sized from them)
+  // (a visit deposits 1: the clamp makes that "set to 1, then decay")
+  DecayField trail;
+
+  // Particles (structure of arrays): current state, and the bucket-sorted
+  // copy of the previous state the update reads
+  int numParticles = 0;
+  std::vector<float> px, py, pvx, pvy;
+  std::vector<float> sx, sy, svx, svy;
+
+  // Cell list: bucket b holds sorted particles [bucketStart[b],
+  // bucketStart[b + 1])
+  int bucketCols = 1;
+  int bucketRows = 1;
+  std::vector<int> bucketStart;
+  std::vector<int> bucketOf;
 };
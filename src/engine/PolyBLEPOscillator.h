@@ -100,6 +100,82 @@ public:
     return out;
   }
 
+  /// Render n samples (same values as n nextSample() calls) with the
+  /// waveshape switch hoisted out of the sample loop.
+  void renderBlock(float *out, int n) {
+    switch (shape) {
+    case Shape::Sine:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(std::sin(kTwoPi * phase));
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+
+    case Shape::Triangle:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(generateTriangle());
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+
+    case Shape::Saw:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(generateSaw(phase, phaseIncrement));
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+
+    case Shape::Pulse:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(generatePulse());
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+
+    case Shape::SineOct:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(
+            (std::sin(kTwoPi * phase) + 0.5 * std::sin(kTwoPi * 2.0 * phase)) *
+            0.667);
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+
+    case Shape::FifthStack:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(
+            (std::sin(kTwoPi * phase) + 0.5 * std::sin(kTwoPi * 1.5 * phase)) *
+            0.667);
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+
+    case Shape::Pad:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(generatePad());
+        advancePhase(phase, phaseIncrement);
+        advancePhase(padPhaseA, padIncrementA);
+        advancePhase(padPhaseB, padIncrementB);
+      }
+      break;
+
+    case Shape::Bell:
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<float>(generateBell());
+        advancePhase(phase, phaseIncrement);
+        advancePhase(bellModPhase, bellModIncrement);
+      }
+      break;
+
+    default:
+      for (int i = 0; i < n; ++i) {
+        out[i] = 0.0f;
+        advancePhase(phase, phaseIncrement);
+      }
+      break;
+    }
+  }
+
 private:
   static constexpr double kTwoPi = 6.283185307179586;
 
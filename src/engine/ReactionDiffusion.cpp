@@ -9,71 +9,175 @@ uint64_t xorshift64(uint64_t &state) {
   state ^= state << 17;
   return state;
 }
+
+// Gray-Scott update of one cell from its 5-point neighbourhood
+inline void grayScottCell(float aUp, float aDn, float aLt, float aRt, float a,
+                          float bUp, float bDn, float bLt, float bRt, float b,
+                          float &outA, float &outB, float da, float db,
+                          float feed, float kill, float dt) {
+  const float lapA = aUp + aDn + aLt + aRt - 4.0f * a;
+  const float lapB = bUp + bDn + bLt + bRt - 4.0f * b;
+  const float ab2 = a * b * b;
+  const float nextA = a + dt * (da * lapA - ab2 + feed * (1.0f - a));
+  const float nextB = b + dt * (db * lapB + ab2 - (feed + kill) * b);
+  outA = std::min(1.0f, std::max(0.0f, nextA));
+  outB = std::min(1.0f, std::max(0.0f, nextB));
+}
+
+// Columns [1, cols - 1) of one row: neighbours are contiguous, no wrap.
+// Each group of kLanes cells is loaded and computed before any of it is
+// stored, so the compiler can keep a group in SIMD registers without
+// proving that the output rows do not alias the inputs.
+void grayScottInterior(const float *aUp, const float *a, const float *aDn,
+                       const float *bUp, const float *b, const float *bDn,
+                       float *outA, float *outB, int cols, float da, float db,
+                       float feed, float kill, float dt) {
+  constexpr int kLanes = 8;
+  int c = 1;
+  for (; c + kLanes <= cols - 1; c += kLanes) {
+    float nextA[kLanes], nextB[kLanes];
+    for (int j = 0; j < kLanes; ++j)
+      grayScottCell(aUp[c + j], aDn[c + j], a[c + j - 1], a[c + j + 1],
+                    a[c + j], bUp[c + j], bDn[c + j], b[c + j - 1],
+                    b[c + j + 1], b[c + j], nextA[j], nextB[j], da, db, feed,
+                    kill, dt);
+    for (int j = 0; j < kLanes; ++j) {
+      outA[c + j] = nextA[j];
+      outB[c + j] = nextB[j];
+    }
+  }
+  for (; c < cols - 1; ++c)
+    grayScottCell(aUp[c], aDn[c], a[c - 1], a[c + 1], a[c], bUp[c], bDn[c],
+                  b[c - 1], b[c + 1], b[c], outA[c], outB[c], da, db, feed,
+                  kill, dt);
+}
 } // namespace
 
 ReactionDiffusion::ReactionDiffusion(int r, int c)
-    : fieldA(Grid::kMaxCells, 1.0f), fieldB(Grid::kMaxCells, 0.0f),
-      scratchA(Grid::kMaxCells, 0.0f), scratchB(Grid::kMaxCells, 0.0f),
-      grid(r, c), rows(r), cols(c) {}
+    : grid(r, c), rows(grid.getRows()), cols(grid.getCols()),
+      fieldA(static_cast<size_t>(rows) * cols, 1.0f),
+      fieldB(static_cast<size_t>(rows) * cols, 0.0f),
+      scratchA(static_cast<size_t>(rows) * cols, 0.0f),
+      scratchB(static_cast<size_t>(rows) * cols, 0.0f) {
+  reserveRings();
+}
+
+void ReactionDiffusion::reserveRings() {
+  rings.resize(static_cast<size_t>(getMaxRowBands()) * (kMaxStepsPerPass - 1) *
+               6 * cols);
+}
+
+bool ReactionDiffusion::setGenerationsPerStep(int generations) {
+  generationsPerStep.store(std::max(1, generations),
+                           std::memory_order_relaxed);
+  return true;
+}
+
+void ReactionDiffusion::setStepsPerPass(int steps) {
+  stepsPerPass = std::clamp(steps, 1, kMaxStepsPerPass);
+}
 
 void ReactionDiffusion::step() {
-  // 5-point Laplacian stencil with toroidal wrapping
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      int idx = r * Grid::kMaxCols + c;
-
-      // Toroidal neighbors
-      int up = ((r - 1 + rows) % rows) * Grid::kMaxCols + c;
-      int dn = ((r + 1) % rows) * Grid::kMaxCols + c;
-      int lt = r * Grid::kMaxCols + ((c - 1 + cols) % cols);
-      int rt = r * Grid::kMaxCols + ((c + 1) % cols);
-
-      // Laplacian
-      float lapA = fieldA[up] + fieldA[dn] + fieldA[lt] + fieldA[rt] -
-                   4.0f * fieldA[idx];
-      float lapB = fieldB[up] + fieldB[dn] + fieldB[lt] + fieldB[rt] -
-                   4.0f * fieldB[idx];
-
-      float a = fieldA[idx];
-      float b = fieldB[idx];
-      float ab2 = a * b * b;
-
-      // Gray-Scott equations
-      scratchA[idx] = a + kDt * (kDa * lapA - ab2 + kFeed * (1.0f - a));
-      scratchB[idx] = b + kDt * (kDb * lapB + ab2 - (kFeed + kKill) * b);
-
-      // Clamp to [0, 1]
-      if (scratchA[idx] < 0.0f)
-        scratchA[idx] = 0.0f;
-      if (scratchA[idx] > 1.0f)
-        scratchA[idx] = 1.0f;
-      if (scratchB[idx] < 0.0f)
-        scratchB[idx] = 0.0f;
-      if (scratchB[idx] > 1.0f)
-        scratchB[idx] = 1.0f;
-    }
+  const int generations = getGenerationsPerStep();
+  events.reset(rows, cols);
+  for (int done = 0; done < generations;) {
+    const int steps = std::min(stepsPerPass, generations - done);
+    done += steps;
+    runPass(steps, done == generations);
+    // Swap front/back fields (every back cell was written by the pass)
+    fieldA.swap(scratchA);
+    fieldB.swap(scratchB);
   }
+  generation += static_cast<uint64_t>(generations);
+}
 
-  // Swap
-  std::copy(scratchA.begin(), scratchA.end(), fieldA.begin());
-  std::copy(scratchB.begin(), scratchB.end(), fieldB.begin());
-
-  projectToGrid();
-  ++generation;
+void ReactionDiffusion::runPass(int steps, bool project) {
+  // Level 0 is the front field, level `steps` the back field; levels in
+  // between keep their last three rows in a ring. A band advancing `steps`
+  // levels reads (steps - k) halo rows beyond its edges at level k, and
+  // recomputes them instead of exchanging them with neighbouring bands.
+  const size_t rowFloats = static_cast<size_t>(cols);
+  const size_t bandFloats = (kMaxStepsPerPass - 1) * 6 * rowFloats;
+  forEachIndexedRowBand(rows, cols, [&](int band, int rowBegin, int rowEnd) {
+    float *bandRings = rings.data() + band * bandFloats;
+    CellEventList::Writer out(events);
+
+    // Row x (may lie outside [0, rows): halo) at level k of A or B
+    auto levelRow = [&](int k, int x, int field) -> float * {
+      if (k == 0) {
+        const int r = ((x % rows) + rows) % rows;
+        return (field == 0 ? fieldA.data() : fieldB.data()) + r * rowFloats;
+      }
+      if (k == steps)
+        return (field == 0 ? scratchA.data() : scratchB.data()) +
+               x * rowFloats;
+      const int slot = ((x % 3) + 3) % 3;
+      return bandRings +
+             ((static_cast<size_t>(k - 1) * 3 + slot) * 2 + field) * rowFloats;
+    };
+
+    // Wavefront: iteration i finishes level k row i - (k - 1), whose three
+    // level k-1 source rows were finished in iterations i - 2 .. i
+    for (int i = rowBegin - steps + 1; i <= rowEnd + steps - 2; ++i) {
+      for (int k = 1; k <= steps; ++k) {
+        const int x = i - (k - 1);
+        const int halo = steps - k;
+        if (x < rowBegin - halo || x >= rowEnd + halo)
+          continue;
+
+        const float *aUp = levelRow(k - 1, x - 1, 0);
+        const float *a = levelRow(k - 1, x, 0);
+        const float *aDn = levelRow(k - 1, x + 1, 0);
+        const float *bUp = levelRow(k - 1, x - 1, 1);
+        const float *b = levelRow(k - 1, x, 1);
+        const float *bDn = levelRow(k - 1, x + 1, 1);
+        float *outA = levelRow(k, x, 0);
+        float *outB = levelRow(k, x, 1);
+
+        // Column wrap only at the two edge cells; the interior reads
+        // contiguous neighbours (vectorizes)
+        const int last = cols - 1;
+        grayScottCell(aUp[0], aDn[0], a[last], a[cols > 1 ? 1 : 0], a[0],
+                      bUp[0], bDn[0], b[last], b[cols > 1 ? 1 : 0], b[0],
+                      outA[0], outB[0], kDa, kDb, kFeed, kKill, kDt);
+        grayScottInterior(aUp, a, aDn, bUp, b, bDn, outA, outB, cols, kDa,
+                          kDb, kFeed, kKill, kDt);
+        if (last > 0)
+          grayScottCell(aUp[last], aDn[last], a[last - 1], a[0], a[last],
+                        bUp[last], bDn[last], b[last - 1], b[0], b[last],
+                        outA[last], outB[last], kDa, kDb, kFeed, kKill, kDt);
+
+        if (k == steps && project)
+          projectRow(x, outB, out);
+      }
+    }
+  });
 }
 
 void ReactionDiffusion::projectToGrid() {
-  for (int r = 0; r < rows; ++r) {
-    for (int c = 0; c < cols; ++c) {
-      int idx = r * Grid::kMaxCols + c;
-      float b = fieldB[idx];
-      if (b > kThreshold) {
-        grid.setCell(r, c, 1);
-        grid.setAge(r, c, static_cast<uint16_t>(b * 255.0f));
-      } else {
-        grid.setCell(r, c, 0);
-        grid.setAge(r, c, 0);
-      }
+  events.reset(rows, cols);
+  forEachRowBand(rows, cols, [&](int rowBegin, int rowEnd) {
+    CellEventList::Writer out(events);
+    for (int r = rowBegin; r < rowEnd; ++r)
+      projectRow(r, &fieldB[static_cast<size_t>(r) * cols], out);
+  });
+}
+
+void ReactionDiffusion::projectRow(int r, const float *b,
+                                   CellEventList::Writer &out) {
+  uint8_t *cells = grid.cellRow(r);
+  uint16_t *ages = grid.ageRow(r);
+  for (int c = 0; c < cols; ++c) {
+    if (b[c] > kThreshold) {
+      if (cells[c] == 0)
+        out.add(r, c, CellEvent::Birth, b[c]);
+      cells[c] = 1;
+      ages[c] = static_cast<uint16_t>(b[c] * 255.0f);
+    } else {
+      if (cells[c] != 0)
+        out.add(r, c, CellEvent::Death, b[c]);
+      cells[c] = 0;
+      ages[c] = 0;
     }
   }
 }
@@ -90,7 +194,7 @@ void ReactionDiffusion::randomize(uint64_t seed, float density) {
     for (int c = 0; c < cols; ++c) {
       float val = static_cast<float>(xorshift64(state) >> 32) / 4294967296.0f;
       if (val < density) {
-        int idx = r * Grid::kMaxCols + c;
+        int idx = r * cols + c;
         fieldB[idx] = 1.0f;
         fieldA[idx] = 0.0f;
       }
@@ -117,7 +221,7 @@ void ReactionDiffusion::randomizeSymmetric(uint64_t seed, float density) {
         int mr = rows - 1 - r;
         int mc = cols - 1 - c;
         auto seed_cell = [&](int rr, int cc) {
-          int idx = rr * Grid::kMaxCols + cc;
+          int idx = rr * cols + cc;
           fieldB[idx] = 1.0f;
           fieldA[idx] = 0.0f;
         };
@@ -2,6 +2,7 @@
 
 #include "CellularEngine.h"
 #include "Grid.h"
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -9,6 +10,15 @@
 /// Internal: two float concentration fields (A, B).
 /// Grid projection: B > threshold -> alive; age = B * 255.
 /// Produces organic spot and stripe patterns.
+///
+/// One step() advances getGenerationsPerStep() generations (Sim Speed) in
+/// passes of up to kMaxStepsPerPass. A pass walks each row band once: the
+/// intermediate generations live in three-row rings per level, so the
+/// fields go through memory once per pass instead of once per generation,
+/// and the grid projection runs on the rows of the last pass as they are
+/// finished. Every cell is computed with the same arithmetic whatever the
+/// pass length or band layout, so results are bit-identical to single
+/// steps.
 class ReactionDiffusion final : public CellularEngine {
 public:
   explicit ReactionDiffusion(int rows = 12, int cols = 16);
@@ -25,22 +35,46 @@ public:
   const char *getName() const override { return "Reaction-Diffusion"; }
   int getDefaultTriggerBudget() const override { return 4; }
   float getGainScale() const override { return 0.4f; }
+  bool setGenerationsPerStep(int generations) override;
+  int getGenerationsPerStep() const override {
+    return generationsPerStep.load(std::memory_order_relaxed);
+  }
+
+  /// Generations per pass over the fields (temporal blocking). 1 writes
+  /// every generation back to the fields (benchmarks, parity tests).
+  static constexpr int kMaxStepsPerPass = 4;
+  void setStepsPerPass(int steps);
 
   // --- Engine-specific intensity ---
   float getCellIntensity(int row, int col) const override {
-    float b = fieldB[row * Grid::kMaxCols + col];
+    float b = fieldB[row * cols + col];
     return (b > 1.0f) ? 1.0f : ((b < 0.0f) ? 0.0f : b);
   }
   bool cellActivated(int row, int col) const override {
     return getGrid().wasBorn(row, col);
   }
 
-  // --- Native data access for visualizer ---
+  // --- Native data access for visualizer (rows x cols, stride == cols) ---
   const float *getFieldA() const { return fieldA.data(); }
   const float *getFieldB() const { return fieldB.data(); }
 
+  // --- Saved state: fields A and B ---
+  int getNumFields() const override { return 2; }
+  const float *getField(int index) const override {
+    return index == 0 ? fieldA.data() : index == 1 ? fieldB.data() : nullptr;
+  }
+  float *getFieldMutable(int index) override {
+    return index == 0 ? fieldA.data() : index == 1 ? fieldB.data() : nullptr;
+  }
+
+protected:
+  void workerPoolChanged() override { reserveRings(); }
+
 private:
+  void reserveRings(); // one ring set per row band (getMaxRowBands())
+  void runPass(int steps, bool project);
   void projectToGrid(); // Quantize floats to uint8 grid
+  void projectRow(int r, const float *b, CellEventList::Writer &out);
 
   // Gray-Scott parameters (tuned for spots)
   static constexpr float kDa = 1.0f;     // Diffusion rate A
@@ -50,15 +84,20 @@ private:
   static constexpr float kDt = 1.0f;     // Time step
   static constexpr float kThreshold = 0.25f;
 
-  static constexpr int kMax = Grid::kMaxRows * Grid::kMaxCols;
+  Grid grid;
+  uint64_t generation = 0;
+  std::atomic<int> generationsPerStep{1}; // set from any thread
+  int stepsPerPass = kMaxStepsPerPass;
+  int rows = 12;
+  int cols = 16;
 
+  // Row-major, stride == cols (declared after rows/cols: sized from them)
   std::vector<float> fieldA;
   std::vector<float> fieldB;
   std::vector<float> scratchA;
   std::vector<float> scratchB;
 
-  Grid grid;
-  uint64_t generation = 0;
-  int rows = 12;
-  int cols = 16;
+  // Intermediate-level row rings of runPass(), per band:
+  // [band][level 1..kMaxStepsPerPass-1][slot 0..2][A, B][cols]
+  std::vector<float> rings;
 };
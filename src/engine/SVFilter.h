@@ -48,6 +48,42 @@ public:
     }
   }
 
+  /// Coefficients for running several filters side by side (SynthVoice
+  /// lanes). Every mode is mixInput * input + mixV1 * v1 + mixV2 * v2, so
+  /// filters in different modes share one branch-free loop.
+  struct LaneCoefficients {
+    float a1, a2, a3;
+    float mixInput, mixV1, mixV2;
+  };
+
+  LaneCoefficients getLaneCoefficients() const {
+    const float fa1 = static_cast<float>(a1);
+    const float fa2 = static_cast<float>(a2);
+    const float fa3 = static_cast<float>(a3);
+    const float fk = static_cast<float>(k);
+    switch (mode) {
+    case Mode::HighPass:
+      return {fa1, fa2, fa3, 1.0f, -fk, -1.0f};
+    case Mode::BandPass:
+      return {fa1, fa2, fa3, 0.0f, 1.0f, 0.0f};
+    case Mode::Notch:
+      return {fa1, fa2, fa3, 1.0f, -fk, 0.0f};
+    case Mode::LowPass:
+    default:
+      return {fa1, fa2, fa3, 0.0f, 0.0f, 1.0f};
+    }
+  }
+
+  /// Integrator state, for filters advanced outside process().
+  void getState(double &s1, double &s2) const {
+    s1 = ic1eq;
+    s2 = ic2eq;
+  }
+  void setState(double s1, double s2) {
+    ic1eq = s1;
+    ic2eq = s2;
+  }
+
   /// Reset internal state (call on note-on).
   void reset() {
     ic1eq = 0.0;
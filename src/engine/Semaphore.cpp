@@ -0,0 +1,72 @@
+#include "Semaphore.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#else
+#include <cerrno>
+#include <semaphore.h>
+#endif
+
+#if defined(_WIN32)
+
+Semaphore::Semaphore()
+    : handle(CreateSemaphoreW(nullptr, 0, 0x7fffffff, nullptr)) {}
+
+Semaphore::~Semaphore() { CloseHandle(static_cast<HANDLE>(handle)); }
+
+void Semaphore::osSignal() {
+  ReleaseSemaphore(static_cast<HANDLE>(handle), 1, nullptr);
+}
+
+void Semaphore::osWait() {
+  WaitForSingleObject(static_cast<HANDLE>(handle), INFINITE);
+}
+
+#elif defined(__APPLE__)
+
+Semaphore::Semaphore() : handle(dispatch_semaphore_create(0)) {}
+
+Semaphore::~Semaphore() {
+  dispatch_release(static_cast<dispatch_semaphore_t>(handle));
+}
+
+void Semaphore::osSignal() {
+  dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(handle));
+}
+
+void Semaphore::osWait() {
+  dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(handle),
+                          DISPATCH_TIME_FOREVER);
+}
+
+#else
+
+Semaphore::Semaphore() {
+  auto *sem = new sem_t;
+  sem_init(sem, 0, 0);
+  handle = sem;
+}
+
+Semaphore::~Semaphore() {
+  auto *sem = static_cast<sem_t *>(handle);
+  sem_destroy(sem);
+  delete sem;
+}
+
+void Semaphore::osSignal() { sem_post(static_cast<sem_t *>(handle)); }
+
+void Semaphore::osWait() {
+  // Retry if a signal handler interrupts the wait
+  while (sem_wait(static_cast<sem_t *>(handle)) != 0 && errno == EINTR) {
+  }
+}
+
+#endif
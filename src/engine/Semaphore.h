@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+
+/// Counting semaphore with an atomic fast path, for waking a worker thread
+/// from the audio thread.
+///
+/// signal() is a single atomic add; it only calls into the OS when a thread
+/// is actually blocked in wait(). The OS primitive (Win32 semaphore, GCD
+/// dispatch semaphore, POSIX sem_t) is created once in the constructor.
+class Semaphore {
+public:
+  Semaphore();
+  ~Semaphore();
+
+  Semaphore(const Semaphore &) = delete;
+  Semaphore &operator=(const Semaphore &) = delete;
+
+  /// Release one waiter (or bank a wake-up if nobody is waiting).
+  void signal() {
+    if (count.fetch_add(1, std::memory_order_release) < 0)
+      osSignal();
+  }
+
+  /// Block until signalled.
+  void wait() {
+    if (count.fetch_sub(1, std::memory_order_acquire) < 1)
+      osWait();
+  }
+
+private:
+  void osSignal();
+  void osWait();
+
+  // > 0: banked wake-ups, < 0: number of blocked waiters
+  std::atomic<int> count{0};
+  void *handle = nullptr;
+};
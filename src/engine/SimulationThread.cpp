@@ -0,0 +1,280 @@
+#include "SimulationThread.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+void SimulationThread::start() {
+  if (thread_.joinable() || !engine_ || !bridge_)
+    return;
+  quit_.store(false, std::memory_order_relaxed);
+  thread_ = std::thread([this] { run(); });
+}
+
+void SimulationThread::stop() {
+  if (!thread_.joinable())
+    return;
+  quit_.store(true, std::memory_order_release);
+  wake_.signal();
+  thread_.join();
+}
+
+void SimulationThread::requestStep() {
+  // Timestamp only the first request of a batch (CAS fails while one is
+  // pending), then publish the count.
+  uint64_t expected = 0;
+  firstRequestNs_.compare_exchange_strong(expected, nowNs(),
+                                          std::memory_order_relaxed);
+  stepsRequested_.fetch_add(1, std::memory_order_release);
+  wake_.signal();
+}
+
+void SimulationThread::runPending() {
+  if (isRunning() || !engine_ || !bridge_)
+    return;
+  // A clear / reseed consumes one pass; steps requested with it run next
+  while (hasPendingRequests())
+    processRequests(std::numeric_limits<int>::max());
+}
+
+bool SimulationThread::hasPendingRequests() const {
+  return stepsRequested_.load(std::memory_order_acquire) > 0 ||
+         clearRequested_.load(std::memory_order_acquire) ||
+         reseedRequested_.load(std::memory_order_acquire) ||
+         overpopRequested_.load(std::memory_order_acquire);
+}
+
+SimulationThread::LatencyStats SimulationThread::getLatencyStats() const {
+  LatencyStats s;
+  s.publishes = statPublishes_.load(std::memory_order_relaxed);
+  s.stepsRun = statStepsRun_.load(std::memory_order_relaxed);
+  s.stepsDropped = statStepsDropped_.load(std::memory_order_relaxed);
+  s.lastUs = statLastNs_.load(std::memory_order_relaxed) * 1.0e-3;
+  s.maxUs = statMaxNs_.load(std::memory_order_relaxed) * 1.0e-3;
+  if (s.publishes > 0)
+    s.meanUs = statSumNs_.load(std::memory_order_relaxed) * 1.0e-3 /
+               static_cast<double>(s.publishes);
+  return s;
+}
+
+void SimulationThread::run() {
+  realtime_.store(setRealtimePriority(), std::memory_order_relaxed);
+
+  for (;;) {
+    wake_.wait();
+    if (quit_.load(std::memory_order_acquire))
+      return;
+    processRequests(kMaxStepsPerWake);
+  }
+}
+
+void SimulationThread::processRequests(int maxSteps) {
+  if (resetStats_.exchange(false, std::memory_order_relaxed)) {
+    statPublishes_.store(0, std::memory_order_relaxed);
+    statStepsRun_.store(0, std::memory_order_relaxed);
+    statStepsDropped_.store(0, std::memory_order_relaxed);
+    statLastNs_.store(0, std::memory_order_relaxed);
+    statSumNs_.store(0, std::memory_order_relaxed);
+    statMaxNs_.store(0, std::memory_order_relaxed);
+  }
+
+  // Clear / reseed requests replace the grid and consume this wake-up
+  bool replaced = true;
+  if (clearRequested_.exchange(false, std::memory_order_acquire)) {
+    engine_->clear();
+  } else if (reseedRequested_.exchange(false, std::memory_order_acquire)) {
+    if (reseedSymmetric_)
+      engine_->randomizeSymmetric(reseedSeed_, reseedDensity_);
+    else
+      engine_->randomize(reseedSeed_, reseedDensity_);
+  } else if (overpopRequested_.exchange(false, std::memory_order_acquire)) {
+    if (overpopSymmetric_)
+      engine_->randomizeSymmetric(overpopSeed_, overpopDensity_);
+    else
+      engine_->randomize(overpopSeed_, overpopDensity_);
+  } else {
+    replaced = false;
+  }
+  if (replaced) {
+    publish(nullptr);
+    captureState(0, true);
+    // Steps requested meanwhile run on the next pass, not lost
+    if (stepsRequested_.load(std::memory_order_relaxed) > 0)
+      wake_.signal();
+    return;
+  }
+
+  // Drain cell edits from UI (edited cells are not in the step's events).
+  // Only touch getGridMutable() when there is something to drain: engines
+  // treat it as an edit and resync their own state on the next step.
+  bool edited = false;
+  if (editQueue_ && !editQueue_->empty() &&
+      editQueue_->drainInto(engine_->getGridMutable()) > 0)
+    edited = editsPending_ = true;
+
+  // Run the pending steps (up to maxSteps), then publish once
+  int pending = stepsRequested_.exchange(0, std::memory_order_acquire);
+  if (pending <= 0) {
+    if (edited)
+      captureState(0, true);
+    return;
+  }
+  const uint64_t requestNs =
+      firstRequestNs_.exchange(0, std::memory_order_relaxed);
+
+  const int toRun = std::min(pending, maxSteps);
+  if (toRun > 1)
+    beginBatch();
+  for (int i = 0; i < toRun; ++i) {
+    {
+      ALGO_PROFILE_STAGE(stepTimings_, ProfileStage::EngineStep);
+      engine_->step();
+    }
+    if (toRun > 1)
+      mergeStepEvents();
+  }
+  // One step: the engine's own events; several: their net change
+  publish(toRun == 1 ? &engine_->getEvents() : finishBatch());
+  captureState(toRun, edited);
+
+  statStepsRun_.fetch_add(static_cast<uint64_t>(toRun),
+                          std::memory_order_relaxed);
+  if (pending > toRun)
+    statStepsDropped_.fetch_add(static_cast<uint64_t>(pending - toRun),
+                                std::memory_order_relaxed);
+  if (requestNs != 0)
+    recordLatency(requestNs);
+}
+
+void SimulationThread::beginBatch() {
+  const Grid &grid = engine_->getGrid();
+  const size_t cells = static_cast<size_t>(grid.getRows()) * grid.getCols();
+  if (batchSlot_.size() != cells)
+    batchSlot_.assign(cells, -1); // only when the grid size changes
+  batchNet_.reserve(CellEventList::kMaxEvents);
+  batchLive_.reserve(CellEventList::kMaxEvents);
+  batchNet_.clear();
+  batchLive_.clear();
+  batchComplete_ = true;
+}
+
+void SimulationThread::mergeStepEvents() {
+  const CellEventList &events = engine_->getEvents();
+  if (!batchComplete_)
+    return;
+  if (!events.complete()) {
+    batchComplete_ = false;
+    return;
+  }
+  // A cell's events alternate birth / death, so each one after the first
+  // flips whether the batch changes the cell at all
+  const int cols = engine_->getGrid().getCols();
+  for (const CellEvent &e : events) {
+    int &slot = batchSlot_[static_cast<size_t>(e.row) * cols + e.col];
+    if (slot >= 0) {
+      batchNet_[static_cast<size_t>(slot)] = e;
+      batchLive_[static_cast<size_t>(slot)] ^= 1;
+      continue;
+    }
+    if (batchNet_.size() == static_cast<size_t>(CellEventList::kMaxEvents)) {
+      batchComplete_ = false;
+      return;
+    }
+    slot = static_cast<int>(batchNet_.size());
+    batchNet_.push_back(e);
+    batchLive_.push_back(1);
+  }
+}
+
+const CellEventList *SimulationThread::finishBatch() {
+  const Grid &grid = engine_->getGrid();
+  const int cols = grid.getCols();
+  batchEvents_.reset(grid.getRows(), cols);
+  {
+    CellEventList::Writer out(batchEvents_);
+    for (size_t i = 0; i < batchNet_.size(); ++i) {
+      const CellEvent &e = batchNet_[i];
+      batchSlot_[static_cast<size_t>(e.row) * cols + e.col] = -1;
+      if (batchLive_[i])
+        out.add(e.row, e.col, e.type, e.intensity);
+    }
+  }
+  return batchComplete_ ? &batchEvents_ : nullptr;
+}
+
+void SimulationThread::publish(const CellEventList *events) {
+  // Events only describe the change from the frame we published last; if
+  // anyone else published since (engine swap, GPU) or cells were edited,
+  // the bridge converts the whole grid instead.
+  const bool chained =
+      !editsPending_ && bridge_->getGeneration() == lastPublished_;
+  // Tile occupancy lets a full conversion skip the engine's empty tiles
+  bridge_->updateFromCpu(engine_->getGrid(), chained ? events : nullptr,
+                         engine_->getLiveTiles());
+  lastPublished_ = bridge_->getGeneration();
+  editsPending_ = false;
+}
+
+void SimulationThread::captureState(int stepsRun, bool changed) {
+  if (!snapshotter_)
+    return;
+  stepsSinceCapture_ += stepsRun;
+  captureDue_ = captureDue_ || changed;
+  if (!captureDue_ && stepsSinceCapture_ < snapshotter_->getInterval())
+    return;
+  // While the previous capture is still encoding, retry after the next step
+  if (snapshotter_->capture(*engine_)) {
+    stepsSinceCapture_ = 0;
+    captureDue_ = false;
+  }
+}
+
+void SimulationThread::recordLatency(uint64_t requestNs) {
+  const uint64_t now = nowNs();
+  const uint64_t latency = now > requestNs ? now - requestNs : 0;
+  statLastNs_.store(latency, std::memory_order_relaxed);
+  statSumNs_.fetch_add(latency, std::memory_order_relaxed);
+  if (latency > statMaxNs_.load(std::memory_order_relaxed))
+    statMaxNs_.store(latency, std::memory_order_relaxed);
+  statPublishes_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t SimulationThread::nowNs() {
+  // +1 so a valid timestamp is never 0 (0 marks "none pending")
+  return static_cast<uint64_t>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count()) +
+         1;
+}
+
+bool SimulationThread::setRealtimePriority() {
+#if defined(_WIN32)
+  // Below the MMCSS "Pro Audio" audio thread, above normal UI work
+  return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST) != 0;
+#elif defined(__APPLE__)
+  return pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0) == 0;
+#else
+  // SCHED_FIFO at a low real-time priority so audio threads (typically
+  // 70-95) still pre-empt us. Fails without CAP_SYS_NICE / rtprio limits;
+  // the thread then keeps the default policy.
+  sched_param param{};
+  param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 9;
+  return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#endif
+}
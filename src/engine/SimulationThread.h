@@ -0,0 +1,187 @@
+#pragma once
+// SimulationThread -- Dedicated thread that steps the CPU cellular engine.
+// The audio thread requests work through atomic flags and a semaphore
+// signal (no locks, no allocation); the thread wakes immediately, runs the
+// pending steps and publishes the grid to GpuGridBridge. Independent of the
+// message loop, so UI repaints or a throttled host cannot stall the music.
+
+#include "CellEditQueue.h"
+#include "CellularEngine.h"
+#include "Semaphore.h"
+#include "StageProfiler.h"
+#include "StateSnapshotter.h"
+#include "../gpu/GpuGridBridge.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class SimulationThread {
+public:
+  /// Request-to-publish latency, measured from the first requestStep() of
+  /// a batch to the bridge update that contains it.
+  struct LatencyStats {
+    uint64_t publishes = 0;    // bridge updates that followed a step request
+    uint64_t stepsRun = 0;     // engine steps executed
+    uint64_t stepsDropped = 0; // requests beyond kMaxStepsPerWake (threaded)
+    double lastUs = 0.0;
+    double meanUs = 0.0;
+    double maxUs = 0.0;
+  };
+
+  /// Backlog bound per wake-up. With immediate wake-ups this is only hit
+  /// if a single step takes longer than several clock ticks.
+  static constexpr int kMaxStepsPerWake = 16;
+
+  SimulationThread() = default;
+  ~SimulationThread() { stop(); }
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  /// Wire up to engine and bridge. Call while stopped.
+  void setTargets(CellularEngine *engine, GpuGridBridge *bridge,
+                  CellEditQueue *editQueue) {
+    engine_ = engine;
+    bridge_ = bridge;
+    editQueue_ = editQueue;
+  }
+
+  /// Capture the engine state into snapshotter every getInterval()
+  /// generations and after every clear / reseed (nullptr = never). Call
+  /// while stopped.
+  void setStateSnapshotter(StateSnapshotter *snapshotter) {
+    snapshotter_ = snapshotter;
+  }
+
+  /// Launch the thread. No-op if already running or targets are missing.
+  void start();
+
+  /// Stop and join the thread. Must be called before the engine is
+  /// replaced or destroyed. Never call from the audio thread.
+  void stop();
+
+  bool isRunning() const { return thread_.joinable(); }
+
+  /// Offline rendering: run every pending request on the calling thread
+  /// (replacements first, then the requested steps), so results depend
+  /// only on the sequence of requests, not on timing. Every requested step
+  /// runs: kMaxStepsPerWake bounds only the threaded backlog. Only while
+  /// stopped.
+  void runPending();
+
+  /// Whether the OS granted elevated (real-time) scheduling.
+  bool hasRealtimePriority() const {
+    return realtime_.load(std::memory_order_relaxed);
+  }
+
+  // --- Requests (audio thread; lock-free, wait-free) ---
+
+  /// Request one step (audio thread sets on clock tick).
+  void requestStep();
+
+  /// Request reseed with given seed and density.
+  void requestReseed(uint64_t seed, float density, bool symmetric) {
+    reseedSeed_ = seed;
+    reseedDensity_ = density;
+    reseedSymmetric_ = symmetric;
+    reseedRequested_.store(true, std::memory_order_release);
+    wake_.signal();
+  }
+
+  /// Request clear.
+  void requestClear() {
+    clearRequested_.store(true, std::memory_order_release);
+    wake_.signal();
+  }
+
+  /// Request overpopulation reseed (sparser).
+  void requestOverpopReseed(uint64_t seed, float density, bool symmetric) {
+    overpopSeed_ = seed;
+    overpopDensity_ = density;
+    overpopSymmetric_ = symmetric;
+    overpopRequested_.store(true, std::memory_order_release);
+    wake_.signal();
+  }
+
+  // --- Latency statistics (any thread) ---
+
+  LatencyStats getLatencyStats() const;
+  void resetLatencyStats() { resetStats_.store(true, std::memory_order_relaxed); }
+
+  /// Duration of every engine step() (ProfileStage::EngineStep). Drained
+  /// by one consumer thread.
+  StageTimingRing &getStepTimings() { return stepTimings_; }
+
+private:
+  void run();
+  /// Run replacements, edits and up to maxSteps of the pending steps (the
+  /// rest are dropped and counted).
+  void processRequests(int maxSteps);
+  bool hasPendingRequests() const;
+  void publish(const CellEventList *events);
+  void beginBatch();
+  void mergeStepEvents();
+  const CellEventList *finishBatch();
+  void captureState(int stepsRun, bool changed);
+  void recordLatency(uint64_t requestNs);
+  static uint64_t nowNs();
+  static bool setRealtimePriority();
+
+  CellularEngine *engine_ = nullptr;
+  GpuGridBridge *bridge_ = nullptr;
+  CellEditQueue *editQueue_ = nullptr;
+  StateSnapshotter *snapshotter_ = nullptr;
+
+  // Publishing (simulation thread only)
+  bool editsPending_ = false;      // cells edited since the last publish
+  uint64_t lastPublished_ = 0;     // bridge generation after our publish
+
+  // Net change over a multi-step batch, merged from each step's events so
+  // the bridge can still patch instead of converting (simulation thread
+  // only). batchSlot_ maps a cell to its entry in batchNet_ (-1 = none);
+  // batchLive_ is cleared when later steps undo the change.
+  CellEventList batchEvents_;
+  std::vector<CellEvent> batchNet_;
+  std::vector<uint8_t> batchLive_;
+  std::vector<int> batchSlot_;
+  bool batchComplete_ = true;
+
+  // State capture (simulation thread only)
+  int stepsSinceCapture_ = 0;
+  bool captureDue_ = false; // grid replaced or edited since the last capture
+
+  std::thread thread_;
+  Semaphore wake_;
+  std::atomic<bool> quit_{false};
+  std::atomic<bool> realtime_{false};
+  StageTimingRing stepTimings_;
+
+  // Step requests (counter to handle multiple clock ticks per wake-up)
+  std::atomic<int> stepsRequested_{0};
+  std::atomic<uint64_t> firstRequestNs_{0}; // 0 = no timestamp pending
+
+  // Reseed
+  std::atomic<bool> reseedRequested_{false};
+  uint64_t reseedSeed_ = 0;
+  float reseedDensity_ = 0.3f;
+  bool reseedSymmetric_ = false;
+
+  // Clear
+  std::atomic<bool> clearRequested_{false};
+
+  // Overpopulation reseed
+  std::atomic<bool> overpopRequested_{false};
+  uint64_t overpopSeed_ = 0;
+  float overpopDensity_ = 0.15f;
+  bool overpopSymmetric_ = false;
+
+  // Stats (written by the simulation thread only)
+  std::atomic<bool> resetStats_{false};
+  std::atomic<uint64_t> statPublishes_{0};
+  std::atomic<uint64_t> statStepsRun_{0};
+  std::atomic<uint64_t> statStepsDropped_{0};
+  std::atomic<uint64_t> statLastNs_{0};
+  std::atomic<uint64_t> statSumNs_{0};
+  std::atomic<uint64_t> statMaxNs_{0};
+};
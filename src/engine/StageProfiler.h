@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// Per-stage hot-path timing: scoped timers on the audio and simulation
+/// threads push (stage, duration) samples into a lock-free SPSC ring, and
+/// the UI drains the rings into StageStatistics for p50 / p99 / max.
+///
+/// Build with ALGO_PROFILING=0 (CMake option ALGO_NEBULA_PROFILING=OFF) to
+/// strip the timers: ALGO_PROFILE_STAGE expands to nothing and no clock is
+/// read. The ring and statistics types stay available (and stay empty).
+#ifndef ALGO_PROFILING
+#define ALGO_PROFILING 1
+#endif
+
+/// Timed stages. The first seven run inside processBlock(), EngineStep on
+/// the simulation thread (one sample per engine step() call).
+enum class ProfileStage : uint8_t {
+  ParamRead,       // parameter snapshot, clock, engine / transport requests
+  TriggerScan,     // grid scan, note mapping, voice triggers
+  VoiceRender,     // SynthVoice::renderBlock and mix-down
+  Effects,         // effect parameters, soft clip, EffectChain
+  SafetyLimiter,   // juce::dsp::Limiter
+  SafetyProcessor, // DC filter, ultrasonic LP, brickwall
+  SnapshotConvert, // bridge -> UI grid snapshot
+  EngineStep,      // CellularEngine::step()
+  Count
+};
+
+constexpr int kNumProfileStages = static_cast<int>(ProfileStage::Count);
+
+inline const char *getProfileStageName(ProfileStage stage) {
+  static constexpr const char *names[kNumProfileStages] = {
+      "Params",  "Triggers",        "Voices",   "Effects",
+      "Limiter", "SafetyProcessor", "Snapshot", "Engine step"};
+  const int i = static_cast<int>(stage);
+  return i >= 0 && i < kNumProfileStages ? names[i] : "?";
+}
+
+/// Lock-free SPSC ring of timing samples. One producer thread (the audio
+/// thread or the simulation thread) pushes, one consumer (the UI) drains.
+/// Fixed capacity, no allocation; samples pushed while full are dropped
+/// and counted.
+class StageTimingRing {
+public:
+  struct Sample {
+    ProfileStage stage;
+    uint32_t ns; // saturates at ~4.3 s
+  };
+
+  static constexpr int kCapacity = 4096; // power of two
+
+  /// Producer side. Returns false (and counts a drop) when full.
+  bool push(ProfileStage stage, uint64_t ns) {
+    const uint32_t w = writePos.load(std::memory_order_relaxed);
+    if (w - readPos.load(std::memory_order_acquire) >= kCapacity) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer[w & (kCapacity - 1)] = {
+        stage, static_cast<uint32_t>(std::min<uint64_t>(ns, UINT32_MAX))};
+    writePos.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer side: pass every pending sample to fn(Sample) in push order.
+  /// Returns the number drained.
+  template <typename Fn> int drain(Fn &&fn) {
+    const uint32_t r = readPos.load(std::memory_order_relaxed);
+    const uint32_t w = writePos.load(std::memory_order_acquire);
+    for (uint32_t i = r; i != w; ++i)
+      fn(buffer[i & (kCapacity - 1)]);
+    readPos.store(w, std::memory_order_release);
+    return static_cast<int>(w - r);
+  }
+
+  /// Samples lost because the consumer fell behind.
+  uint64_t getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  Sample buffer[kCapacity] = {};
+  alignas(64) std::atomic<uint32_t> readPos{0};
+  alignas(64) std::atomic<uint32_t> writePos{0};
+  std::atomic<uint64_t> dropped{0};
+};
+
+/// Times its scope and pushes the result into a ring. Use through
+/// ALGO_PROFILE_STAGE so that ALGO_PROFILING=0 removes it.
+class ScopedStageTimer {
+public:
+  ScopedStageTimer(StageTimingRing &ring, ProfileStage stage)
+      : ring(ring), stage(stage), start(std::chrono::steady_clock::now()) {}
+  ~ScopedStageTimer() {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    ring.push(stage, static_cast<uint64_t>(ns));
+  }
+
+  ScopedStageTimer(const ScopedStageTimer &) = delete;
+  ScopedStageTimer &operator=(const ScopedStageTimer &) = delete;
+
+private:
+  StageTimingRing &ring;
+  ProfileStage stage;
+  std::chrono::steady_clock::time_point start;
+};
+
+/// Times consecutive stages of one long function (processBlock): each lap()
+/// records the time since the previous lap() or start(). Use through
+/// ALGO_PROFILE_START / ALGO_PROFILE_LAP.
+class StageStopwatch {
+public:
+  void start() { last = std::chrono::steady_clock::now(); }
+
+  void lap(StageTimingRing &ring, ProfileStage stage) {
+    const auto now = std::chrono::steady_clock::now();
+    ring.push(stage, static_cast<uint64_t>(
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             now - last)
+                             .count()));
+    last = now;
+  }
+
+private:
+  std::chrono::steady_clock::time_point last{};
+};
+
+#define ALGO_PROFILE_CONCAT_(a, b) a##b
+#define ALGO_PROFILE_CONCAT(a, b) ALGO_PROFILE_CONCAT_(a, b)
+#if ALGO_PROFILING
+/// Time the rest of the enclosing scope as `stage` into `ring`.
+#define ALGO_PROFILE_STAGE(ring, stage)                                        \
+  ScopedStageTimer ALGO_PROFILE_CONCAT(stageTimer_, __LINE__)((ring), (stage))
+#define ALGO_PROFILE_START(watch) (watch).start()
+#define ALGO_PROFILE_LAP(watch, ring, stage) (watch).lap((ring), (stage))
+#else
+#define ALGO_PROFILE_STAGE(ring, stage) ((void)0)
+#define ALGO_PROFILE_START(watch) ((void)0)
+#define ALGO_PROFILE_LAP(watch, ring, stage) ((void)0)
+#endif
+
+/// Consumer-side summary: keeps the last kWindow samples of every stage and
+/// reports percentiles over them. Not thread-safe; owned by the thread that
+/// drains the rings. No allocation.
+class StageStatistics {
+public:
+  static constexpr int kWindow = 1024;
+
+  struct Summary {
+    uint64_t count = 0; // samples seen since reset()
+    double p50Us = 0.0; // percentiles and max over the window
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+  };
+
+  /// Drain `ring` into the per-stage windows.
+  void collect(StageTimingRing &ring) {
+    ring.drain([this](const StageTimingRing::Sample &s) { add(s); });
+  }
+
+  void add(const StageTimingRing::Sample &s) {
+    const int i = static_cast<int>(s.stage);
+    if (i < 0 || i >= kNumProfileStages)
+      return;
+    Window &w = windows[static_cast<size_t>(i)];
+    w.ns[static_cast<size_t>(w.total % kWindow)] = s.ns;
+    ++w.total;
+  }
+
+  Summary get(ProfileStage stage) const {
+    Summary out;
+    const int i = static_cast<int>(stage);
+    if (i < 0 || i >= kNumProfileStages)
+      return out;
+    const Window &w = windows[static_cast<size_t>(i)];
+    out.count = w.total;
+    const int n = static_cast<int>(std::min<uint64_t>(w.total, kWindow));
+    if (n == 0)
+      return out;
+
+    std::array<uint32_t, kWindow> sorted;
+    std::copy(w.ns.begin(), w.ns.begin() + n, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + n);
+    // Nearest-rank percentiles
+    auto rank = [n](double p) {
+      const int r = static_cast<int>(p * n + 0.999999) - 1;
+      return std::clamp(r, 0, n - 1);
+    };
+    out.p50Us = sorted[static_cast<size_t>(rank(0.50))] * 1.0e-3;
+    out.p99Us = sorted[static_cast<size_t>(rank(0.99))] * 1.0e-3;
+    out.maxUs = sorted[static_cast<size_t>(n - 1)] * 1.0e-3;
+    return out;
+  }
+
+  void reset() {
+    for (auto &w : windows)
+      w.total = 0;
+  }
+
+private:
+  struct Window {
+    std::array<uint32_t, kWindow> ns{};
+    uint64_t total = 0;
+  };
+  std::array<Window, kNumProfileStages> windows{};
+};
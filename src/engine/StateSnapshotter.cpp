@@ -0,0 +1,106 @@
+#include "StateSnapshotter.h"
+#include "GridStateCodec.h"
+
+StateSnapshotter::StateSnapshotter() {
+  thread_ = std::thread([this] { run(); });
+}
+
+StateSnapshotter::~StateSnapshotter() {
+  quit_.store(true, std::memory_order_release);
+  wake_.signal();
+  thread_.join();
+}
+
+bool StateSnapshotter::capture(const CellularEngine &engine) {
+  if (busy_.load(std::memory_order_acquire))
+    return false;
+
+  // Same size: plain copies into the existing storage
+  grid_.copyFrom(engine.getGrid());
+  const size_t n = static_cast<size_t>(grid_.getRows()) *
+                   static_cast<size_t>(grid_.getCols());
+  fields_.resize(static_cast<size_t>(engine.getNumFields()));
+  for (size_t f = 0; f < fields_.size(); ++f) {
+    const float *src = engine.getField(static_cast<int>(f));
+    fields_[f].assign(src, src + n);
+  }
+  engineType_ = engine.getType();
+  generation_ = engine.getGeneration();
+
+  busy_.store(true, std::memory_order_release);
+  wake_.signal();
+  return true;
+}
+
+void StateSnapshotter::reset(const CellularEngine &engine) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // The encode in progress (if any) publishes before the old state is
+    // dropped, so nothing of it survives the reset
+    idle_.wait(lock, [this] { return !busy_.load(std::memory_order_acquire); });
+    latest_.reset();
+  }
+  capture(engine);
+}
+
+std::shared_ptr<const StateSnapshotter::Image>
+StateSnapshotter::latest() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return latest_;
+}
+
+std::shared_ptr<const StateSnapshotter::Image>
+StateSnapshotter::latestOrEncode() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (latest_ != nullptr || !busy_.load(std::memory_order_acquire))
+    return latest_;
+  // The first capture after a reset() is still encoding. The background
+  // thread cannot publish (and release the slot) while the lock is held,
+  // so the slot can be encoded here as well.
+  std::vector<const float *> fieldPtrs;
+  return encodeCapture(fieldPtrs);
+}
+
+std::shared_ptr<const StateSnapshotter::Image>
+StateSnapshotter::waitForLatest() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return !busy_.load(std::memory_order_acquire); });
+  return latest_;
+}
+
+std::shared_ptr<StateSnapshotter::Image>
+StateSnapshotter::encodeCapture(std::vector<const float *> &fieldPtrs) const {
+  auto image = std::make_shared<Image>();
+  fieldPtrs.resize(fields_.size());
+  for (size_t f = 0; f < fields_.size(); ++f)
+    fieldPtrs[f] = fields_[f].data();
+  GridStateCodec::encode(engineType_, grid_, fieldPtrs.data(),
+                         static_cast<int>(fieldPtrs.size()), image->chunk);
+  image->engineType = engineType_;
+  image->rows = grid_.getRows();
+  image->cols = grid_.getCols();
+  image->generation = generation_;
+  return image;
+}
+
+void StateSnapshotter::run() {
+  std::vector<const float *> fieldPtrs;
+  for (;;) {
+    wake_.wait();
+    if (quit_.load(std::memory_order_acquire))
+      return;
+    if (!busy_.load(std::memory_order_acquire))
+      continue;
+
+    // Encode outside the lock; only the pointer swap is guarded
+    auto image = encodeCapture(fieldPtrs);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      latest_ = std::move(image);
+      imagesPublished_.fetch_add(1, std::memory_order_relaxed);
+      busy_.store(false, std::memory_order_release);
+    }
+    idle_.notify_all();
+  }
+}
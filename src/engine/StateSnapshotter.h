@@ -0,0 +1,105 @@
+#pragma once
+// StateSnapshotter -- Keeps an encoded image of the engine state ready for
+// host save calls. The simulation thread copies the grid and float fields
+// every few generations (no locks, no allocation at a fixed size); a
+// background thread encodes the copy with GridStateCodec and publishes it
+// as an immutable, reference-counted image. getStateInformation() then
+// only takes the latest image (or encodes the pending copy itself, right
+// after a reset()): it never waits and never reads the engine while step()
+// is running.
+
+#include "CellularEngine.h"
+#include "Grid.h"
+#include "Semaphore.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class StateSnapshotter {
+public:
+  /// One published state. Never modified after publication; readers keep
+  /// it alive while newer images replace it.
+  struct Image {
+    std::vector<uint8_t> chunk; // GridStateCodec version 2
+    EngineType engineType = EngineType::GoL;
+    int rows = 0;
+    int cols = 0;
+    uint64_t generation = 0;
+  };
+
+  /// Generations between captures by default.
+  static constexpr int kDefaultInterval = 16;
+
+  StateSnapshotter();
+  ~StateSnapshotter();
+
+  StateSnapshotter(const StateSnapshotter &) = delete;
+  StateSnapshotter &operator=(const StateSnapshotter &) = delete;
+
+  /// Generations between captures (SimulationThread). Clamped to >= 1.
+  void setInterval(int generations) {
+    interval_.store(generations < 1 ? 1 : generations,
+                    std::memory_order_relaxed);
+  }
+  int getInterval() const { return interval_.load(std::memory_order_relaxed); }
+
+  /// Copy the engine state and hand it to the encoder. Returns false
+  /// (nothing copied) while the previous capture is still being encoded.
+  /// Call from the one thread that steps the engine, or while nothing
+  /// steps it. Allocates only when the dimensions or field count change.
+  bool capture(const CellularEngine &engine);
+
+  /// The engine was replaced or restored (nothing stepping it): drop the
+  /// images of the old state and capture the new one. Waits for an encode
+  /// in progress to finish first.
+  void reset(const CellularEngine &engine);
+
+  /// Latest published image, or nullptr if none since the last reset().
+  std::shared_ptr<const Image> latest() const;
+
+  /// Latest published image; if none since the last reset() but a capture
+  /// is being encoded, encodes that capture here instead of waiting for the
+  /// background thread. Never reads the engine. nullptr only if nothing was
+  /// captured since the last reset().
+  std::shared_ptr<const Image> latestOrEncode() const;
+
+  /// Wait for a capture in progress to be published, then return the
+  /// latest image (nullptr if nothing was captured since the last reset()).
+  /// Blocks for a full encode: tests and diagnostics only.
+  std::shared_ptr<const Image> waitForLatest();
+
+  /// Images published since construction (tests, diagnostics).
+  uint64_t getImagesPublished() const {
+    return imagesPublished_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void run();
+  // Encode the capture slot (only while busy_, so capture() leaves it alone)
+  std::shared_ptr<Image> encodeCapture(std::vector<const float *> &fieldPtrs) const;
+
+  // Capture slot: written by capture() while !busy_, read by the encoder
+  // while busy_
+  Grid grid_;
+  std::vector<std::vector<float>> fields_;
+  EngineType engineType_ = EngineType::GoL;
+  uint64_t generation_ = 0;
+  std::atomic<bool> busy_{false};
+
+  std::atomic<int> interval_{kDefaultInterval};
+  std::atomic<uint64_t> imagesPublished_{0};
+
+  // Guards latest_; busy_ -> false under it, so holding it keeps the
+  // capture slot stable while busy_
+  mutable std::mutex mutex_;
+  std::condition_variable idle_;
+  std::shared_ptr<const Image> latest_;
+
+  std::thread thread_;
+  Semaphore wake_;
+  std::atomic<bool> quit_{false};
+};
@@ -36,6 +36,18 @@ public:
     return out;
   }
 
+  /// Add the next n samples to out (same values as n nextSample() calls).
+  void addBlock(float *out, int n) {
+    if (level <= 0.0)
+      return;
+    for (int i = 0; i < n; ++i) {
+      out[i] += static_cast<float>(std::sin(kTwoPi * phase) * level);
+      phase += phaseIncrement;
+      if (phase >= 1.0)
+        phase -= 1.0;
+    }
+  }
+
   /// Reset phase (call on note-on).
   void reset() { phase = 0.0; }
 
@@ -5,12 +5,25 @@
 #include "PolyBLEPOscillator.h"
 #include "SVFilter.h"
 #include "SubOscillator.h"
+#include <algorithm>
+#include <cmath>
 
 /// Composite synth voice: Oscillator -> [+ Sub + Noise] -> Filter -> Envelope.
 /// Outputs stereo (L, R) with per-voice panning.
 /// All state internal, no allocations. RT-safe.
+///
+/// renderBlock() is the audio path: each voice renders its envelope and
+/// sources over a block, then filter, amp and pan run for kLanes voices at
+/// once in structure-of-arrays lanes (float, auto-vectorized). Pan gains
+/// are computed once per block. renderNextSample() is the per-sample
+/// double-precision reference.
 class SynthVoice {
 public:
+  /// Voices per SIMD group in renderBlock().
+  static constexpr int kLanes = 4;
+  /// Samples per internal chunk (stack buffers); any n is accepted.
+  static constexpr int kBlockSize = 64;
+
   struct StereoSample {
     double left = 0.0;
     double right = 0.0;
@@ -88,13 +101,44 @@ public:
 
     // Pan: equal-power panning
     // pan = 0.0 (center), -1.0 (full left), 1.0 (full right)
-    double panAngle = (pan + 1.0) * 0.5;                    // 0.0 to 1.0
-    double leftGain = std::cos(panAngle * 1.5707963267949); // pi/4
-    double rightGain = std::sin(panAngle * 1.5707963267949);
+    double panAngle = (pan + 1.0) * 0.5;          // 0.0 to 1.0
+    double leftGain = std::cos(panAngle * kHalfPi); // pi/4
+    double rightGain = std::sin(panAngle * kHalfPi);
 
     return {output * leftGain, output * rightGain};
   }
 
+  /// Add this voice's next n samples to left / right.
+  void renderBlock(float *left, float *right, int n) {
+    SynthVoice *self = this;
+    renderBlock(&self, 1, left, right, n);
+  }
+
+  /// Add the next n samples of every active voice in voices[0, count) to
+  /// left / right. If activeCount is set, activeCount[i] is incremented
+  /// for each voice still active after sample i (as isActive() would
+  /// report after i + 1 renderNextSample() calls).
+  static void renderBlock(SynthVoice *const *voices, int count, float *left,
+                          float *right, int n, int *activeCount = nullptr) {
+    for (int offset = 0; offset < n; offset += kBlockSize) {
+      const int len = std::min(kBlockSize, n - offset);
+      int *counts = activeCount ? activeCount + offset : nullptr;
+      SynthVoice *group[kLanes];
+      int lanes = 0;
+      for (int v = 0; v < count; ++v) {
+        if (!voices[v]->isActive())
+          continue;
+        group[lanes++] = voices[v];
+        if (lanes == kLanes) {
+          renderLanes(group, lanes, left + offset, right + offset, len, counts);
+          lanes = 0;
+        }
+      }
+      if (lanes > 0)
+        renderLanes(group, lanes, left + offset, right + offset, len, counts);
+    }
+  }
+
   /// Check if voice is still producing output.
   bool isActive() const { return active; }
 
@@ -167,6 +211,117 @@ public:
   }
 
 private:
+  static constexpr double kHalfPi = 1.5707963267949;
+
+  /// Pre-filter signal (osc + sub + noise) and amp gain (envelope *
+  /// velocity) for the next n <= kBlockSize samples; zero where the voice is
+  /// silent. Runs the onset and gate countdowns and the envelope like
+  /// renderNextSample(). Returns the number of samples after which the
+  /// voice is still active (n unless it finished in this block).
+  int renderSources(float *input, float *gain, int n) {
+    // Onset delay (strum spread): silent, still active
+    const int begin = std::min(onsetDelaySamples, n);
+    onsetDelaySamples -= begin;
+    std::fill(input, input + begin, 0.0f);
+    std::fill(gain, gain + begin, 0.0f);
+
+    int end = n;
+    for (int i = begin; i < n; ++i) {
+      if (gateRemainingSamples > 0 && !frozen && --gateRemainingSamples == 0)
+        envelope.noteOff();
+      const double envLevel = envelope.nextSample();
+      if (!envelope.isActive()) {
+        active = false;
+        end = i;
+        break;
+      }
+      gain[i] = static_cast<float>(envLevel * vel);
+    }
+
+    if (end > begin) {
+      osc.renderBlock(input + begin, end - begin);
+      sub.addBlock(input + begin, end - begin);
+      noise.addBlock(input + begin, end - begin);
+    }
+    std::fill(input + end, input + n, 0.0f);
+    std::fill(gain + end, gain + n, 0.0f);
+    return end;
+  }
+
+  /// Filter, amp and pan for up to kLanes voices, one per lane. Unused
+  /// lanes hold zero input and gain.
+  static void renderLanes(SynthVoice *const *voices, int lanes, float *left,
+                          float *right, int n, int *activeCount) {
+    float input[kBlockSize][kLanes];
+    float gain[kBlockSize][kLanes];
+    float a1[kLanes] = {}, a2[kLanes] = {}, a3[kLanes] = {};
+    float mixInput[kLanes] = {}, mixV1[kLanes] = {}, mixV2[kLanes] = {};
+    float ic1eq[kLanes] = {}, ic2eq[kLanes] = {};
+    float panLeft[kLanes] = {}, panRight[kLanes] = {};
+
+    for (int j = 0; j < kLanes; ++j) {
+      if (j >= lanes) {
+        for (int i = 0; i < n; ++i)
+          input[i][j] = gain[i][j] = 0.0f;
+        continue;
+      }
+      SynthVoice &voice = *voices[j];
+      float voiceInput[kBlockSize], voiceGain[kBlockSize];
+      const int end = voice.renderSources(voiceInput, voiceGain, n);
+      if (activeCount)
+        for (int i = 0; i < end; ++i)
+          ++activeCount[i];
+      for (int i = 0; i < n; ++i) {
+        input[i][j] = voiceInput[i];
+        gain[i][j] = voiceGain[i];
+      }
+
+      const SVFilter::LaneCoefficients c = voice.filter.getLaneCoefficients();
+      a1[j] = c.a1;
+      a2[j] = c.a2;
+      a3[j] = c.a3;
+      mixInput[j] = c.mixInput;
+      mixV1[j] = c.mixV1;
+      mixV2[j] = c.mixV2;
+      double s1, s2;
+      voice.filter.getState(s1, s2);
+      ic1eq[j] = static_cast<float>(s1);
+      ic2eq[j] = static_cast<float>(s2);
+
+      // Equal-power pan, once per block
+      const double panAngle = (voice.pan + 1.0) * 0.5 * kHalfPi;
+      panLeft[j] = static_cast<float>(std::cos(panAngle));
+      panRight[j] = static_cast<float>(std::sin(panAngle));
+    }
+
+    // Cytomic SVF per lane (see SVFilter::process), then amp and pan
+    for (int i = 0; i < n; ++i) {
+      float outLeft[kLanes], outRight[kLanes];
+      for (int j = 0; j < kLanes; ++j) {
+        const float x = input[i][j];
+        const float v3 = x - ic2eq[j];
+        const float v1 = a1[j] * ic1eq[j] + a2[j] * v3;
+        const float v2 = ic2eq[j] + a2[j] * ic1eq[j] + a3[j] * v3;
+        ic1eq[j] = 2.0f * v1 - ic1eq[j];
+        ic2eq[j] = 2.0f * v2 - ic2eq[j];
+        const float y =
+            (mixInput[j] * x + mixV1[j] * v1 + mixV2[j] * v2) * gain[i][j];
+        outLeft[j] = y * panLeft[j];
+        outRight[j] = y * panRight[j];
+      }
+      float sumLeft = 0.0f, sumRight = 0.0f;
+      for (int j = 0; j < kLanes; ++j) {
+        sumLeft += outLeft[j];
+        sumRight += outRight[j];
+      }
+      left[i] += sumLeft;
+      right[i] += sumRight;
+    }
+
+    for (int j = 0; j < lanes; ++j)
+      voices[j]->filter.setState(ic1eq[j], ic2eq[j]);
+  }
+
   bool active = false;
   int currentNote = -1;
   double vel = 0.0;
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "BitwiseGrid.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Occupancy map of kTileSize x kTileSize cell tiles over a rows x cols
+/// lattice. Binary engines use it to skip empty space: under rules without
+/// birth on zero neighbors, a tile can only change if it holds a live cell
+/// or a neighbor tile has one on the shared border. Each tile therefore
+/// records which of its four border lines (first / last row and column)
+/// are occupied, so a glider in the middle of a tile wakes only that tile.
+///
+/// Tile (tr, tc) covers rows [tr * 64, tr * 64 + 64) and columns
+/// [tc * 64, tc * 64 + 64), clipped to the lattice: one BitwiseGrid word per
+/// row. Neighborhoods wrap like the grids (toroidal).
+class TileActivity {
+public:
+  static constexpr int kTileSize = 64;
+
+  /// Per-tile flags. Any non-zero value means the tile may hold live cells.
+  enum : uint8_t {
+    kLive = 1,
+    kNorth = 2, ///< first row occupied
+    kSouth = 4, ///< last row occupied
+    kWest = 8,  ///< first column occupied
+    kEast = 16  ///< last column occupied
+  };
+
+  /// Allocates and clears. Only call outside step().
+  void resize(int rows, int cols) {
+    rows_ = rows;
+    cols_ = cols;
+    tileRows_ = (rows + kTileSize - 1) / kTileSize;
+    tileCols_ = (cols + kTileSize - 1) / kTileSize;
+    tiles_.assign(static_cast<size_t>(tileRows_) * tileCols_, 0);
+  }
+
+  /// Whether this map covers a rows x cols lattice.
+  bool matches(int rows, int cols) const {
+    return rows == rows_ && cols == cols_;
+  }
+
+  int getTileRows() const { return tileRows_; }
+  int getTileCols() const { return tileCols_; }
+
+  bool get(int tr, int tc) const { return tiles_[index(tr, tc)] != 0; }
+  /// Mark live (with all border flags: nothing known about the cells).
+  void set(int tr, int tc, bool live) {
+    tiles_[index(tr, tc)] = live ? kAllFlags : 0;
+  }
+
+  /// Flag byte per tile of tile row tr (writable per tile row from
+  /// different threads).
+  uint8_t *tileRow(int tr) { return &tiles_[index(tr, 0)]; }
+  const uint8_t *tileRow(int tr) const { return &tiles_[index(tr, 0)]; }
+
+  void fill(bool live) {
+    std::fill(tiles_.begin(), tiles_.end(), live ? kAllFlags : uint8_t{0});
+  }
+
+  int countLive() const {
+    return static_cast<int>(tiles_.size() - std::count(tiles_.begin(),
+                                                       tiles_.end(),
+                                                       uint8_t{0}));
+  }
+
+  void swap(TileActivity &other) noexcept {
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(tileRows_, other.tileRows_);
+    std::swap(tileCols_, other.tileCols_);
+    tiles_.swap(other.tiles_);
+  }
+
+  /// Mark the tiles that can change in the next generation: tiles live in
+  /// `live`, and tiles a live neighbor touches across their shared border
+  /// or corner (toroidal). Same dimensions required.
+  void markActiveFrom(const TileActivity &live) {
+    for (int tr = 0; tr < tileRows_; ++tr) {
+      const uint8_t *north = live.tileRow((tr + tileRows_ - 1) % tileRows_);
+      const uint8_t *same = live.tileRow(tr);
+      const uint8_t *south = live.tileRow((tr + 1) % tileRows_);
+      uint8_t *out = tileRow(tr);
+      for (int tc = 0; tc < tileCols_; ++tc) {
+        const int w = (tc + tileCols_ - 1) % tileCols_;
+        const int e = (tc + 1) % tileCols_;
+        out[tc] = same[tc] || (north[tc] & kSouth) || (south[tc] & kNorth) ||
+                  (same[w] & kEast) || (same[e] & kWest) ||
+                  hasBoth(north[w], kSouth | kEast) ||
+                  hasBoth(north[e], kSouth | kWest) ||
+                  hasBoth(south[w], kNorth | kEast) ||
+                  hasBoth(south[e], kNorth | kWest);
+      }
+    }
+  }
+
+  /// Recompute from a bit plane (flags of every tile).
+  void scan(const BitwiseGrid &plane) {
+    for (int tr = 0; tr < tileRows_; ++tr) {
+      uint8_t *out = tileRow(tr);
+      for (int tc = 0; tc < tileCols_; ++tc)
+        out[tc] = tileFlags(plane, tr, tc);
+    }
+  }
+
+  /// Also mark the tiles occupied in another plane live, without border
+  /// flags (cells that count as occupied but do not cause births, e.g.
+  /// Brian's Brain Dying cells).
+  void scanAdd(const BitwiseGrid &plane) {
+    for (int tr = 0; tr < tileRows_; ++tr) {
+      uint8_t *out = tileRow(tr);
+      for (int tc = 0; tc < tileCols_; ++tc)
+        if (!out[tc] && tileOccupied(plane, tr, tc))
+          out[tc] = kLive;
+    }
+  }
+
+  /// Flags of tile (tr, tc) of a plane: 0 if empty, else kLive plus the
+  /// occupied border lines.
+  static uint8_t tileFlags(const BitwiseGrid &plane, int tr, int tc) {
+    const int r0 = tr * kTileSize;
+    const int r1 = std::min(plane.getRows(), r0 + kTileSize);
+    const int eastBit = std::min(kTileSize, plane.getCols() - tc * kTileSize) - 1;
+    uint64_t any = 0;
+    for (int r = r0; r < r1; ++r)
+      any |= plane.rowData(r)[tc];
+    if (any == 0)
+      return 0;
+    uint64_t westEast = 0;
+    for (int r = r0; r < r1; ++r)
+      westEast |= plane.rowData(r)[tc] & (1ULL | (1ULL << eastBit));
+    return static_cast<uint8_t>(
+        kLive | (plane.rowData(r0)[tc] ? kNorth : 0) |
+        (plane.rowData(r1 - 1)[tc] ? kSouth : 0) |
+        ((westEast & 1ULL) ? kWest : 0) |
+        ((westEast >> eastBit) & 1ULL ? kEast : 0));
+  }
+
+  /// Whether tile (tr, tc) of a plane has any set bit.
+  static bool tileOccupied(const BitwiseGrid &plane, int tr, int tc) {
+    const int r1 = std::min(plane.getRows(), (tr + 1) * kTileSize);
+    uint64_t any = 0;
+    for (int r = tr * kTileSize; r < r1; ++r)
+      any |= plane.rowData(r)[tc];
+    return any != 0;
+  }
+
+  /// Zero tile (tr, tc) of a plane.
+  static void clearTile(BitwiseGrid &plane, int tr, int tc) {
+    const int r1 = std::min(plane.getRows(), (tr + 1) * kTileSize);
+    for (int r = tr * kTileSize; r < r1; ++r)
+      plane.rowData(r)[tc] = 0;
+  }
+
+private:
+  static constexpr uint8_t kAllFlags = kLive | kNorth | kSouth | kWest | kEast;
+
+  static bool hasBoth(uint8_t flags, uint8_t mask) {
+    return (flags & mask) == mask;
+  }
+
+  size_t index(int tr, int tc) const {
+    return static_cast<size_t>(tr) * tileCols_ + tc;
+  }
+
+  int rows_ = 0;
+  int cols_ = 0;
+  int tileRows_ = 0;
+  int tileCols_ = 0;
+  std::vector<uint8_t> tiles_;
+};
@@ -0,0 +1,98 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int numWorkers) {
+  if (numWorkers < 0) {
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    numWorkers = std::max(0, hw - 2);
+  }
+
+  ranges = std::make_unique<Range[]>(static_cast<size_t>(numWorkers) + 1);
+  workers.reserve(static_cast<size_t>(numWorkers));
+  for (int i = 0; i < numWorkers; ++i)
+    workers.emplace_back([this, i] { workerLoop(i + 1); });
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeCv.notify_all();
+  for (auto &t : workers)
+    t.join();
+}
+
+void WorkerPool::run(int numTasks, TaskFn fn, void *ctx) {
+  const int parts = getNumThreads();
+  {
+    // A worker that woke late for the previous job may still be scanning
+    // the ranges; wait for it before handing out new indices.
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCv.wait(lock, [this] { return activeWorkers == 0; });
+
+    for (int p = 0; p < parts; ++p) {
+      ranges[p].end = static_cast<int>(
+          static_cast<int64_t>(numTasks) * (p + 1) / parts);
+      ranges[p].next.store(
+          static_cast<int>(static_cast<int64_t>(numTasks) * p / parts),
+          std::memory_order_relaxed);
+    }
+    jobFn = fn;
+    jobCtx = ctx;
+    tasksRemaining.store(numTasks, std::memory_order_relaxed);
+    ++jobId;
+  }
+  wakeCv.notify_all();
+
+  drain(0, fn, ctx);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCv.wait(lock, [this] {
+    return tasksRemaining.load(std::memory_order_acquire) == 0;
+  });
+}
+
+void WorkerPool::drain(int slot, TaskFn fn, void *ctx) {
+  const int parts = getNumThreads();
+  // Own range first, then steal from the others in ring order
+  for (int k = 0; k < parts; ++k) {
+    Range &range = ranges[(slot + k) % parts];
+    for (;;) {
+      const int i = range.next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= range.end)
+        break;
+      fn(ctx, i);
+      if (tasksRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        doneCv.notify_all();
+      }
+    }
+  }
+}
+
+void WorkerPool::workerLoop(int slot) {
+  uint64_t seenJob = 0;
+  for (;;) {
+    TaskFn fn;
+    void *ctx;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeCv.wait(lock, [&] { return stopping || jobId != seenJob; });
+      if (stopping)
+        return;
+      seenJob = jobId;
+      fn = jobFn;
+      ctx = jobCtx;
+      ++activeWorkers;
+    }
+
+    drain(slot, fn, ctx);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--activeWorkers == 0)
+        doneCv.notify_all();
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// Persistent work-stealing thread pool for engine stepping.
+///
+/// parallelFor() splits task indices into one contiguous range per
+/// participant (the calling thread plus every worker). Each participant
+/// drains its own range front to back, then steals remaining indices from
+/// the other ranges. Tasks must write disjoint memory; results are then
+/// independent of which thread ran which task.
+///
+/// Threads are created once in the constructor. parallelFor() does not
+/// allocate, but it blocks, so never call it from the audio thread.
+class WorkerPool {
+public:
+  /// @param numWorkers  Helper threads besides the caller. -1 picks
+  ///                    hardware_concurrency() - 2 (one core is left to the
+  ///                    audio thread), 0 runs everything on the caller.
+  explicit WorkerPool(int numWorkers = -1);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /// Threads taking part in parallelFor(), including the caller.
+  int getNumThreads() const { return static_cast<int>(workers.size()) + 1; }
+
+  /// Run fn(i) for every i in [0, numTasks) and wait for all to finish.
+  /// If another thread is already inside parallelFor() (or fn calls it
+  /// recursively), the tasks run serially on the calling thread instead.
+  template <typename Fn> void parallelFor(int numTasks, Fn &&fn) {
+    if (numTasks <= 0)
+      return;
+    if (numTasks == 1 || workers.empty() ||
+        busy.exchange(true, std::memory_order_acquire)) {
+      for (int i = 0; i < numTasks; ++i)
+        fn(i);
+      return;
+    }
+    using FnType = std::remove_reference_t<Fn>;
+    run(numTasks,
+        [](void *ctx, int i) { (*static_cast<FnType *>(ctx))(i); },
+        const_cast<void *>(static_cast<const void *>(&fn)));
+    busy.store(false, std::memory_order_release);
+  }
+
+private:
+  using TaskFn = void (*)(void *ctx, int index);
+
+  /// One contiguous range of task indices. Owner and thieves both claim
+  /// from the front with fetch_add, so each index runs exactly once.
+  struct alignas(64) Range {
+    std::atomic<int> next{0};
+    int end = 0;
+  };
+
+  void run(int numTasks, TaskFn fn, void *ctx);
+  void workerLoop(int slot);
+  void drain(int slot, TaskFn fn, void *ctx);
+
+  std::vector<std::thread> workers;
+  std::unique_ptr<Range[]> ranges; // getNumThreads() entries
+
+  std::mutex mutex;
+  std::condition_variable wakeCv;
+  std::condition_variable doneCv;
+  uint64_t jobId = 0;   // bumped for each parallelFor (guarded by mutex)
+  int activeWorkers = 0; // workers currently inside drain()
+  bool stopping = false;
+  TaskFn jobFn = nullptr;
+  void *jobCtx = nullptr;
+  std::atomic<int> tasksRemaining{0};
+  std::atomic<bool> busy{false}; // a parallelFor() is in flight
+};
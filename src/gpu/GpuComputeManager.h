@@ -24,6 +24,24 @@ public:
   GpuComputeManager(const GpuComputeManager &) = delete;
   GpuComputeManager &operator=(const GpuComputeManager &) = delete;
 
+  /// Whether setEngine() has a ComputeSimulation adapter for this type.
+  /// Safe from any thread.
+  static bool hasAdapter(EngineType type) {
+    switch (type) {
+    case EngineType::GoL:
+    case EngineType::BriansBrain:
+    case EngineType::CyclicCA:
+    case EngineType::ReactionDiffusion:
+    case EngineType::Lenia:
+    case EngineType::ParticleSwarm:
+    case EngineType::BrownianField:
+    case EngineType::Lenia3D:
+      return true;
+    default:
+      return false; // HashLife: CPU only
+    }
+  }
+
   /// Set the engine type and grid dimensions.
   /// Creates the appropriate ComputeSimulation adapter.
   /// Call from UI thread only.
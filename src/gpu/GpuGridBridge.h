@@ -1,39 +1,75 @@
 #pragma once
 // GpuGridBridge -- Lock-free bridge between simulation (GPU or CPU) and
-// audio/UI consumers. Float-only hot path: GPU readback is just memcpy +
-// atomic swap. Optional Grid conversion for binary engines.
+// audio/UI consumers. Float-only hot path: GPU readback is a memcpy plus a
+// birth/death diff, then an atomic index swap. Optional Grid conversion for
+// binary engines.
+//
+// Four frames rotate: current, previous, an older one, and the one being
+// written. Each frame carries the cell events (births / deaths) that turned
+// the previous frame into it, so consumers can visit only the cells that
+// changed. Each frame also keeps a 64x64 tile occupancy map so full
+// conversions and diffs skip empty space.
+//
+// readLock() holds the frame it returns (and its previous) until
+// readUnlock(). The writer never writes a held frame: it yields until the
+// hold is released. With four frames that only happens when a reader holds
+// across two publishes; readers never wait.
 //
 // Write side (one writer at a time):
 //   GPU readback:  updateFromGpu(float*, rows, cols)   -- message thread
-//   CPU engine:    updateFromCpu(Grid&)                 -- audio thread
+//   CPU engine:    updateFromCpu(Grid&, events, tiles)  -- simulation thread
 //
 // Read side (lock-free, any thread):
+//   readLock(cur, prev, events, n) -- current/previous buffers + events
+//   readUnlock(cur)                -- release them
 //   getCellIntensity(r, c) -- continuous 0.0-1.0
 //   isAlive(r, c)          -- thresholded binary check
 //   wasBorn(r, c)          -- birth detection (current alive, previous dead)
 //   countAlive()           -- count cells above threshold
+//   countAliveSampled()    -- same, on the trigger lattice only
 //   getDensity()           -- fraction of alive cells
 
+#include "engine/CellEvents.h"
 #include "engine/Grid.h"
+#include "engine/TileActivity.h"
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 class GpuGridBridge {
 public:
+  /// Threshold for alive / birth detection and the cached alive count.
+  static constexpr float kAliveThreshold = 0.1f;
+
   GpuGridBridge() = default;
 
-  /// Configure dimensions. Call before first use.
+  /// Configure dimensions. Call before first use. Waits for readers to
+  /// release their frames; readLock() fails until it returns.
   void resize(int rows, int cols) {
+    current_.store(kNoFrame, std::memory_order_seq_cst);
+    for (int f = 0; f < kFrames; ++f)
+      while (holds_[f].load(std::memory_order_seq_cst) > 0)
+        std::this_thread::yield();
     rows_ = rows;
     cols_ = cols;
     size_t n = static_cast<size_t>(rows) * cols;
-    bufA_.resize(n, 0.0f);
-    bufB_.resize(n, 0.0f);
-    prevBuf_.resize(n, 0.0f);
-    readBuf_.store(bufA_.data(), std::memory_order_relaxed);
-    writeBuf_.store(bufB_.data(), std::memory_order_relaxed);
+    const size_t maxEvents =
+        std::min(n, static_cast<size_t>(CellEventList::kMaxEvents));
+    for (auto &frame : frames_) {
+      frame.cells.assign(n, 0.0f);
+      frame.events.clear();
+      frame.events.reserve(maxEvents);
+      frame.eventsComplete = true; // all-zero frames: nothing changed
+      frame.binary = true;
+      frame.alive = 0;
+      frame.latticeAlive = 0;
+      frame.tiles.resize(rows, cols);
+    }
+    current_.store(0, std::memory_order_release);
+    chainValid_ = false;
   }
 
   // ---------------------------------------------------------------
@@ -41,7 +77,7 @@ public:
   // ---------------------------------------------------------------
 
   /// Called on message thread when GPU readback completes.
-  /// Hot path: memcpy + atomic swap. No per-cell conversion.
+  /// Copies the frame and diffs it against the current one for events.
   void updateFromGpu(const float *data, int rows, int cols) {
     if (!data || rows <= 0 || cols <= 0)
       return;
@@ -49,68 +85,154 @@ public:
     if (rows != rows_ || cols != cols_)
       resize(rows, cols);
 
-    size_t n = static_cast<size_t>(rows) * cols;
-    float *dst = writeBuf_.load(std::memory_order_relaxed);
-
-    // Snapshot current as previous (for birth detection)
-    float *cur = readBuf_.load(std::memory_order_acquire);
-    std::memcpy(prevBuf_.data(), cur, n * sizeof(float));
-
-    // Copy new data
-    std::memcpy(dst, data, n * sizeof(float));
-
-    // Atomic swap: make write buffer the new read buffer
-    float *old = readBuf_.exchange(dst, std::memory_order_release);
-    writeBuf_.store(old, std::memory_order_relaxed);
-
-    generation_.fetch_add(1, std::memory_order_release);
+    const int cur = current_.load(std::memory_order_relaxed);
+    Frame &dst = beginWrite(cur);
+    std::memcpy(dst.cells.data(), data, dst.cells.size() * sizeof(float));
+    dst.tiles.fill(true); // not tracked for continuous frames
+    diffAgainst(dst, frames_[cur]);
+    dst.binary = false;
+    publish(cur);
   }
 
-  /// Called on audio thread after CPU engine steps.
-  /// Converts Grid cell values to floats (fast for small grids).
-  void updateFromCpu(const Grid &grid) {
+  /// Called on the simulation thread after CPU engine steps.
+  ///
+  /// With a complete event list holding the net change since the previous
+  /// publish (one step, or a merged batch; see SimulationThread), only the
+  /// changed cells are written: the outgoing frame is brought forward by
+  /// replaying the events of the three frames after it plus the new ones.
+  /// Otherwise (nullptr, overflow, resize, GPU frames in the chain) the
+  /// grid is converted and the events are rebuilt by diffing.
+  ///
+  /// liveTiles (CellularEngine::getLiveTiles()) marks the tiles that may
+  /// hold live cells; the conversion and the diff then skip the rest, so
+  /// their cost scales with the live area instead of the grid.
+  void updateFromCpu(const Grid &grid, const CellEventList *events = nullptr,
+                     const TileActivity *liveTiles = nullptr) {
     int rows = grid.getRows();
     int cols = grid.getCols();
 
     if (rows != rows_ || cols != cols_)
       resize(rows, cols);
 
-    size_t n = static_cast<size_t>(rows) * cols;
-    float *dst = writeBuf_.load(std::memory_order_relaxed);
-
-    // Snapshot current as previous
-    float *cur = readBuf_.load(std::memory_order_acquire);
-    std::memcpy(prevBuf_.data(), cur, n * sizeof(float));
+    const int cur = current_.load(std::memory_order_relaxed);
+    Frame &current = frames_[cur];
+    Frame &dst = beginWrite(cur);
+    if (liveTiles && !liveTiles->matches(rows, cols))
+      liveTiles = nullptr;
+
+    // dst is the oldest frame; the others follow it in publish order
+    bool incremental =
+        events && events->complete() && chainValid_ && dst.binary &&
+        static_cast<size_t>(events->size()) <= dst.events.capacity();
+    for (int k = 2; k <= kFrames && incremental; ++k) {
+      const Frame &later = frames_[(cur + k) % kFrames];
+      incremental = later.binary && later.eventsComplete;
+    }
 
-    // Convert Grid cells to float
-    for (int r = 0; r < rows; ++r) {
-      for (int c = 0; c < cols; ++c) {
-        dst[r * cols + c] = (grid.getCell(r, c) > 0) ? 1.0f : 0.0f;
+    if (incremental) {
+      // Replay the later frames' events, then the new ones
+      for (int k = 2; k <= kFrames; ++k)
+        applyEvents(dst.cells.data(), frames_[(cur + k) % kFrames].events);
+      dst.events.assign(events->begin(), events->end());
+      applyEvents(dst.cells.data(), dst.events);
+      dst.alive = current.alive;
+      dst.latticeAlive = current.latticeAlive;
+      const int skip = latticeSkip(rows_, cols_);
+      for (const auto &e : dst.events) {
+        const int delta = (e.type == CellEvent::Birth) ? 1 : -1;
+        dst.alive += delta;
+        if (e.row % skip == 0 && e.col % skip == 0)
+          dst.latticeAlive += delta;
+      }
+      dst.eventsComplete = true;
+      if (liveTiles) {
+        dst.tiles = *liveTiles; // same size: no allocation
+      } else {
+        dst.tiles = current.tiles;
+        for (const auto &e : dst.events)
+          if (e.type == CellEvent::Birth)
+            dst.tiles.set(e.row / TileActivity::kTileSize,
+                          e.col / TileActivity::kTileSize, true);
       }
+    } else {
+      // Convert Grid cells to float, tile by tile. Tiles known to be dead
+      // are only cleared if dst may still hold cells there.
+      for (int tr = 0; tr < dst.tiles.getTileRows(); ++tr) {
+        for (int tc = 0; tc < dst.tiles.getTileCols(); ++tc) {
+          if (liveTiles && !liveTiles->get(tr, tc)) {
+            if (dst.tiles.get(tr, tc))
+              clearTile(dst, tr, tc);
+            dst.tiles.set(tr, tc, false);
+          } else {
+            dst.tiles.set(tr, tc, convertTile(grid, dst, tr, tc));
+          }
+        }
+      }
+      diffAgainst(dst, current);
     }
-
-    float *old = readBuf_.exchange(dst, std::memory_order_release);
-    writeBuf_.store(old, std::memory_order_relaxed);
-
-    generation_.fetch_add(1, std::memory_order_release);
+    dst.binary = true;
+    publish(cur);
+    chainValid_ = true;
   }
 
   // ---------------------------------------------------------------
   // Read side (lock-free)
   // ---------------------------------------------------------------
 
-  /// Fetch current and previous float buffers for bulk reading.
-  /// Must call readUnlock() when done.
+  /// Fetch current and previous float buffers for bulk reading and hold
+  /// them. Call readUnlock(current) when done, also when this fails (a
+  /// no-op then). Lock-free: retries only if a publish lands meanwhile.
   bool readLock(const float *&current, const float *&previous) const {
-    current = readBuf_.load(std::memory_order_acquire);
-    previous = prevBuf_.data();
-    return current != nullptr;
+    const CellEvent *events = nullptr;
+    int numEvents = 0;
+    return readLock(current, previous, events, numEvents);
+  }
+
+  /// As above, plus the events that turned `previous` into `current`
+  /// (unspecified order). events is nullptr when that frame's list is
+  /// incomplete (overflow): scan the buffers instead.
+  bool readLock(const float *&current, const float *&previous,
+                const CellEvent *&events, int &numEvents) const {
+    current = previous = nullptr;
+    events = nullptr;
+    numEvents = 0;
+    // Announce the hold, then check the frame is still current: a writer
+    // that missed the announcement has not advanced past it, and will see
+    // it before it could pick this frame or its previous again
+    int cur = current_.load(std::memory_order_seq_cst);
+    for (;;) {
+      if (cur == kNoFrame)
+        return false; // resizing
+      holds_[cur].fetch_add(1, std::memory_order_seq_cst);
+      const int now = current_.load(std::memory_order_seq_cst);
+      if (now == cur)
+        break;
+      holds_[cur].fetch_sub(1, std::memory_order_release);
+      cur = now;
+    }
+    const Frame &frame = frames_[cur];
+    if (frame.cells.empty()) {
+      holds_[cur].fetch_sub(1, std::memory_order_release);
+      return false;
+    }
+    current = frame.cells.data();
+    previous = frames_[(cur + kFrames - 1) % kFrames].cells.data();
+    events = frame.eventsComplete ? frame.events.data() : nullptr;
+    numEvents = frame.eventsComplete ? static_cast<int>(frame.events.size())
+                                     : 0;
+    return true;
   }
 
-  void readUnlock() const {
-    // No-op for now. Future: could use hazard pointers or a spinlock
-    // if writer needs to wait. For double-buffering with memcpy,
-    // readBuf_ gives us a stable buffer while writer uses the other.
+  /// Release the frames of a readLock() that returned `current`.
+  void readUnlock(const float *current) const {
+    if (current == nullptr)
+      return;
+    for (int f = 0; f < kFrames; ++f) {
+      if (frames_[f].cells.data() == current) {
+        holds_[f].fetch_sub(1, std::memory_order_release);
+        return;
+      }
+    }
   }
 
   /// Continuous float intensity from a locked buffer.
@@ -123,14 +245,14 @@ public:
 
   /// Whether a cell is above the alive threshold from a locked buffer.
   static bool isAliveLocked(const float *current, int rows, int cols, int row,
-                            int col, float threshold = 0.1f) {
+                            int col, float threshold = kAliveThreshold) {
     return getCellIntensityLocked(current, rows, cols, row, col) >= threshold;
   }
 
   /// Whether a cell was just born from locked buffers.
   static bool wasBornLocked(const float *current, const float *previous,
                             int rows, int cols, int row, int col,
-                            uint64_t generation, float threshold = 0.1f) {
+                            uint64_t generation, float threshold = kAliveThreshold) {
     if (generation < 2)
       return false;
     if (row < 0 || row >= rows || col < 0 || col >= cols)
@@ -139,22 +261,93 @@ public:
     return current[idx] >= threshold && previous[idx] < threshold;
   }
 
-  /// Count of cells above threshold from a locked buffer.
-  int countAlive(float threshold = 0.1f) const {
-    const float *data = readBuf_.load(std::memory_order_acquire);
-    if (!data)
+  struct CellPos {
+    int row;
+    int col;
+  };
+
+  /// Trigger candidates: newly born cells on the `skip` lattice, at most one
+  /// per lattice column (the lowest row), in column order. Walks the
+  /// frame's events when they are complete and fewer than the lattice cells,
+  /// otherwise scans the lattice with wasBornLocked(); both give the same
+  /// result. `out` needs room for (cols + skip - 1) / skip entries.
+  static int collectFirstBirths(const float *current, const float *previous,
+                                const CellEvent *events, int numEvents,
+                                int rows, int cols, int skip,
+                                uint64_t generation, CellPos *out) {
+    if (generation < 2)
       return 0;
+    const int latticeRows = (rows + skip - 1) / skip;
+    const int latticeCols = (cols + skip - 1) / skip;
     int count = 0;
-    int n = rows_ * cols_;
-    for (int i = 0; i < n; ++i) {
-      if (data[i] >= threshold)
+
+    if (events && numEvents < latticeRows * latticeCols) {
+      int firstRow[Grid::kMaxCols];
+      std::fill_n(firstRow, latticeCols, rows);
+      for (int i = 0; i < numEvents; ++i) {
+        const CellEvent &e = events[i];
+        if (e.type != CellEvent::Birth || e.row % skip != 0 ||
+            e.col % skip != 0)
+          continue;
+        int &first = firstRow[e.col / skip];
+        first = std::min(first, static_cast<int>(e.row));
+      }
+      for (int lc = 0; lc < latticeCols; ++lc)
+        if (firstRow[lc] < rows)
+          out[count++] = {firstRow[lc], lc * skip};
+      return count;
+    }
+
+    for (int col = 0; col < cols; col += skip) {
+      for (int row = 0; row < rows; row += skip) {
+        if (wasBornLocked(current, previous, rows, cols, row, col,
+                          generation)) {
+          out[count++] = {row, col};
+          break;
+        }
+      }
+    }
+    return count;
+  }
+
+  /// Count of cells above threshold. O(1) for kAliveThreshold (counted
+  /// when the frame was published), a full scan otherwise.
+  int countAlive(float threshold = kAliveThreshold) const {
+    const int cur = current_.load(std::memory_order_acquire);
+    if (cur == kNoFrame)
+      return 0;
+    const Frame &frame = frames_[cur];
+    if (threshold == kAliveThreshold)
+      return frame.alive;
+    int count = 0;
+    for (float v : frame.cells) {
+      if (v >= threshold)
         ++count;
     }
     return count;
   }
 
+  /// Every skip-th row and column of a grid forms the trigger lattice, so
+  /// 1280x1280 (skip = 10) maps onto 128x128 cells.
+  static int latticeSkip(int rows, int cols) {
+    return std::max(1, std::max(rows, cols) / 128);
+  }
+
+  /// Alive cells on the latticeSkip() lattice of the current frame, counted
+  /// when it was published (O(1)).
+  int countAliveSampled() const {
+    const int cur = current_.load(std::memory_order_acquire);
+    return cur == kNoFrame ? 0 : frames_[cur].latticeAlive;
+  }
+
+  /// Cells on the lattice.
+  int getLatticeCells() const {
+    const int skip = latticeSkip(rows_, cols_);
+    return ((rows_ + skip - 1) / skip) * ((cols_ + skip - 1) / skip);
+  }
+
   /// Fraction of alive cells.
-  float getDensity(float threshold = 0.1f) const {
+  float getDensity(float threshold = kAliveThreshold) const {
     int n = rows_ * cols_;
     if (n == 0)
       return 0.0f;
@@ -174,12 +367,12 @@ public:
   // Optional Grid conversion (for binary engines / legacy compat)
   // ---------------------------------------------------------------
 
-  /// Build a Grid snapshot from the current float buffer.
-  /// Expensive at large sizes — use sparingly.
-  void convertToGrid(Grid &out, float threshold = 0.1f) const {
+  /// Build a Grid snapshot from the current float buffer (held while it
+  /// is read). Expensive at large sizes — use sparingly.
+  void convertToGrid(Grid &out, float threshold = kAliveThreshold) const {
     out.resize(rows_, cols_);
-    const float *data = readBuf_.load(std::memory_order_acquire);
-    if (!data)
+    const float *data = nullptr, *previous = nullptr;
+    if (!readLock(data, previous))
       return;
     for (int r = 0; r < rows_; ++r) {
       for (int c = 0; c < cols_; ++c) {
@@ -191,16 +384,130 @@ public:
         out.setAge(r, c, intensity);
       }
     }
+    readUnlock(data);
   }
 
 private:
-  // Double-buffered float arrays
-  std::vector<float> bufA_;
-  std::vector<float> bufB_;
-  std::vector<float> prevBuf_; // previous frame for birth detection
+  struct Frame {
+    std::vector<float> cells;
+    std::vector<CellEvent> events; // changes from the frame before
+    bool eventsComplete = true;    // false: events overflowed, rescan
+    bool binary = true;            // cells are exactly 0.0 / 1.0 (CPU)
+    int alive = 0;                 // cells >= kAliveThreshold
+    int latticeAlive = 0;          // same, on the latticeSkip() lattice
+    TileActivity tiles;            // set for every tile with a non-zero cell
+  };
+
+  /// Write tile (tr, tc) of the grid into dst as 0.0 / 1.0. Returns whether
+  /// it has a live cell.
+  bool convertTile(const Grid &grid, Frame &dst, int tr, int tc) const {
+    const int r1 = std::min(rows_, (tr + 1) * TileActivity::kTileSize);
+    const int c0 = tc * TileActivity::kTileSize;
+    const int c1 = std::min(cols_, c0 + TileActivity::kTileSize);
+    bool any = false;
+    for (int r = tr * TileActivity::kTileSize; r < r1; ++r) {
+      const uint8_t *cells = grid.cellRow(r);
+      float *out = dst.cells.data() + static_cast<size_t>(r) * cols_;
+      for (int c = c0; c < c1; ++c) {
+        out[c] = (cells[c] > 0) ? 1.0f : 0.0f;
+        any |= cells[c] > 0;
+      }
+    }
+    return any;
+  }
+
+  /// Zero tile (tr, tc) of dst.
+  void clearTile(Frame &dst, int tr, int tc) const {
+    const int r1 = std::min(rows_, (tr + 1) * TileActivity::kTileSize);
+    const int c0 = tc * TileActivity::kTileSize;
+    const int c1 = std::min(cols_, c0 + TileActivity::kTileSize);
+    for (int r = tr * TileActivity::kTileSize; r < r1; ++r) {
+      float *out = dst.cells.data() + static_cast<size_t>(r) * cols_;
+      std::fill(out + c0, out + c1, 0.0f);
+    }
+  }
+
+  /// Rebuild dst.events / dst.alive by comparing dst with the frame before.
+  /// Only tiles non-empty in either frame are visited (row-major order).
+  void diffAgainst(Frame &dst, const Frame &before) const {
+    dst.events.clear();
+    dst.eventsComplete = true;
+    int alive = 0;
+    const int tileCols = dst.tiles.getTileCols();
+    for (int r = 0; r < rows_; ++r) {
+      const int tr = r / TileActivity::kTileSize;
+      const float *now = dst.cells.data() + static_cast<size_t>(r) * cols_;
+      const float *was = before.cells.data() + static_cast<size_t>(r) * cols_;
+      for (int tc = 0; tc < tileCols; ++tc) {
+        if (!dst.tiles.get(tr, tc) && !before.tiles.get(tr, tc))
+          continue;
+        const int c0 = tc * TileActivity::kTileSize;
+        const int c1 = std::min(cols_, c0 + TileActivity::kTileSize);
+        for (int c = c0; c < c1; ++c) {
+          const bool isAlive = now[c] >= kAliveThreshold;
+          alive += isAlive ? 1 : 0;
+          if (isAlive == (was[c] >= kAliveThreshold))
+            continue;
+          if (dst.events.size() == dst.events.capacity()) {
+            dst.eventsComplete = false; // never grow: keep the writer lean
+            continue;
+          }
+          CellEvent e;
+          e.row = static_cast<uint16_t>(r);
+          e.col = static_cast<uint16_t>(c);
+          e.type = isAlive ? CellEvent::Birth : CellEvent::Death;
+          e.intensity = now[c];
+          dst.events.push_back(e);
+        }
+      }
+    }
+    dst.alive = alive;
+
+    // Lattice count: at most 128 x 128 reads
+    const int skip = latticeSkip(rows_, cols_);
+    int latticeAlive = 0;
+    for (int r = 0; r < rows_; r += skip) {
+      const float *now = dst.cells.data() + static_cast<size_t>(r) * cols_;
+      for (int c = 0; c < cols_; c += skip)
+        latticeAlive += now[c] >= kAliveThreshold ? 1 : 0;
+    }
+    dst.latticeAlive = latticeAlive;
+  }
+
+  /// Replay binary events onto a frame's cells.
+  void applyEvents(float *cells, const std::vector<CellEvent> &events) const {
+    for (const auto &e : events)
+      cells[static_cast<size_t>(e.row) * cols_ + e.col] =
+          (e.type == CellEvent::Birth) ? 1.0f : 0.0f;
+  }
+
+  /// The frame after cur, once no reader holds it: a reader holding frame f
+  /// also reads f - 1, so the next frame's hold counts too.
+  Frame &beginWrite(int cur) {
+    const int target = (cur + 1) % kFrames;
+    const int after = (cur + 2) % kFrames;
+    while (holds_[target].load(std::memory_order_seq_cst) > 0 ||
+           holds_[after].load(std::memory_order_seq_cst) > 0)
+      std::this_thread::yield();
+    return frames_[target];
+  }
+
+  void publish(int cur) {
+    current_.store((cur + 1) % kFrames, std::memory_order_seq_cst);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
 
-  mutable std::atomic<float *> readBuf_{nullptr};
-  std::atomic<float *> writeBuf_{nullptr};
+  static constexpr int kFrames = 4;
+  static constexpr int kNoFrame = -1; // current_ while resizing
+
+  // Current = frames_[current_], previous = (current_ + kFrames - 1) %
+  // kFrames, and the next write goes to (current_ + 1) % kFrames, the
+  // oldest frame.
+  Frame frames_[kFrames];
+  std::atomic<int> current_{0};
+  // readLock() holds per frame (also covering the frame before it)
+  mutable std::atomic<int> holds_[kFrames] = {};
+  bool chainValid_ = false; // writer-only: frames hold real published states
 
   int rows_ = 0;
   int cols_ = 0;
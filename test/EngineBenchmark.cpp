@@ -0,0 +1,1250 @@
+// Headless engine benchmarks (pure C++, no JUCE dependency).
+// Reports throughput per grid size so regressions show up between releases.
+// Not part of the pass/fail test run -- build AlgoNebulaBench and run it
+// manually in a Release configuration.
+//
+//   AlgoNebulaBench                 comparison reports (before / after)
+//   AlgoNebulaBench --suite         regression suite as a table
+//   AlgoNebulaBench --json[=file]   regression suite as JSON (Google
+//                                   Benchmark layout, stdout by default)
+//   --filter=text                   suite cases whose name contains text
+//   --min-time=seconds              per case (default 0.25)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/AudioWorkerPool.h"
+#include "engine/BriansBrain.h"
+#include "engine/BrownianField.h"
+#include "engine/CyclicCA.h"
+#include "engine/FactoryPatternLibrary.h"
+#include "engine/GameOfLife.h"
+#include "engine/GridSizes.h"
+#include "engine/GridStateCodec.h"
+#include "engine/HashLife.h"
+#include "engine/LeniaEngine.h"
+#include "engine/LifeKernels.h"
+#include "engine/ParticleSwarm.h"
+#include "engine/ReactionDiffusion.h"
+#include "engine/ScaleQuantizer.h"
+#include "engine/SynthVoice.h"
+#include "engine/WorkerPool.h"
+#include "gpu/GpuGridBridge.h"
+
+#include "dsp/Bitcrush.h"
+#include "dsp/EffectChain.h"
+#include "dsp/PingPongDelay.h"
+#include "dsp/PlateReverb.h"
+#include "dsp/ShimmerReverb.h"
+#include "dsp/StereoChorus.h"
+#include "dsp/StereoDelay.h"
+#include "dsp/StereoFlanger.h"
+#include "dsp/StereoPhaser.h"
+#include "dsp/TapeSaturation.h"
+#include "dsp/pocketfft_hdronly.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Measurement {
+  int iterations = 0;
+  double seconds = 0.0;    // wall clock
+  double cpuSeconds = 0.0; // process CPU time (all threads)
+};
+
+/// Run fn repeatedly for at least minSeconds (and at least minIters times).
+template <typename Fn>
+Measurement measure(Fn &&fn, double minSeconds = 0.25, int minIters = 3) {
+  fn(); // warm-up (first-touch page faults, lazy buffers)
+  Measurement m;
+  const auto start = Clock::now();
+  const std::clock_t cpuStart = std::clock();
+  while (m.iterations < minIters || m.seconds < minSeconds) {
+    fn();
+    ++m.iterations;
+    m.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  }
+  m.cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+  return m;
+}
+
+/// Iterations per second of fn (see measure()).
+template <typename Fn>
+double measureRate(Fn &&fn, double minSeconds = 0.25, int minIters = 3) {
+  const Measurement m = measure(fn, minSeconds, minIters);
+  return m.iterations / m.seconds;
+}
+
+const LifeKernels::Isa kIsas[] = {LifeKernels::Isa::Scalar,
+                                  LifeKernels::Isa::AVX2,
+                                  LifeKernels::Isa::AVX512};
+
+/// One column per supported instruction set. Grids below the bitwise
+/// threshold (128x128) run the per-cell path, so the columns match there.
+template <typename Engine, typename Make>
+void benchPerIsa(const char *title, Make &&make) {
+  const auto best = LifeKernels::getIsa();
+  std::printf("\n[%s -- generations/sec]\n  %-11s", title, "size");
+  for (auto isa : kIsas)
+    if (LifeKernels::isSupported(isa))
+      std::printf(" %12s", LifeKernels::getIsaName(isa));
+  std::printf("\n");
+
+  for (int i = 0; i < kNumGridSizes; ++i) {
+    const int rows = kGridSizes[i][0];
+    const int cols = kGridSizes[i][1];
+    std::printf("  %5dx%-5d", rows, cols);
+    for (auto isa : kIsas) {
+      if (!LifeKernels::isSupported(isa))
+        continue;
+      LifeKernels::setIsa(isa);
+      Engine engine = make(rows, cols);
+      engine.randomize(42, 0.3f);
+      std::printf(" %12.1f", measureRate([&] { engine.step(); }));
+    }
+    std::printf("\n");
+  }
+  LifeKernels::setIsa(best);
+}
+
+/// Packed-kernel throughput alone (no Grid pack/unpack), grids >= 128x128.
+void benchLifeKernels() {
+  const auto best = LifeKernels::getIsa();
+  std::printf("\n[Life kernel only, B3/S23 -- generations/sec]\n  %-11s",
+              "size");
+  for (auto isa : kIsas)
+    if (LifeKernels::isSupported(isa))
+      std::printf(" %12s", LifeKernels::getIsaName(isa));
+  std::printf("\n");
+
+  for (int i = 0; i < kNumGridSizes; ++i) {
+    const int rows = kGridSizes[i][0];
+    const int cols = kGridSizes[i][1];
+    if (rows * cols < 128 * 128)
+      continue;
+    BitwiseGrid cur, next;
+    cur.resize(rows, cols);
+    next.resize(rows, cols);
+    uint64_t state = 42;
+    for (int r = 0; r < rows; ++r)
+      for (int c = 0; c < cols; ++c) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        cur.setCell(r, c, (state >> 32) % 10 < 3);
+      }
+
+    std::printf("  %5dx%-5d", rows, cols);
+    for (auto isa : kIsas) {
+      if (!LifeKernels::isSupported(isa))
+        continue;
+      LifeKernels::setIsa(isa);
+      std::printf(" %12.1f", measureRate([&] {
+                    LifeKernels::stepLife(cur, next, 1 << 3,
+                                          (1 << 2) | (1 << 3));
+                    cur.swap(next);
+                  }));
+    }
+    std::printf("\n");
+  }
+  LifeKernels::setIsa(best);
+}
+
+void benchGameOfLife() {
+  benchPerIsa<GameOfLife>("Game of Life", [](int rows, int cols) {
+    return GameOfLife(rows, cols, GameOfLife::RulePreset::Classic);
+  });
+}
+
+void benchBriansBrain() {
+  benchPerIsa<BriansBrain>("Brian's Brain", [](int rows, int cols) {
+    return BriansBrain(rows, cols);
+  });
+}
+
+/// The Cyclic CA step before bit-slicing: up to eight wrapped getCell()
+/// calls per cell, written into a back grid.
+struct LegacyCyclicCA {
+  explicit LegacyCyclicCA(const Grid &src) {
+    grid.copyFrom(src);
+    scratch.resize(src.getRows(), src.getCols());
+  }
+
+  void step() {
+    for (int r = 0; r < grid.getRows(); ++r)
+      for (int c = 0; c < grid.getCols(); ++c) {
+        const uint8_t current = grid.getCell(r, c);
+        const uint8_t next = (current + 1) % CyclicCA::kNumStates;
+        bool consumed = false;
+        for (int dr = -1; dr <= 1 && !consumed; ++dr)
+          for (int dc = -1; dc <= 1 && !consumed; ++dc)
+            if ((dr != 0 || dc != 0) && grid.getCell(r + dr, c + dc) == next)
+              consumed = true;
+        const uint16_t age = grid.getAge(r, c);
+        scratch.setCell(r, c, consumed ? next : current);
+        scratch.setAge(r, c, consumed ? 1 : (age < UINT16_MAX ? age + 1 : age));
+      }
+    grid.swapBuffers(scratch);
+  }
+
+  Grid grid, scratch;
+};
+
+void benchCyclicCA() {
+  benchPerIsa<CyclicCA>("Cyclic CA", [](int rows, int cols) {
+    return CyclicCA(rows, cols);
+  });
+  std::printf("\n[Cyclic CA -- generations/sec, per-cell vs bit-sliced "
+              "(%s), 1 thread]\n  %-11s %12s %12s %8s\n",
+              LifeKernels::getIsaName(LifeKernels::getIsa()), "size",
+              "per-cell", "bit-sliced", "speedup");
+  for (int size : {256, 512, 1280}) {
+    CyclicCA ca(size, size);
+    ca.randomize(42, 0.3f);
+    LegacyCyclicCA legacy(ca.getGrid());
+    const double before = measureRate([&] { legacy.step(); });
+    const double after = measureRate([&] { ca.step(); });
+    std::printf("  %5dx%-5d %12.1f %12.1f %7.1fx\n", size, size, before,
+                after, after / before);
+  }
+}
+
+/// One helper per extra hardware thread (the processor keeps one core free
+/// for audio; here we measure full-machine scaling).
+WorkerPool &benchPool() {
+  static WorkerPool pool(
+      std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+  return pool;
+}
+
+/// Single-threaded vs pooled row-band stepping for grids >= 256x256.
+template <typename Engine> void benchThreaded(const char *name) {
+  WorkerPool &pool = benchPool();
+  for (int i = 0; i < kNumGridSizes; ++i) {
+    const int rows = kGridSizes[i][0];
+    const int cols = kGridSizes[i][1];
+    if (rows < 256)
+      continue;
+    Engine serial(rows, cols);
+    Engine threaded(rows, cols);
+    threaded.setWorkerPool(&pool);
+    serial.randomize(42, 0.3f);
+    threaded.randomize(42, 0.3f);
+    const double one = measureRate([&] { serial.step(); });
+    const double many = measureRate([&] { threaded.step(); });
+    std::printf("  %-20s %5dx%-5d %10.1f %10.1f  (x%.2f)\n", name, rows,
+                cols, one, many, many / one);
+  }
+}
+
+void benchThreadedEngines() {
+  std::printf("\n[Row-band threading -- gen/s, 1 thread vs %d threads]\n",
+              benchPool().getNumThreads());
+  benchThreaded<GameOfLife>("Game of Life");
+  benchThreaded<BriansBrain>("Brian's Brain");
+  benchThreaded<CyclicCA>("Cyclic CA");
+  benchThreaded<ReactionDiffusion>("Reaction-Diffusion");
+  benchThreaded<LeniaEngine>("Lenia");
+  benchThreaded<BrownianField>("Brownian Field");
+}
+
+/// Per-step buffer traffic removed by swap-based double buffering: the
+/// engines used to copy the back buffer (cells + ages, or the float fields)
+/// over the front one after every compute pass; now they swap pointers.
+/// "copy us" times a memcpy of that size, i.e. the per-step cost saved.
+template <typename Engine>
+void benchBufferTraffic(const char *name, int bytesPerCell, int maxCells) {
+  for (int i = 0; i < kNumGridSizes; ++i) {
+    const int rows = kGridSizes[i][0];
+    const int cols = kGridSizes[i][1];
+    if (rows < 64 || rows * cols >= maxCells)
+      continue;
+    Engine engine(rows, cols);
+    engine.randomize(42, 0.3f);
+    const double rate = measureRate([&] { engine.step(); });
+
+    const size_t bytes = static_cast<size_t>(rows) * cols * bytesPerCell;
+    std::vector<uint8_t> src(bytes, 1), dst(bytes, 0);
+    const double copyRate = measureRate(
+        [&] { std::memcpy(dst.data(), src.data(), bytes); }, 0.05);
+    std::printf("  %-20s %5dx%-5d %10.1f %12.1f %10.1f\n", name, rows, cols,
+                rate, bytes / 1024.0, 1.0e6 / copyRate);
+  }
+}
+
+void benchDoubleBuffering() {
+  std::printf("\n[Double buffering -- copy-back removed per step]\n"
+              "  %-20s %-11s %10s %12s %10s\n",
+              "engine", "size", "gen/s", "copy KB", "copy us");
+  // Grid engines: uint8 cell + uint16 age. GoL / Brian's Brain only use
+  // the back grid below the bitwise threshold (packed planes swap above);
+  // Cyclic CA always steps bit planes.
+  constexpr int kAll = Grid::kMaxCells + 1;
+  benchBufferTraffic<GameOfLife>("Game of Life", 3, 128 * 128);
+  benchBufferTraffic<BriansBrain>("Brian's Brain", 3, 128 * 128);
+  // Float fields: RD swaps A and B; Lenia direct swaps its state field and
+  // the FFT path (>= 64x64) updates in place.
+  benchBufferTraffic<ReactionDiffusion>("Reaction-Diffusion", 8, kAll);
+  benchBufferTraffic<LeniaEngine>("Lenia", 4, kAll);
+}
+
+/// HashLife vs the packed GameOfLife step at 1280x1280. Generations/sec
+/// include the O(rows x cols) projection into the grid, which dominates
+/// once the pattern is memoized; larger jumps amortize it.
+void benchHashLife() {
+  std::printf("\n[HashLife -- generations/sec at 1280x1280]\n"
+              "  %-22s %12s %12s %12s %12s %10s\n",
+              "pattern", "GoL", "HL 1/step", "HL 16/step", "HL 1024/step",
+              "nodes");
+  auto row = [](const char *name, auto &&seed) {
+    GameOfLife gol(1280, 1280);
+    seed(gol);
+    std::printf("  %-22s %12.1f", name,
+                measureRate([&] { gol.step(); }));
+    uint32_t nodes = 0;
+    for (int gens : {1, 16, 1024}) {
+      HashLife hl(1280, 1280, GameOfLife::RulePreset::Classic, 20);
+      seed(hl);
+      hl.setGenerationsPerStep(gens);
+      std::printf(" %12.1f", gens * measureRate([&] { hl.step(); }));
+      nodes = hl.getNodeCount();
+    }
+    std::printf(" %10u\n", nodes);
+  };
+  row("Gosper gun (2^20 torus)", [](CellularEngine &e) {
+    FactoryPatternLibrary::applyPattern(e.getGridMutable(), 4);
+  });
+  row("random soup 30%", [](CellularEngine &e) { e.randomize(42, 0.3f); });
+}
+
+// --- Lenia FFT convolution ---
+
+/// The previous Lenia FFT step, for comparison: pocketfft::r2c / c2r (plans
+/// rebuilt inside every call), a copy into and out of a packed real
+/// buffer, and separate multiply, growth and grid projection passes.
+struct LegacyLeniaFFT {
+  LegacyLeniaFFT(int rows, int cols, const float *field)
+      : rows(rows), cols(cols), cCols(cols / 2 + 1),
+        state(field, field + static_cast<size_t>(rows) * cols),
+        real(state.size()), kernel(static_cast<size_t>(rows) * cCols),
+        bins(kernel.size()), grid(rows, cols) {
+    // Any point-symmetric kernel: cost does not depend on its values
+    real[0] = 1.0f;
+    pocketfft::r2c(shape(), realStride(), binStride(), {0, 1},
+                   pocketfft::FORWARD, real.data(), kernel.data(), 1.0f);
+  }
+
+  void step() {
+    std::copy(state.begin(), state.end(), real.begin());
+    pocketfft::r2c(shape(), realStride(), binStride(), {0, 1},
+                   pocketfft::FORWARD, real.data(), bins.data(), 1.0f);
+    for (size_t i = 0; i < bins.size(); ++i)
+      bins[i] *= kernel[i];
+    pocketfft::c2r(shape(), binStride(), realStride(), {0, 1},
+                   pocketfft::BACKWARD, bins.data(), real.data(),
+                   1.0f / static_cast<float>(state.size()));
+    for (size_t i = 0; i < state.size(); ++i) {
+      const float diff = real[i] - 0.15f;
+      const float growth =
+          2.0f * std::exp(-0.5f * diff * diff / (0.045f * 0.045f)) - 1.0f;
+      state[i] = std::min(1.0f, std::max(0.0f, state[i] + 0.1f * growth));
+    }
+    events.reset(rows, cols);
+    CellEventList::Writer out(events);
+    for (int r = 0; r < rows; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        const float s = state[static_cast<size_t>(r) * cols + c];
+        const bool alive = s > 0.1f;
+        if (alive != (grid.getCell(r, c) != 0))
+          out.add(r, c, alive ? CellEvent::Birth : CellEvent::Death, s);
+        grid.setCell(r, c, alive ? 1 : 0);
+        grid.setAge(r, c, alive ? static_cast<uint16_t>(s * 255.0f) : 0);
+      }
+    }
+  }
+
+  pocketfft::shape_t shape() const {
+    return {static_cast<size_t>(rows), static_cast<size_t>(cols)};
+  }
+  pocketfft::stride_t realStride() const {
+    return {static_cast<ptrdiff_t>(cols * sizeof(float)),
+            static_cast<ptrdiff_t>(sizeof(float))};
+  }
+  pocketfft::stride_t binStride() const {
+    return {static_cast<ptrdiff_t>(cCols * sizeof(std::complex<float>)),
+            static_cast<ptrdiff_t>(sizeof(std::complex<float>))};
+  }
+
+  int rows, cols, cCols;
+  std::vector<float> state, real;
+  std::vector<std::complex<float>> kernel, bins;
+  Grid grid;
+  CellEventList events;
+};
+
+void benchLeniaFFT() {
+  std::printf("\n[Lenia FFT -- steps/sec, one thread]\n"
+              "  %-11s %14s %14s %8s\n",
+              "grid", "per-call plans", "cached plans", "speedup");
+  for (int n : {256, 512, 1024, 1280}) {
+    LeniaEngine lenia(n, n);
+    lenia.randomize(42, 0.3f);
+    LegacyLeniaFFT legacy(n, n, lenia.getStateField());
+    const double before = measureRate([&] { legacy.step(); });
+    const double after = measureRate([&] { lenia.step(); });
+    std::printf("  %4dx%-6d %14.1f %14.1f %7.2fx\n", n, n, before, after,
+                after / before);
+  }
+}
+
+// --- Reaction-Diffusion stencil ---
+
+/// The Gray-Scott step before the row stencil: modulo wraps per cell and
+/// one pass over both fields per generation.
+struct LegacyReactionDiffusion {
+  LegacyReactionDiffusion(int rows, int cols, const float *a, const float *b)
+      : rows(rows), cols(cols), a(a, a + rows * cols), b(b, b + rows * cols),
+        nextA(a, a + rows * cols), nextB(b, b + rows * cols) {}
+
+  void step() {
+    for (int r = 0; r < rows; ++r)
+      for (int c = 0; c < cols; ++c) {
+        int idx = r * cols + c;
+        int up = ((r - 1 + rows) % rows) * cols + c;
+        int dn = ((r + 1) % rows) * cols + c;
+        int lt = r * cols + ((c - 1 + cols) % cols);
+        int rt = r * cols + ((c + 1) % cols);
+        float lapA = a[up] + a[dn] + a[lt] + a[rt] - 4.0f * a[idx];
+        float lapB = b[up] + b[dn] + b[lt] + b[rt] - 4.0f * b[idx];
+        float ab2 = a[idx] * b[idx] * b[idx];
+        nextA[idx] = a[idx] + (lapA - ab2 + 0.055f * (1.0f - a[idx]));
+        nextB[idx] = b[idx] + (0.5f * lapB + ab2 - 0.117f * b[idx]);
+        if (nextA[idx] < 0.0f)
+          nextA[idx] = 0.0f;
+        if (nextA[idx] > 1.0f)
+          nextA[idx] = 1.0f;
+        if (nextB[idx] < 0.0f)
+          nextB[idx] = 0.0f;
+        if (nextB[idx] > 1.0f)
+          nextB[idx] = 1.0f;
+      }
+    a.swap(nextA);
+    b.swap(nextB);
+  }
+
+  int rows, cols;
+  std::vector<float> a, b, nextA, nextB;
+};
+
+void benchReactionDiffusion() {
+  constexpr int kGenerations = 16; // Sim Speed 16x
+  std::printf("\n[Reaction-Diffusion -- generations/sec at %d per step, one "
+              "thread]\n  %-11s %12s %12s %12s %8s\n",
+              kGenerations, "grid", "per-cell", "1 gen/pass", "4 gen/pass",
+              "speedup");
+  for (int n : {256, 512, 1024, 1280}) {
+    ReactionDiffusion single(n, n), blocked(n, n);
+    single.randomize(42, 0.3f);
+    blocked.randomize(42, 0.3f);
+    single.setStepsPerPass(1);
+    single.setGenerationsPerStep(kGenerations);
+    blocked.setGenerationsPerStep(kGenerations);
+    LegacyReactionDiffusion legacy(n, n, single.getFieldA(),
+                                   single.getFieldB());
+    const double before = measureRate([&] { legacy.step(); });
+    const double one = kGenerations * measureRate([&] { single.step(); });
+    const double many = kGenerations * measureRate([&] { blocked.step(); });
+    std::printf("  %4dx%-6d %12.1f %12.1f %12.1f %7.2fx\n", n, n, before, one,
+                many, many / before);
+  }
+}
+
+// --- Particle swarm ---
+
+/// The flocking step before the cell list: every particle scans every
+/// other particle (O(n^2)), array of structs, one thread.
+struct LegacyParticleSwarm {
+  struct Particle {
+    float x, y, vx, vy;
+  };
+
+  LegacyParticleSwarm(const ParticleSwarm &src, int rows, int cols)
+      : rows(rows), cols(cols),
+        particles(static_cast<size_t>(src.getNumParticles())) {
+    for (size_t i = 0; i < particles.size(); ++i)
+      particles[i] = {src.getParticleX()[i], src.getParticleY()[i],
+                      src.getParticleVX()[i], src.getParticleVY()[i]};
+  }
+
+  void step() {
+    const int n = static_cast<int>(particles.size());
+    float cx = 0.0f, cy = 0.0f;
+    for (const auto &p : particles) {
+      cx += p.x;
+      cy += p.y;
+    }
+    cx /= n;
+    cy /= n;
+    for (int i = 0; i < n; ++i) {
+      auto &p = particles[i];
+      float avgVx = 0.0f, avgVy = 0.0f;
+      int neighbors = 0;
+      for (int j = 0; j < n; ++j) {
+        if (j == i)
+          continue;
+        float dx = particles[j].x - p.x;
+        float dy = particles[j].y - p.y;
+        if (std::sqrt(dx * dx + dy * dy) < 4.0f) {
+          avgVx += particles[j].vx;
+          avgVy += particles[j].vy;
+          ++neighbors;
+        }
+      }
+      if (neighbors > 0) {
+        p.vx += (avgVx / neighbors - p.vx) * 0.05f;
+        p.vy += (avgVy / neighbors - p.vy) * 0.05f;
+      }
+      p.vx += (cx - p.x) * 0.01f;
+      p.vy += (cy - p.y) * 0.01f;
+      float speed = std::sqrt(p.vx * p.vx + p.vy * p.vy);
+      if (speed > 1.5f) {
+        p.vx = p.vx / speed * 1.5f;
+        p.vy = p.vy / speed * 1.5f;
+      }
+      p.x = std::fmod(p.x + p.vx + cols, static_cast<float>(cols));
+      p.y = std::fmod(p.y + p.vy + rows, static_cast<float>(rows));
+    }
+  }
+
+  int rows, cols;
+  std::vector<Particle> particles;
+};
+
+void benchParticleSwarm() {
+  WorkerPool &pool = benchPool();
+  std::printf("\n[Particle swarm -- steps/sec on 512x512, 1 thread vs %d "
+              "threads]\n  %-10s %12s %12s %12s %8s\n",
+              pool.getNumThreads(), "particles", "all-pairs", "cell list",
+              "threaded", "speedup");
+  for (int n : {1000, 10000, 100000}) {
+    ParticleSwarm serial(512, 512, n), threaded(512, 512, n);
+    threaded.setWorkerPool(&pool);
+    serial.randomize(42, 0.3f);
+    threaded.randomize(42, 0.3f);
+    const double one = measureRate([&] { serial.step(); });
+    const double many = measureRate([&] { threaded.step(); });
+    if (n <= 10000) {
+      LegacyParticleSwarm legacy(serial, 512, 512);
+      const double before = measureRate([&] { legacy.step(); });
+      std::printf("  %-10d %12.1f %12.1f %12.1f %7.1fx\n", n, before, one,
+                  many, many / before);
+    } else {
+      std::printf("  %-10d %12s %12.1f %12.1f %8s\n", n, "-", one, many, "-");
+    }
+  }
+}
+
+// --- Brownian field ---
+
+/// The walker step before CounterRng: one serial xorshift64 stream, array
+/// of structs, deposit and clamp per walker, then separate decay and
+/// projection passes.
+struct LegacyBrownianField {
+  struct Walker {
+    float x, y;
+  };
+
+  LegacyBrownianField(const BrownianField &src, int rows, int cols)
+      : rows(rows), cols(cols), grid(rows, cols),
+        walkers(static_cast<size_t>(src.getNumWalkers())),
+        energy(static_cast<size_t>(rows) * cols, 0.0f) {
+    for (size_t i = 0; i < walkers.size(); ++i)
+      walkers[i] = {src.getWalkerX()[i], src.getWalkerY()[i]};
+  }
+
+  float randFloat() {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return static_cast<float>(rng >> 32) / 4294967296.0f;
+  }
+
+  void step() {
+    for (auto &w : walkers) {
+      w.x += (randFloat() - 0.5f) * 2.0f;
+      w.y += (randFloat() - 0.5f) * 2.0f;
+      if (w.x < 0)
+        w.x += cols;
+      if (w.x >= cols)
+        w.x -= cols;
+      if (w.y < 0)
+        w.y += rows;
+      if (w.y >= rows)
+        w.y -= rows;
+      float &e = energy[static_cast<int>(w.y) % rows * cols +
+                        static_cast<int>(w.x) % cols];
+      e = std::min(e + 0.8f, 1.0f);
+    }
+    for (float &e : energy) {
+      e *= 0.95f;
+      if (e < 0.01f)
+        e = 0.0f;
+    }
+    events.reset(rows, cols);
+    CellEventList::Writer out(events);
+    for (int r = 0; r < rows; ++r)
+      for (int c = 0; c < cols; ++c) {
+        const float e = energy[r * cols + c];
+        if (e > 0.1f) {
+          if (grid.getCell(r, c) == 0)
+            out.add(r, c, CellEvent::Birth, e);
+          grid.setCell(r, c, 1);
+          grid.setAge(r, c, static_cast<uint16_t>(e * 255.0f));
+        } else {
+          if (grid.getCell(r, c) != 0)
+            out.add(r, c, CellEvent::Death, e);
+          grid.setCell(r, c, 0);
+          grid.setAge(r, c, 0);
+        }
+      }
+  }
+
+  int rows, cols;
+  Grid grid;
+  CellEventList events;
+  uint64_t rng = 42;
+  std::vector<Walker> walkers;
+  std::vector<float> energy;
+};
+
+void benchBrownianField() {
+  WorkerPool &pool = benchPool();
+  std::printf("\n[Brownian field -- ms/step on 1280x1280 (walk + decay + "
+              "projection), 1 thread vs %d threads]\n  %-10s %12s %12s %12s\n",
+              pool.getNumThreads(), "walkers", "serial rng", "counter rng",
+              "threaded");
+  for (int n : {1 << 18, 1 << 20, 1 << 22}) {
+    BrownianField serial(1280, 1280, n), threaded(1280, 1280, n);
+    threaded.setWorkerPool(&pool);
+    serial.randomize(42, 0.3f);
+    threaded.randomize(42, 0.3f);
+    LegacyBrownianField legacy(serial, 1280, 1280);
+    const double before = 1000.0 / measureRate([&] { legacy.step(); });
+    const double one = 1000.0 / measureRate([&] { serial.step(); });
+    const double many = 1000.0 / measureRate([&] { threaded.step(); });
+    std::printf("  %-10d %12.2f %12.2f %12.2f\n", n, before, one, many);
+  }
+}
+
+// --- Lazy decay (sparse agents on a large field) ---
+
+void benchLazyDecay() {
+  std::printf("\n[Lazy decay -- Brownian field ms/step on 1280x1280 with few "
+              "walkers, full decay pass vs DecayField]\n"
+              "  %-10s %12s %12s %8s %7s\n",
+              "walkers", "full pass", "lazy", "speedup", "pass");
+  for (int n : {64, 1024, 16384}) {
+    BrownianField bf(1280, 1280, n);
+    bf.randomize(42, 0.3f);
+    LegacyBrownianField legacy(bf, 1280, 1280);
+    const double before = 1000.0 / measureRate([&] { legacy.step(); });
+    const double after = 1000.0 / measureRate([&] { bf.step(); });
+    std::printf("  %-10d %12.3f %12.3f %7.1fx %7s\n", n, before, after,
+                before / after,
+                bf.getDecayField().lastStepWasDense() ? "dense" : "sparse");
+  }
+}
+
+// --- Tile activity (dead-tile skipping) ---
+
+/// A few gliders and LWSS scattered over the grid: most 64x64 tiles stay
+/// empty, as in a settled field.
+void stampSpaceships(CellularEngine &e) {
+  e.clear();
+  Grid &grid = e.getGridMutable();
+  auto stamp = [&](const auto &cells, int row, int col) {
+    for (const auto &cell : cells)
+      grid.setCell(row + cell.row, col + cell.col, 1);
+  };
+  for (int i = 0; i < 8; ++i)
+    stamp(FactoryPatternLibrary::kGlider, 90 + 150 * i, 40 + 160 * i);
+  for (int i = 0; i < 4; ++i)
+    stamp(FactoryPatternLibrary::kLWSS, 200 + 300 * i, 1000 - 250 * i);
+}
+
+template <typename Engine>
+void benchTileRow(const char *name, const char *seedName,
+                  void (*seed)(CellularEngine &)) {
+  double rates[2];
+  int liveTiles = 0, tiles = 0;
+  for (bool skipping : {false, true}) {
+    Engine engine(1280, 1280);
+    engine.setTileSkipping(skipping);
+    seed(engine);
+    rates[skipping] = measureRate([&] { engine.step(); });
+    const TileActivity *map = engine.getLiveTiles();
+    liveTiles = map->countLive();
+    tiles = map->getTileRows() * map->getTileCols();
+  }
+  std::printf("  %-15s %-18s %12.1f %12.1f %7.2fx %6d/%d\n", name, seedName,
+              rates[0], rates[1], rates[1] / rates[0], liveTiles, tiles);
+}
+
+void benchTileActivity() {
+  std::printf("\n[Tile activity -- steps/sec at 1280x1280]\n"
+              "  %-15s %-18s %12s %12s %8s %10s\n",
+              "engine", "seed", "all tiles", "live tiles", "speedup",
+              "live");
+  auto soup = [](CellularEngine &e) { e.randomize(42, 0.3f); };
+  benchTileRow<GameOfLife>("Game of Life", "gliders + LWSS",
+                           stampSpaceships);
+  benchTileRow<GameOfLife>("Game of Life", "random soup 30%", soup);
+  benchTileRow<BriansBrain>("Brian's Brain", "gliders + LWSS",
+                            stampSpaceships);
+  benchTileRow<BriansBrain>("Brian's Brain", "random soup 30%", soup);
+
+  // Full-conversion publish (no events), with and without the tile map
+  GameOfLife gol(1280, 1280);
+  stampSpaceships(gol);
+  gol.step();
+  GpuGridBridge bridge;
+  const double full = measureRate([&] { bridge.updateFromCpu(gol.getGrid()); });
+  const double tiled = measureRate(
+      [&] { bridge.updateFromCpu(gol.getGrid(), nullptr, gol.getLiveTiles()); });
+  std::printf("  %-15s %-18s %12.1f %12.1f %7.2fx\n", "Bridge publish",
+              "gliders + LWSS", full, tiled, tiled / full);
+}
+
+// --- Synth voices ---
+
+/// Start `count` sustained voices: every waveshape and filter mode, some
+/// sub / noise, spread across the stereo field.
+void startVoices(SynthVoice *voices, int count, double sampleRate) {
+  for (int v = 0; v < count; ++v) {
+    voices[v].setWaveshape(static_cast<PolyBLEPOscillator::Shape>(
+        v % static_cast<int>(PolyBLEPOscillator::Shape::Count)));
+    voices[v].setEnvelopeParams(0.01, 0.0, 0.1, 0.7, 0.5, sampleRate);
+    voices[v].setFilterMode(static_cast<SVFilter::Mode>(v % 4));
+    voices[v].setFilterResonance(0.3);
+    voices[v].setSubLevel(v % 2 ? 0.3 : 0.0);
+    voices[v].setNoiseLevel(v % 5 == 0 ? 0.05 : 0.0);
+    voices[v].setPan(count > 1 ? -1.0 + 2.0 * v / (count - 1) : 0.0);
+    voices[v].noteOn(36 + v, 0.8, 65.0 * (1.0 + 0.05 * v), sampleRate);
+    voices[v].setFilterCutoff(2000.0);
+  }
+}
+
+/// 64 sustained voices at 48 kHz in 64-sample buffers: the processor's
+/// voice loop per buffer, per-sample reference vs block rendering in SIMD
+/// lanes.
+void benchSynthVoices() {
+  constexpr int kVoices = 64;
+  constexpr int kBuffer = 64;
+  constexpr double kSampleRate = 48000.0;
+  auto setup = [](SynthVoice *voices) {
+    startVoices(voices, kVoices, kSampleRate);
+  };
+
+  static SynthVoice perSample[kVoices], block[kVoices];
+  setup(perSample);
+  setup(block);
+  float left[kBuffer], right[kBuffer];
+
+  const double before = measureRate([&] {
+    for (int i = 0; i < kBuffer; ++i) {
+      double mixL = 0.0, mixR = 0.0;
+      int active = 0;
+      for (auto &voice : perSample) {
+        if (voice.isActive()) {
+          auto s = voice.renderNextSample();
+          mixL += s.left;
+          mixR += s.right;
+        }
+      }
+      for (auto &voice : perSample)
+        active += voice.isActive() ? 1 : 0;
+      left[i] = static_cast<float>(mixL / std::sqrt(active));
+      right[i] = static_cast<float>(mixR / std::sqrt(active));
+    }
+  });
+
+  SynthVoice *ptrs[kVoices];
+  for (int v = 0; v < kVoices; ++v)
+    ptrs[v] = &block[v];
+  const double after = measureRate([&] {
+    std::fill(left, left + kBuffer, 0.0f);
+    std::fill(right, right + kBuffer, 0.0f);
+    int active[kBuffer] = {};
+    SynthVoice::renderBlock(ptrs, kVoices, left, right, kBuffer, active);
+    for (int i = 0; i < kBuffer; ++i) {
+      left[i] /= std::sqrt(static_cast<float>(active[i]));
+      right[i] /= std::sqrt(static_cast<float>(active[i]));
+    }
+  });
+
+  const double budgetUs = 1.0e6 * kBuffer / kSampleRate;
+  std::printf("\n[Synth voices -- 64 voices, 64-sample buffers at 48 kHz]\n"
+              "  %-22s %12s %12s\n",
+              "path", "us/buffer", "% budget");
+  std::printf("  %-22s %12.1f %11.1f%%\n", "per-sample (double)",
+              1.0e6 / before, 100.0e6 / before / budgetUs);
+  std::printf("  %-22s %12.1f %11.1f%%\n", "block, 4-voice lanes",
+              1.0e6 / after, 100.0e6 / after / budgetUs);
+  std::printf("  speedup %.2fx\n", after / before);
+}
+
+/// The processor's nine parallel sends, all active at 50% mix.
+struct AllEffects {
+  static constexpr int kCount = 9;
+  StereoChorus chorus;
+  StereoPhaser phaser;
+  StereoFlanger flanger;
+  StereoDelay delay;
+  PingPongDelay pingPong;
+  PlateReverb reverb;
+  ShimmerReverb shimmer;
+  Bitcrush bitcrush;
+  TapeSaturation tapeSat;
+  StereoEffect *all[kCount] = {&chorus, &phaser,  &flanger,
+                               &delay,  &pingPong, &reverb,
+                               &shimmer, &bitcrush, &tapeSat};
+  EffectChain chain;
+  explicit AllEffects(float sampleRate) {
+    for (int i = 0; i < kCount; ++i) {
+      all[i]->setMix(0.5f);
+      chain.setSlot(i, all[i]);
+    }
+    chain.init(sampleRate);
+  }
+};
+
+void benchEffectChain() {
+  constexpr int kBuffer = 512;
+  constexpr float kSampleRate = 48000.0f;
+  static AllEffects perSample(kSampleRate), block(kSampleRate);
+
+  float inL[kBuffer], inR[kBuffer], left[kBuffer], right[kBuffer];
+  for (int i = 0; i < kBuffer; ++i) {
+    inL[i] = 0.5f * std::sin(0.03f * i);
+    inR[i] = 0.5f * std::sin(0.05f * i);
+  }
+
+  const double before = measureRate([&] {
+    for (int i = 0; i < kBuffer; ++i)
+      perSample.chain.processParallel(inL[i], inR[i], left[i], right[i]);
+  });
+  const double after = measureRate([&] {
+    std::copy(inL, inL + kBuffer, left);
+    std::copy(inR, inR + kBuffer, right);
+    block.chain.processParallelBlock(left, right, left, right, kBuffer);
+  });
+
+  const double budgetUs = 1.0e6 * kBuffer / kSampleRate;
+  std::printf("\n[Effect chain -- 9 parallel sends, 512-sample buffers at "
+              "48 kHz]\n"
+              "  %-22s %12s %12s\n",
+              "path", "us/buffer", "% budget");
+  std::printf("  %-22s %12.1f %11.1f%%\n", "per-sample virtual",
+              1.0e6 / before, 100.0e6 / before / budgetUs);
+  std::printf("  %-22s %12.1f %11.1f%%\n", "processBlock",
+              1.0e6 / after, 100.0e6 / after / budgetUs);
+  std::printf("  speedup %.2fx\n", after / before);
+}
+
+void benchEffectSendsParallel() {
+  constexpr int kBuffer = 2048;
+  constexpr float kSampleRate = 48000.0f;
+  struct Effects {
+    StereoChorus chorus;
+    StereoDelay delay;
+    PingPongDelay pingPong;
+    PlateReverb reverb;
+    ShimmerReverb shimmer;
+    TapeSaturation tapeSat;
+    EffectChain chain;
+    Effects() {
+      StereoEffect *all[] = {&chorus,  &delay,  &pingPong,
+                             &reverb, &shimmer, &tapeSat};
+      for (int i = 0; i < 6; ++i) {
+        all[i]->setMix(0.5f);
+        chain.setSlot(i, all[i]);
+      }
+      chain.init(kSampleRate);
+      chain.prepare(kBuffer);
+    }
+  };
+  static Effects serial, parallel;
+  const int hw = static_cast<int>(std::thread::hardware_concurrency());
+  AudioWorkerPool pool(std::max(1, std::min(5, hw - 1)));
+  parallel.chain.setWorkerPool(&pool);
+
+  float left[kBuffer], right[kBuffer];
+  auto fill = [&] {
+    for (int i = 0; i < kBuffer; ++i) {
+      left[i] = 0.5f * std::sin(0.03f * i);
+      right[i] = 0.5f * std::sin(0.05f * i);
+    }
+  };
+  const double before = measureRate([&] {
+    fill();
+    serial.chain.processParallelBlock(left, right, left, right, kBuffer);
+  });
+  const double after = measureRate([&] {
+    fill();
+    parallel.chain.processParallelBlock(left, right, left, right, kBuffer);
+  });
+
+  std::printf("\n[Effect sends -- 6 active, 2048-sample buffers, %d "
+              "threads]\n"
+              "  %-22s %12s\n",
+              pool.getNumThreads(), "path", "us/buffer");
+  std::printf("  %-22s %12.1f\n", "serial", 1.0e6 / before);
+  std::printf("  %-22s %12.1f\n", "worker pool", 1.0e6 / after);
+  std::printf("  speedup %.2fx (%u hardware threads)\n", after / before,
+              std::thread::hardware_concurrency());
+  std::printf("  %-22s %8s %12s\n", "effect", "thread", "last us");
+  for (int s = 0; s < 6; ++s) {
+    const EffectChain::SlotTiming t = parallel.chain.getSlotTiming(s);
+    std::printf("  %-22s %8d %12.1f\n", parallel.chain.getSlot(s)->getName(),
+                t.thread, t.lastUs);
+  }
+}
+
+
+// ============================================================================
+// Regression suite (--suite / --json)
+// ============================================================================
+
+/// Named cases, one measure() each, reported as a table or as JSON in the
+/// Google Benchmark layout so results can be diffed between releases.
+/// Everything runs on one thread (no worker pools) for stable numbers.
+class Suite {
+public:
+  Suite(std::string filter, double minSeconds)
+      : filter(std::move(filter)), minSeconds(minSeconds) {}
+
+  /// Whether a case is enabled by --filter (check before costly setup).
+  bool selected(const std::string &name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+  }
+
+  /// Measure fn as case `name`. itemsPerIteration (cells, samples, notes)
+  /// adds an items-per-second rate.
+  template <typename Fn>
+  void run(const std::string &name, Fn &&fn, double itemsPerIteration = 0.0) {
+    if (!selected(name))
+      return;
+    results.push_back({name, measure(fn, minSeconds), itemsPerIteration});
+    const Result &r = results.back();
+    std::fprintf(stderr, "  %-44s %14.1f ns\n", name.c_str(), r.realNs());
+  }
+
+  void printTable() const {
+    std::printf("\n[Regression suite -- time per iteration]\n"
+                "  %-44s %14s %14s %10s\n",
+                "case", "real ns", "cpu ns", "iters");
+    for (const Result &r : results)
+      std::printf("  %-44s %14.1f %14.1f %10d\n", r.name.c_str(), r.realNs(),
+                  r.cpuNs(), r.m.iterations);
+  }
+
+  static std::string jsonEscape(const std::string &text) {
+    std::string out;
+    for (char ch : text) {
+      if (ch == '"' || ch == '\\')
+        out += '\\';
+      out += ch;
+    }
+    return out;
+  }
+
+  void writeJson(std::FILE *out, const char *executable) const {
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S",
+                  std::localtime(&now));
+#ifdef NDEBUG
+    const char *buildType = "release";
+#else
+    const char *buildType = "debug";
+#endif
+    std::fprintf(out,
+                 "{\n  \"context\": {\n    \"date\": \"%s\",\n"
+                 "    \"executable\": \"%s\",\n    \"num_cpus\": %u,\n"
+                 "    \"library_build_type\": \"%s\",\n"
+                 "    \"life_kernel_isa\": \"%s\",\n"
+                 "    \"min_time\": %g\n  },\n  \"benchmarks\": [",
+                 date, jsonEscape(executable).c_str(),
+                 std::thread::hardware_concurrency(),
+                 buildType, LifeKernels::getIsaName(LifeKernels::getIsa()),
+                 minSeconds);
+    for (size_t i = 0; i < results.size(); ++i) {
+      const Result &r = results[i];
+      std::fprintf(out,
+                   "%s\n    {\n      \"name\": \"%s\",\n"
+                   "      \"run_name\": \"%s\",\n"
+                   "      \"run_type\": \"iteration\",\n"
+                   "      \"iterations\": %d,\n      \"real_time\": %.3f,\n"
+                   "      \"cpu_time\": %.3f,\n      \"time_unit\": \"ns\"",
+                   i == 0 ? "" : ",", r.name.c_str(), r.name.c_str(),
+                   r.m.iterations, r.realNs(), r.cpuNs());
+      if (r.items > 0.0)
+        std::fprintf(out, ",\n      \"items_per_second\": %.6g",
+                     r.items * r.m.iterations / r.m.seconds);
+      std::fprintf(out, "\n    }");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+  }
+
+private:
+  struct Result {
+    std::string name;
+    Measurement m;
+    double items;
+    double realNs() const { return m.seconds * 1.0e9 / m.iterations; }
+    double cpuNs() const { return m.cpuSeconds * 1.0e9 / m.iterations; }
+  };
+
+  std::string filter;
+  double minSeconds;
+  std::vector<Result> results;
+};
+
+std::string sizeName(int rows, int cols) {
+  return std::to_string(rows) + "x" + std::to_string(cols);
+}
+
+/// Every CellularEngine step at every kGridSizes entry (Lenia 3D is a CPU
+/// no-op stub and is left out).
+template <typename Engine, typename... Args>
+void suiteEngine(Suite &suite, const char *name, Args... args) {
+  for (const auto &size : kGridSizes) {
+    const int rows = size[0], cols = size[1];
+    const std::string caseName =
+        std::string("Engine/") + name + "/" + sizeName(rows, cols);
+    if (!suite.selected(caseName))
+      continue;
+    Engine engine(rows, cols, args...);
+    engine.randomize(42, 0.3f);
+    suite.run(caseName, [&] { engine.step(); },
+              static_cast<double>(rows) * cols);
+  }
+}
+
+void suiteEngines(Suite &suite) {
+  suiteEngine<GameOfLife>(suite, "GameOfLife");
+  suiteEngine<GameOfLife>(suite, "HighLife",
+                          GameOfLife::RulePreset::HighLife);
+  suiteEngine<HashLife>(suite, "HashLife", GameOfLife::RulePreset::Classic);
+  suiteEngine<BriansBrain>(suite, "BriansBrain");
+  suiteEngine<CyclicCA>(suite, "CyclicCA");
+  suiteEngine<ReactionDiffusion>(suite, "ReactionDiffusion");
+  suiteEngine<ParticleSwarm>(suite, "ParticleSwarm");
+  suiteEngine<LeniaEngine>(suite, "Lenia");
+  suiteEngine<BrownianField>(suite, "BrownianField");
+}
+
+/// Bridge publish / UI snapshot conversion and the grid state save/load
+/// chunk (GridStateCodec), per grid size.
+void suiteGridTransfer(Suite &suite) {
+  for (const auto &size : kGridSizes) {
+    const int rows = size[0], cols = size[1];
+    const std::string dims = sizeName(rows, cols);
+    const double cells = static_cast<double>(rows) * cols;
+    if (!suite.selected("Bridge/updateFromCpu/" + dims) &&
+        !suite.selected("Bridge/convertToGrid/" + dims) &&
+        !suite.selected("GridState/encode/" + dims) &&
+        !suite.selected("GridState/decode/" + dims))
+      continue;
+
+    GameOfLife gol(rows, cols);
+    gol.randomize(42, 0.3f);
+    GpuGridBridge bridge;
+    bridge.updateFromCpu(gol.getGrid());
+    Grid snapshot(rows, cols);
+    suite.run("Bridge/updateFromCpu/" + dims,
+              [&] { bridge.updateFromCpu(gol.getGrid()); }, cells);
+    suite.run("Bridge/convertToGrid/" + dims,
+              [&] { bridge.convertToGrid(snapshot); }, cells);
+
+    std::vector<uint8_t> chunk;
+    GridStateCodec::encode(gol, chunk);
+    GameOfLife restored(rows, cols);
+    suite.run("GridState/encode/" + dims,
+              [&] { GridStateCodec::encode(gol, chunk); }, cells);
+    suite.run("GridState/decode/" + dims,
+              [&] {
+                GridStateCodec::decode(chunk.data(), chunk.size(), restored);
+              },
+              cells);
+  }
+}
+
+/// Block voice rendering at 1, 16 and 64 voices, one SynthVoice::kBlockSize
+/// buffer per iteration at 48 kHz.
+void suiteSynthVoices(Suite &suite) {
+  constexpr int kMaxVoices = 64;
+  constexpr int kBuffer = SynthVoice::kBlockSize;
+  static SynthVoice voices[kMaxVoices];
+  for (int count : {1, 16, 64}) {
+    for (auto &v : voices)
+      v.reset();
+    startVoices(voices, count, 48000.0);
+    SynthVoice *ptrs[kMaxVoices];
+    for (int v = 0; v < count; ++v)
+      ptrs[v] = &voices[v];
+    float left[kBuffer], right[kBuffer];
+    suite.run("SynthVoice/renderBlock/" + std::to_string(count) + "voices",
+              [&] {
+                std::fill(left, left + kBuffer, 0.0f);
+                std::fill(right, right + kBuffer, 0.0f);
+                SynthVoice::renderBlock(ptrs, count, left, right, kBuffer);
+              },
+              kBuffer);
+  }
+}
+
+/// Each StereoEffect on its own, then the nine-send chain per sample and
+/// per block. 512-sample buffers at 48 kHz.
+void suiteEffects(Suite &suite) {
+  constexpr int kBuffer = 512;
+  static AllEffects effects(48000.0f);
+  const char *classNames[AllEffects::kCount] = {
+      "StereoChorus", "StereoPhaser", "StereoFlanger",
+      "StereoDelay",  "PingPongDelay", "PlateReverb",
+      "ShimmerReverb", "Bitcrush",    "TapeSaturation"};
+
+  float inL[kBuffer], inR[kBuffer], left[kBuffer], right[kBuffer];
+  for (int i = 0; i < kBuffer; ++i) {
+    inL[i] = 0.5f * std::sin(0.03f * i);
+    inR[i] = 0.5f * std::sin(0.05f * i);
+  }
+
+  for (int e = 0; e < AllEffects::kCount; ++e) {
+    StereoEffect *fx = effects.all[e];
+    suite.run(std::string("Effect/") + classNames[e] + "/processBlock",
+              [&] { fx->processBlock(inL, inR, left, right, kBuffer); },
+              kBuffer);
+  }
+  suite.run("EffectChain/processParallel/9sends",
+            [&] {
+              for (int i = 0; i < kBuffer; ++i)
+                effects.chain.processParallel(inL[i], inR[i], left[i],
+                                              right[i]);
+            },
+            kBuffer);
+  suite.run("EffectChain/processParallelBlock/9sends",
+            [&] {
+              effects.chain.processParallelBlock(inL, inR, left, right,
+                                                 kBuffer);
+            },
+            kBuffer);
+}
+
+/// Note mapping of a 64x64 grid (one quantize() per cell) in a diatonic and
+/// a pentatonic scale.
+void suiteScaleQuantizer(Suite &suite) {
+  constexpr int kRows = 64, kCols = 64;
+  ScaleQuantizer quantizer;
+  static volatile int sink = 0;
+  for (auto scale : {ScaleQuantizer::Scale::Major,
+                     ScaleQuantizer::Scale::PentMinor}) {
+    quantizer.setScale(scale, 2);
+    suite.run(std::string("ScaleQuantizer/quantize/") +
+                  (scale == ScaleQuantizer::Scale::Major ? "Major"
+                                                         : "PentMinor"),
+              [&] {
+                int sum = 0;
+                for (int r = 0; r < kRows; ++r)
+                  for (int c = 0; c < kCols; ++c)
+                    sum += quantizer.quantize(r, c, 3, 4, kCols);
+                sink = sink + sum;
+              },
+              kRows * kCols);
+  }
+}
+
+void runSuite(Suite &suite) {
+  suiteEngines(suite);
+  suiteGridTransfer(suite);
+  suiteSynthVoices(suite);
+  suiteEffects(suite);
+  suiteScaleQuantizer(suite);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  bool suiteMode = false;
+  const char *jsonPath = nullptr; // "" = stdout
+  std::string filter;
+  double minSeconds = 0.25;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--suite") == 0) {
+      suiteMode = true;
+    } else if (std::strcmp(arg, "--json") == 0) {
+      jsonPath = "";
+    } else if (std::strncmp(arg, "--json=", 7) == 0) {
+      jsonPath = arg + 7;
+    } else if (std::strncmp(arg, "--filter=", 9) == 0) {
+      filter = arg + 9;
+    } else if (std::strncmp(arg, "--min-time=", 11) == 0) {
+      minSeconds = std::max(0.0, std::atof(arg + 11));
+    } else {
+      std::fprintf(stderr,
+                   "Usage: %s [--suite] [--json[=file]] [--filter=text] "
+                   "[--min-time=seconds]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  if (suiteMode || jsonPath != nullptr) {
+    Suite suite(filter, minSeconds);
+    runSuite(suite);
+    if (jsonPath == nullptr) {
+      suite.printTable();
+      return 0;
+    }
+    std::FILE *out = *jsonPath ? std::fopen(jsonPath, "w") : stdout;
+    if (out == nullptr) {
+      std::fprintf(stderr, "Cannot write %s\n", jsonPath);
+      return 1;
+    }
+    suite.writeJson(out, argv[0]);
+    if (out != stdout)
+      std::fclose(out);
+    return 0;
+  }
+
+  std::printf("=== Algo Nebula Engine Benchmarks ===\n");
+  std::printf("Life kernels: %s (detected)\n",
+              LifeKernels::getIsaName(LifeKernels::detectBestIsa()));
+  benchLifeKernels();
+  benchGameOfLife();
+  benchBriansBrain();
+  benchCyclicCA();
+  benchThreadedEngines();
+  benchDoubleBuffering();
+  benchHashLife();
+  benchTileActivity();
+  benchLeniaFFT();
+  benchReactionDiffusion();
+  benchParticleSwarm();
+  benchBrownianField();
+  benchLazyDecay();
+  benchSynthVoices();
+  benchEffectChain();
+  benchEffectSendsParallel();
+  return 0;
+}